@@ -20,6 +20,7 @@
 
 #include "QAD_GPIO.hpp"
 #include "QAD_ADC.hpp"
+#include "QAD_SPIMgr.hpp"
 
 #include "QAS_Serial_Dev_UART.hpp"
 
@@ -133,8 +134,96 @@ void ADC_IRQHandler(void) {
 }
 
 
+//DMA2_Stream0_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for DMA transfers from the ADC when QAD_ADC is in DMA data mode
+void DMA2_Stream0_IRQHandler(void) {
+	QAD_ADC::handlerDMA();
+}
+
+
+//DMA1_Stream0_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI3 (RX)
+void DMA1_Stream0_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI3);
+}
+
+
+//DMA1_Stream3_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI2 (RX)
+void DMA1_Stream3_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI2);
+}
+
+
+//DMA1_Stream4_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI2 (TX)
+void DMA1_Stream4_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI2);
+}
+
+
+//DMA1_Stream5_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI3 (TX)
+void DMA1_Stream5_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI3);
+}
+
+
+//DMA2_Stream2_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI1 (RX)
+void DMA2_Stream2_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI1);
+}
+
+
+//DMA2_Stream3_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI4 or SPI5 (RX). Only one of them can hold the stream, so only that
+//driver is called
+void DMA2_Stream3_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI4);
+	QAD_SPIMgr::handlerDMA(QAD_SPI5);
+}
+
+
+//DMA2_Stream4_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI4 or SPI5 (TX). Only one of them can hold the stream, so only that
+//driver is called
+void DMA2_Stream4_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI4);
+	QAD_SPIMgr::handlerDMA(QAD_SPI5);
+}
+
+
+//DMA2_Stream5_IRQHandler
+//Interrupt Handler Function
+//
+//This is used for QAD_SPI asynchronous transfers on SPI1 (TX)
+void DMA2_Stream5_IRQHandler(void) {
+	QAD_SPIMgr::handlerDMA(QAD_SPI1);
+}
+
+
 //EXTI15_10_IRQHandler
 //Interrupt Handler Function
+//
+//This is used for the user button on PC13. If a QAD_SPI driver runs slave mode with its NSS pin on pins 10 to 15, its handlerNSS()
+//method must also be called from here. handlerNSS() only clears and processes the pending flag of its own pin
 void EXTI15_10_IRQHandler(void) {
 
 	if (__HAL_GPIO_EXTI_GET_IT(GPIO_PIN_13) != RESET) {
@@ -53,6 +53,17 @@ void USART2_IRQHandler(void);
 
 void ADC_IRQHandler(void);
 
+void DMA2_Stream0_IRQHandler(void);
+
+void DMA1_Stream0_IRQHandler(void);
+void DMA1_Stream3_IRQHandler(void);
+void DMA1_Stream4_IRQHandler(void);
+void DMA1_Stream5_IRQHandler(void);
+void DMA2_Stream2_IRQHandler(void);
+void DMA2_Stream3_IRQHandler(void);
+void DMA2_Stream4_IRQHandler(void);
+void DMA2_Stream5_IRQHandler(void);
+
 void EXTI15_10_IRQHandler(void);
 
 
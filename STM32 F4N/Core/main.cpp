@@ -32,6 +32,10 @@
 #include "QAD_Flash.hpp"
 
 #include "QAS_Serial_Dev_UART.hpp"
+#include "QAS_Display_TFT.hpp"
+
+#include "QAT_Timestamp.hpp"
+#include "QAT_Filter.hpp"
 
 #include <string.h>
 #include <stdio.h>
@@ -207,6 +211,200 @@ int main(void) {
   UART_STLink->txStringCR("Wake up");*/
 
 
+  //----------------
+  //Filter Benchmark
+  //
+  //Measures CPU cycles per sample for each filter type in QAT_Filter.hpp, using the DWT cycle counter
+  //
+/*  UART_STLink->txStringCR("Filter Benchmark");
+  QAT_Timestamp::init();
+
+  static uint16_t uBenchInput[256];
+  static int16_t  iBenchOutput[256];
+  for (uint16_t i=0; i<256; i++)
+  	uBenchInput[i] = (uint16_t)((i * 37) & 0x0FFF);
+
+  QAT_Filter_BiquadQ15 cBenchBiquadQ15(1);
+  QAT_Filter_BiquadQ15_Coeffs sBenchCoeffsQ15 = {1106, 2210, 1106, -18727, 6763};     //2nd order Butterworth low pass at fs/10 (Q14)
+  cBenchBiquadQ15.addStage(sBenchCoeffsQ15);
+  cBenchBiquadQ15.addStage(sBenchCoeffsQ15);
+
+  QAT_Filter_BiquadQ31 cBenchBiquadQ31(1);
+  QAT_Filter_BiquadQ31_Coeffs sBenchCoeffsQ31 = {72477573, 144847772, 72477573, -1227286905, 443240625};  //As above (Q30)
+  cBenchBiquadQ31.addStage(sBenchCoeffsQ31);
+  cBenchBiquadQ31.addStage(sBenchCoeffsQ31);
+
+  QAT_Filter_FIR cBenchFIR(4);
+  int16_t iBenchTaps[32];
+  for (uint8_t i=0; i<32; i++)
+  	iBenchTaps[i] = 1024;                                                             //32 tap moving average
+  cBenchFIR.setCoefficients(iBenchTaps, 32);
+
+  QAT_Filter_Median cBenchMedian(7);
+  QAT_Filter_EMA    cBenchEMA(3277);
+
+  QAT_Filter* pBenchFilters[5]    = {&cBenchBiquadQ15, &cBenchBiquadQ31, &cBenchFIR, &cBenchMedian, &cBenchEMA};
+  const char* strBenchFilters[5]  = {"Biquad Q15 (2 stages)", "Biquad Q31 (2 stages)", "FIR (32 taps, decimate by 4)",
+  		                               "Median (7)", "EMA"};
+  char strBench[64];
+  for (uint8_t i=0; i<5; i++) {
+  	uint32_t uBenchStart  = QAT_Timestamp::get();
+  	pBenchFilters[i]->process(uBenchInput, 256, 1, iBenchOutput);
+  	uint32_t uBenchCycles = QAT_Timestamp::get() - uBenchStart;
+  	sprintf(strBench, "%s: %lu.%02lu cycles/sample", strBenchFilters[i], uBenchCycles / 256, ((uBenchCycles % 256) * 100) / 256);
+  	UART_STLink->txStringCR(strBench);
+  }*/
+
+
+  //------------------
+  //SPI Fast Benchmark
+  //
+  //Compares transactions per second for 4 byte register reads using HAL based transceive() and register level transceiveFast()
+  //Uses SPI1 at the maximum clock rate (APB2/2) on pins A5 (SCK), A6 (MISO), A7 (MOSI) and B6 (CS)
+  //
+/*  UART_STLink->txStringCR("SPI Fast Benchmark");
+  QAT_Timestamp::init();
+
+  QAD_SPI_InitStruct sBenchSPI = {};
+  sBenchSPI.eSPI              = QAD_SPI1;
+  sBenchSPI.uIRQPriority      = 0x0A;
+  sBenchSPI.eSPIMode          = QAD_SPI_Mode_Master;
+  sBenchSPI.eSPIBiDir         = QAD_SPI_BiDir_Enabled;
+  sBenchSPI.eSPILines         = QAD_SPI_Lines_2Lines;
+  sBenchSPI.eSPIDataSize      = QAD_SPI_DataSize_8bit;
+  sBenchSPI.eSPIClkPolarity   = QAD_SPI_ClkPolarity_High;
+  sBenchSPI.eSPIClkPhase      = QAD_SPI_ClkPhase_2Edge;
+  sBenchSPI.eSPICS            = QAD_SPI_CS_Soft;
+  sBenchSPI.eSPIPrescaler     = QAD_SPI_BaudPrescaler_2;
+  sBenchSPI.eSPIFirstBit      = QAD_SPI_FirstBit_MSB;
+  sBenchSPI.eSPITIMode        = QAD_SPI_TIMode_Disable;
+  sBenchSPI.eSPICRC           = QAD_SPI_CRC_Disable;
+  sBenchSPI.uSPICRCPolynomial = 7;
+  sBenchSPI.pClk_GPIO  = GPIOA; sBenchSPI.uClk_Pin  = GPIO_PIN_5; sBenchSPI.uClk_AF  = GPIO_AF5_SPI1;
+  sBenchSPI.pMISO_GPIO = GPIOA; sBenchSPI.uMISO_Pin = GPIO_PIN_6; sBenchSPI.uMISO_AF = GPIO_AF5_SPI1;
+  sBenchSPI.pMOSI_GPIO = GPIOA; sBenchSPI.uMOSI_Pin = GPIO_PIN_7; sBenchSPI.uMOSI_AF = GPIO_AF5_SPI1;
+  sBenchSPI.pCS_GPIO   = GPIOB; sBenchSPI.uCS_Pin   = GPIO_PIN_6;
+
+  QAD_SPI* pBenchSPI = new QAD_SPI(sBenchSPI);
+  pBenchSPI->init();
+  pBenchSPI->start();
+
+  uint8_t uSPITX[4] = {0x80 | 0x3B, 0x00, 0x00, 0x00};
+  uint8_t uSPIRX[4];
+  char strSPIBench[64];
+
+  uint32_t uSPIStart = QAT_Timestamp::get();
+  for (uint16_t i=0; i<1000; i++)
+  	pBenchSPI->transceive(uSPITX, uSPIRX, 4);
+  uint32_t uSPIHAL = QAT_Timestamp::get() - uSPIStart;
+
+  uSPIStart = QAT_Timestamp::get();
+  for (uint16_t i=0; i<1000; i++)
+  	pBenchSPI->transceiveFast(uSPITX, uSPIRX, 4);
+  uint32_t uSPIFast = QAT_Timestamp::get() - uSPIStart;
+
+  sprintf(strSPIBench, "HAL: %lu transactions/s", (uint32_t)(((uint64_t)QAT_Timestamp::getFrequency() * 1000) / uSPIHAL));
+  UART_STLink->txStringCR(strSPIBench);
+  sprintf(strSPIBench, "Fast: %lu transactions/s", (uint32_t)(((uint64_t)QAT_Timestamp::getFrequency() * 1000) / uSPIFast));
+  UART_STLink->txStringCR(strSPIBench);
+
+  pBenchSPI->stop();
+  pBenchSPI->deinit();
+  delete pBenchSPI;*/
+
+
+  //-----------------
+  //Display Benchmark
+  //
+  //Reports frames per second for full screen updates, and for partial updates of a single 32x32 pixel region, of an ILI9341 240x320 display
+  //Uses SPI1 at APB2/2 on pins A5 (SCK), A7 (MOSI), B6 (CS), B7 (DC) and B8 (Reset), through a QAS_SPI_Bus
+  //The SPI1 DMA interrupts are passed to the driver by DMA2_Stream2_IRQHandler and DMA2_Stream5_IRQHandler in handlers.cpp
+  //
+/*  UART_STLink->txStringCR("Display Benchmark");
+  QAT_Timestamp::init();
+
+  QAD_SPI_InitStruct sDispSPI = {};
+  sDispSPI.eSPI              = QAD_SPI1;
+  sDispSPI.uIRQPriority      = 0x0A;
+  sDispSPI.eSPIMode          = QAD_SPI_Mode_Master;
+  sDispSPI.eSPIBiDir         = QAD_SPI_BiDir_Enabled;
+  sDispSPI.eSPILines         = QAD_SPI_Lines_2Lines;
+  sDispSPI.eSPIDataSize      = QAD_SPI_DataSize_8bit;
+  sDispSPI.eSPIClkPolarity   = QAD_SPI_ClkPolarity_Low;
+  sDispSPI.eSPIClkPhase      = QAD_SPI_ClkPhase_1Edge;
+  sDispSPI.eSPICS            = QAD_SPI_CS_Soft;
+  sDispSPI.eSPIPrescaler     = QAD_SPI_BaudPrescaler_2;
+  sDispSPI.eSPIFirstBit      = QAD_SPI_FirstBit_MSB;
+  sDispSPI.eSPITIMode        = QAD_SPI_TIMode_Disable;
+  sDispSPI.eSPICRC           = QAD_SPI_CRC_Disable;
+  sDispSPI.uSPICRCPolynomial = 7;
+  sDispSPI.pClk_GPIO  = GPIOA; sDispSPI.uClk_Pin  = GPIO_PIN_5; sDispSPI.uClk_AF  = GPIO_AF5_SPI1;
+  sDispSPI.pMISO_GPIO = GPIOA; sDispSPI.uMISO_Pin = GPIO_PIN_6; sDispSPI.uMISO_AF = GPIO_AF5_SPI1;
+  sDispSPI.pMOSI_GPIO = GPIOA; sDispSPI.uMOSI_Pin = GPIO_PIN_7; sDispSPI.uMOSI_AF = GPIO_AF5_SPI1;
+  sDispSPI.pCS_GPIO   = NULL;
+
+  QAD_SPI* pDispSPI = new QAD_SPI(sDispSPI);
+  pDispSPI->init();
+  pDispSPI->start();
+
+  QAS_SPI_Bus* pDispBus = new QAS_SPI_Bus(pDispSPI);
+  QAS_SPI_Bus_Device sDispDevice = {QAD_SPI_ClkPolarity_Low, QAD_SPI_ClkPhase_1Edge, QAD_SPI_BaudPrescaler_2, QAD_SPI_DataSize_8bit,
+                                    QAD_SPI_FirstBit_MSB, GPIOB, GPIO_PIN_6};
+  int8_t iDispDevice = pDispBus->addDevice(sDispDevice);
+
+  QAS_Display_TFT_InitStruct sDispInit = {};
+  sDispInit.eController = QAS_Display_TFT_ILI9341;
+  sDispInit.uWidth      = 240;
+  sDispInit.uHeight     = 320;
+  sDispInit.uRotation   = 0;
+  sDispInit.bBGR        = true;
+  sDispInit.pDC_GPIO    = GPIOB; sDispInit.uDC_Pin    = GPIO_PIN_7;
+  sDispInit.pReset_GPIO = GPIOB; sDispInit.uReset_Pin = GPIO_PIN_8;
+
+  QAS_Display_TFT* pDisplay = new QAS_Display_TFT(pDispBus, iDispDevice, sDispInit);
+  pDisplay->init();
+
+  //Gradient renderer, offset by a frame counter so each frame differs
+  uint32_t uDispFrame = 0;
+  pDisplay->setRenderer([](uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight, uint16_t* pPixels, void* pData) {
+  	uint8_t uOffset = (uint8_t)*(uint32_t*)pData;
+  	for (uint16_t y=0; y<uHeight; y++) {
+  		for (uint16_t x=0; x<uWidth; x++)
+  			*pPixels++ = QAS_DISPLAY_TFT_RGB565(uX+x+uOffset, uY+y, uOffset);
+  	}
+  }, &uDispFrame);
+
+  char strDispBench[64];
+
+  uint32_t uDispStart = QAT_Timestamp::get();
+  for (uDispFrame=0; uDispFrame<50; uDispFrame++) {
+  	pDisplay->invalidateAll();
+  	pDisplay->update();
+  }
+  pDisplay->waitIdle();
+  uint32_t uDispFull = QAT_Timestamp::get() - uDispStart;
+
+  uDispStart = QAT_Timestamp::get();
+  for (uDispFrame=0; uDispFrame<1000; uDispFrame++) {
+  	pDisplay->invalidate(104, 144, 32, 32);
+  	pDisplay->update();
+  }
+  pDisplay->waitIdle();
+  uint32_t uDispPartial = QAT_Timestamp::get() - uDispStart;
+
+  sprintf(strDispBench, "Full: %lu.%02lu fps", (uint32_t)(((uint64_t)QAT_Timestamp::getFrequency() * 50) / uDispFull),
+                                               (uint32_t)((((uint64_t)QAT_Timestamp::getFrequency() * 5000) / uDispFull) % 100));
+  UART_STLink->txStringCR(strDispBench);
+  sprintf(strDispBench, "Partial 32x32: %lu fps", (uint32_t)(((uint64_t)QAT_Timestamp::getFrequency() * 1000) / uDispPartial));
+  UART_STLink->txStringCR(strDispBench);
+
+  delete pDisplay;
+  delete pDispBus;
+  pDispSPI->stop();
+  pDispSPI->deinit();
+  delete pDispSPI;*/
+
+
   //-------
   //Standby
   //
@@ -115,6 +115,8 @@ public:
 
 #define QAD_IRQPRIORITY_ADC      ((uint8_t) 0x0A)
 
+#define QAD_IRQPRIORITY_ADCDMA   ((uint8_t) 0x0A) //Priority for DMA transfer complete interrupts for QAD_ADC driver when in DMA data mode
+
 
 //Prevent Recursive Inclusion
 #endif /* __SETUP_HPP */
@@ -34,11 +34,39 @@ QA_Result QAD_ADC::imp_init(QAD_ADC_InitStruct& sInit) {
 	m_eTimer           = sInit.eTimer;
 	m_uTimer_Prescaler = sInit.uTimer_Prescaler;
 	m_uTimer_Period    = sInit.uTimer_Period;
+	m_eTimerMode       = sInit.eTimerMode;
+	m_eTrigger         = sInit.eTrigger;
+	m_uClockDivider    = (sInit.uClockDivider) ? sInit.uClockDivider : 4;
+	m_eDataMode        = sInit.eDataMode;
+	m_bContinuous      = sInit.bContinuous;
+	m_uBlockScans      = sInit.uBlockScans;
+	m_pBlockUser[0]    = sInit.pBlockBuffer0;
+	m_pBlockUser[1]    = sInit.pBlockBuffer1;
+	m_uBlockUserSize   = sInit.uBlockBufferSize;
+
+	//Check ADC clock
+	if ((m_uClockDivider > 8) || (m_uClockDivider & 0x01) || ((HAL_RCC_GetPCLK2Freq() / m_uClockDivider) > QAD_ADC_MAXCLOCK))
+		return QA_Fail;
+
+	//EXTI line 11 trigger does not use a timer
+	if (m_eTrigger == QAD_ADC_Trigger_EXTI11) {
+		m_eTimerMode = QAD_ADC_TimerMode_External;
+		return imp_periphInit(sInit);
+	}
 
-	if (!QAD_TimerMgr::getADC(m_eTimer)) {
+	//Check timer supports trigger
+	uint32_t uChannel;
+	if (m_eTrigger == QAD_ADC_Trigger_TRGO) {
+		if (!QAD_TimerMgr::getADC(m_eTimer))
+			return QA_Error_PeriphNotSupported;
+	} else if (imp_getTriggerTimer(m_eTrigger, uChannel) != m_eTimer) {
 		return QA_Error_PeriphNotSupported;
 	}
 
+	//In external timer mode the timer is owned by another driver, so is not registered here
+	if (m_eTimerMode == QAD_ADC_TimerMode_External)
+		return imp_periphInit(sInit);
+
   if (QAD_TimerMgr::getState(m_eTimer))
   	return QA_Error_PeriphBusy;
 
@@ -58,7 +86,62 @@ void QAD_ADC::imp_deinit(void) {
 		return;
 
 	imp_periphDeinit(DeinitFull);
-	QAD_TimerMgr::deregisterTimer(m_eTimer);
+	if (m_eTimerMode == QAD_ADC_TimerMode_Internal)
+		QAD_TimerMgr::deregisterTimer(m_eTimer);
+}
+
+
+//QAD_ADC::imp_plan
+//QAD_ADC Initialization Method
+//
+//Selects the fastest ADC clock within QAD_ADC_MAXCLOCK, then checks that a scan of the channels at their minimum sampling times
+//fits within QAD_ADC_PLANMARGIN percent of the scan period, with each conversion taking its sampling time plus 12 ADC clocks
+//If bExtendSampling is set, the longest sampling time for which the scan still fits is then applied to any channel with a shorter
+//sampling time. Finally the trigger timer's prescaler and period are calculated by QAD_TimerMgr::calcFrequency(), unless
+//no timer is used (continuous conversion, EXTI trigger or a timer owned by another driver)
+QA_Result QAD_ADC::imp_plan(QAD_ADC_InitStruct& sInit, uint32_t uScanRate, QAD_ADC_ChannelData* pChannels, uint8_t uChannels,
+		                        bool bExtendSampling) {
+	if ((!uScanRate) || (!uChannels) || (uChannels > QAD_ADC_MAXCHANNELS))
+		return QA_Fail;
+
+	//Select ADC clock divider
+	uint32_t uPCLK2 = HAL_RCC_GetPCLK2Freq();
+	uint8_t  uDiv   = 2;
+	while ((uDiv <= 8) && ((uPCLK2 / uDiv) > QAD_ADC_MAXCLOCK))
+		uDiv += 2;
+	if (uDiv > 8)
+		return QA_Fail;
+
+	//Check minimum conversion time against ADC clocks available per scan
+	uint64_t uBudget = ((uint64_t)(uPCLK2 / uDiv) * QAD_ADC_PLANMARGIN) / (100ULL * uScanRate);
+	if (imp_getScanCycles(pChannels, uChannels) > uBudget)
+		return QA_Fail;
+
+	//Extend sampling times
+	if (bExtendSampling) {
+		QAD_ADC_ChannelData sTest[QAD_ADC_MAXCHANNELS];
+		for (uint32_t i=QAD_ADC_PeriphSamplingTime_480Cycles; i>QAD_ADC_PeriphSamplingTime_3Cycles; i--) {
+			for (uint8_t j=0; j<uChannels; j++) {
+				sTest[j] = pChannels[j];
+				if ((uint32_t)sTest[j].eSamplingTime < i)
+					sTest[j].eSamplingTime = (QAD_ADC_SamplingTime)i;
+			}
+			if (imp_getScanCycles(sTest, uChannels) <= uBudget) {
+				for (uint8_t j=0; j<uChannels; j++)
+					pChannels[j].eSamplingTime = sTest[j].eSamplingTime;
+				break;
+			}
+		}
+	}
+
+	//Calculate timer settings
+	if ((sInit.eTimerMode == QAD_ADC_TimerMode_Internal) && (!sInit.bContinuous) && (sInit.eTrigger != QAD_ADC_Trigger_EXTI11)) {
+		if (QAD_TimerMgr::calcFrequency(sInit.eTimer, uScanRate, 2, false, sInit.uTimer_Prescaler, sInit.uTimer_Period) != QA_OK)
+			return QA_Fail;
+	}
+
+	sInit.uClockDivider = uDiv;
+	return QA_OK;
 }
 
 
@@ -70,6 +153,12 @@ void QAD_ADC::imp_deinit(void) {
 //QAD_ADC Peripheral Initialization Method
 QA_Result QAD_ADC::imp_periphInit(QAD_ADC_InitStruct& sInit) {
 
+	//Timer is only initialized in internal timer mode
+	if (m_eTimerMode == QAD_ADC_TimerMode_External) {
+		m_sTIMHandle.Instance = NULL;
+		return imp_periphInitADC();
+	}
+
 	//Enable Timer Clock
 	QAD_TimerMgr::enableClock(m_eTimer);
 
@@ -87,9 +176,42 @@ QA_Result QAD_ADC::imp_periphInit(QAD_ADC_InitStruct& sInit) {
 	}
 
 	//Setup Timer Trigger
-	TIM_MasterConfigTypeDef MC_Init = {0};
-	MC_Init.MasterOutputTrigger = TIM_TRGO_UPDATE;
-	HAL_TIMEx_MasterConfigSynchronization(&m_sTIMHandle, &MC_Init);
+	if (m_eTrigger == QAD_ADC_Trigger_TRGO) {
+		TIM_MasterConfigTypeDef MC_Init = {0};
+		MC_Init.MasterOutputTrigger = TIM_TRGO_UPDATE;
+		HAL_TIMEx_MasterConfigSynchronization(&m_sTIMHandle, &MC_Init);
+	} else {
+
+		//Compare event triggers use a PWM channel, giving one rising edge on the channel's reference signal per period
+		uint32_t uChannel;
+		imp_getTriggerTimer(m_eTrigger, uChannel);
+
+		TIM_OC_InitTypeDef OC_Init = {0};
+		OC_Init.OCMode     = TIM_OCMODE_PWM1;
+		OC_Init.Pulse      = (m_uTimer_Period + 1) / 2;
+		OC_Init.OCPolarity = TIM_OCPOLARITY_HIGH;
+		OC_Init.OCFastMode = TIM_OCFAST_DISABLE;
+		if (HAL_TIM_PWM_ConfigChannel(&m_sTIMHandle, &OC_Init, uChannel) != HAL_OK) {
+			imp_periphDeinit(DeinitPartial);
+			return QA_Fail;
+		}
+		TIM_CCxChannelCmd(m_sTIMHandle.Instance, uChannel, TIM_CCx_ENABLE);
+	}
+
+	//Initialize ADC
+	return imp_periphInitADC();
+}
+
+
+//QAD_ADC::imp_periphInitADC
+//QAD_ADC Peripheral Initialization Method
+QA_Result QAD_ADC::imp_periphInitADC(void) {
+
+	//Register DMA stream before any DMA hardware is set up, so that a stream in use by another driver is left untouched
+	if ((m_eDataMode != QAD_ADC_DataMode_Interrupt) && (QAD_DMAMgr::registerStream(DMA2_Stream0, QAD_DMA_InUse_ADC) != QA_OK)) {
+		imp_periphDeinit(DeinitPartial);
+		return QA_Error_PeriphBusy;
+	}
 
 	//Enable ADC Clock
 	__HAL_RCC_ADC1_CLK_ENABLE();
@@ -98,6 +220,15 @@ QA_Result QAD_ADC::imp_periphInit(QAD_ADC_InitStruct& sInit) {
 	HAL_NVIC_SetPriority(ADC_IRQn, QAD_IRQPRIORITY_ADC, 0x00);
 	HAL_NVIC_EnableIRQ(ADC_IRQn);
 
+	//Initialize DMA
+	if (m_eDataMode != QAD_ADC_DataMode_Interrupt) {
+		QAT_Timestamp::init();
+		if (imp_periphInitDMA() != QA_OK) {
+			imp_periphDeinit(DeinitFull);
+			return QA_Fail;
+		}
+	}
+
 	//Set States
 	m_eInitState = QA_Initialized;
 	m_eState     = QA_Inactive;
@@ -107,6 +238,40 @@ QA_Result QAD_ADC::imp_periphInit(QAD_ADC_InitStruct& sInit) {
 }
 
 
+//QAD_ADC::imp_periphInitDMA
+//QAD_ADC Peripheral Initialization Method
+//
+//Initializes DMA2 Stream0 Channel0 to transfer each conversion result from the ADC data register into the data array
+//in circular mode, so that each channel's result is always written to the array entry for its rank
+//In block data mode the stream is reconfigured for double buffer mode when started
+QA_Result QAD_ADC::imp_periphInitDMA(void) {
+
+	//Enable DMA Clock
+	__HAL_RCC_DMA2_CLK_ENABLE();
+
+	//Initialize DMA Stream
+	m_sDMAHandle.Instance                 = DMA2_Stream0;
+	m_sDMAHandle.Init.Channel             = DMA_CHANNEL_0;
+	m_sDMAHandle.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+	m_sDMAHandle.Init.PeriphInc           = DMA_PINC_DISABLE;
+	m_sDMAHandle.Init.MemInc              = DMA_MINC_ENABLE;
+	m_sDMAHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	m_sDMAHandle.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+	m_sDMAHandle.Init.Mode                = DMA_CIRCULAR;
+	m_sDMAHandle.Init.Priority            = DMA_PRIORITY_HIGH;
+	m_sDMAHandle.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+	if (HAL_DMA_Init(&m_sDMAHandle) != HAL_OK)
+		return QA_Fail;
+
+	//Enable DMA IRQ
+	HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, QAD_IRQPRIORITY_ADCDMA, 0x00);
+	HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+
+	//Return
+	return QA_OK;
+}
+
+
 //QAD_ADC::imp_periphDeinit
 //QAD_ADC Peripheral Initialization Method
 void QAD_ADC::imp_periphDeinit(QAD_ADC::DeinitMode eMode) {
@@ -119,18 +284,27 @@ void QAD_ADC::imp_periphDeinit(QAD_ADC::DeinitMode eMode) {
 	if (eMode) {
 
 		//Disable ADC IRQ
-		HAL_NVIC_EnableIRQ(ADC_IRQn);
+		HAL_NVIC_DisableIRQ(ADC_IRQn);
+
+		//Deinit DMA. The DMA2 clock is left enabled as it is shared with other DMA streams
+		if (m_eDataMode != QAD_ADC_DataMode_Interrupt) {
+			HAL_NVIC_DisableIRQ(DMA2_Stream0_IRQn);
+			HAL_DMA_DeInit(&m_sDMAHandle);
+			QAD_DMAMgr::deregisterStream(DMA2_Stream0, QAD_DMA_InUse_ADC);
+		}
 
 		//Disable ADC Clock
 		__HAL_RCC_ADC1_CLK_DISABLE();
 
 		//Deinit Timer
-		HAL_TIM_Base_DeInit(&m_sTIMHandle);
+		if (m_eTimerMode == QAD_ADC_TimerMode_Internal)
+			HAL_TIM_Base_DeInit(&m_sTIMHandle);
 
 	}
 
 	//Disable Timer Clock
-	QAD_TimerMgr::disableClock(m_eTimer);
+	if (m_eTimerMode == QAD_ADC_TimerMode_Internal)
+		QAD_TimerMgr::disableClock(m_eTimer);
 
 	//Set States
 	m_eInitState = QA_NotInitialized;
@@ -147,26 +321,85 @@ void QAD_ADC::imp_periphDeinit(QAD_ADC::DeinitMode eMode) {
 //QAD_ADC Handler Method
 void QAD_ADC::imp_handler(void) {
 
+	//Check for end of injected group conversion
+	if ((__HAL_ADC_GET_FLAG(&m_sADCHandle, ADC_FLAG_JEOC)) && (__HAL_ADC_GET_IT_SOURCE(&m_sADCHandle, ADC_IT_JEOC))) {
+		__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, (ADC_FLAG_JEOC | ADC_FLAG_JSTRT));
+
+		//Injected data registers JDR1 to JDR4 are consecutive, with JDRn holding the result of rank n
+		volatile uint32_t* pJDR = &m_sADCHandle.Instance->JDR1;
+		for (uint8_t i=0; i<m_uInjectedCount; i++)
+			m_uInjectedData[i] = (uint16_t)pJDR[i];
+
+		if (m_pInjectedCallback)
+			m_pInjectedCallback(m_pInjectedCallbackData);
+	}
+
+	//Check for analog watchdog, which is disabled until rearmed
+	if ((__HAL_ADC_GET_FLAG(&m_sADCHandle, ADC_FLAG_AWD)) && (__HAL_ADC_GET_IT_SOURCE(&m_sADCHandle, ADC_IT_AWD))) {
+		__HAL_ADC_DISABLE_IT(&m_sADCHandle, ADC_IT_AWD);
+		__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_AWD);
+		m_uWatchdogCount++;
+
+		if (m_pWatchdogCallback)
+			m_pWatchdogCallback(m_pWatchdogCallbackData);
+	}
+
 	//Check for overrun error
 	if (__HAL_ADC_GET_FLAG(&m_sADCHandle, ADC_FLAG_OVR)) {
-		imp_stop();
-		__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_OVR);
-		imp_start();
+		m_uOverrunCount++;
+		if (m_eDataMode != QAD_ADC_DataMode_Interrupt) {
+			imp_recoverOverrun();
+		} else {
+			imp_stop();
+			__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_OVR);
+			imp_start();
+		}
 	}
 
-	//Check for end of conversion
-	if (__HAL_ADC_GET_FLAG(&m_sADCHandle, ADC_FLAG_EOC)) {
+	//Check for end of conversion (interrupt data mode only, as in DMA data mode the data register is read by DMA)
+	if ((m_eDataMode == QAD_ADC_DataMode_Interrupt) && (__HAL_ADC_GET_FLAG(&m_sADCHandle, ADC_FLAG_EOC))) {
 
 		m_uData[m_uDataIdx] = m_sADCHandle.Instance->DR;
-		if (m_uDataIdx >= (m_uChannelCount-1))
-			m_uDataIdx = 0; else
+		if (m_uDataIdx >= (m_uChannelCount-1)) {
+			m_uDataIdx = 0;
+			if (m_pScanCallback)
+				m_pScanCallback(m_pScanCallbackData);
+		} else {
 			m_uDataIdx++;
+		}
 
 		__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_EOC);
 	}
 }
 
 
+//QAD_ADC::imp_handlerDMA
+//QAD_ADC Handler Method
+//
+//Handles DMA2 Stream0 interrupts in DMA and block data modes. The transfer complete interrupt occurs once per scan in DMA data mode,
+//and once per block in block data mode
+void QAD_ADC::imp_handlerDMA(void) {
+	uint32_t uISR = DMA2->LISR;
+
+	//Check for transfer error, restarting the DMA stream and ADC sequence
+	if (uISR & (DMA_LISR_TEIF0 | DMA_LISR_DMEIF0)) {
+		DMA2->LIFCR = (DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0);
+		imp_recoverOverrun();
+		return;
+	}
+
+	//Check for transfer complete, which indicates the end of a scan or block
+	if (uISR & DMA_LISR_TCIF0) {
+		DMA2->LIFCR = DMA_LIFCR_CTCIF0;
+		if (m_eDataMode == QAD_ADC_DataMode_Block) {
+			imp_completeBlock();
+		} else if (m_pScanCallback) {
+			m_pScanCallback(m_pScanCallbackData);
+		}
+	}
+}
+
+
 	//-----------------------
 	//-----------------------
 	//QAD_ADC Control Methods
@@ -174,23 +407,37 @@ void QAD_ADC::imp_handler(void) {
 //QAD_ADC::imp_start
 //QAD_ADC Control Method
 QA_Result QAD_ADC::imp_start(void) {
-	if ((m_eState) || (!m_uChannelCount))
+	if ((m_eState) || ((!m_uChannelCount) && (!m_uInjectedCount)))
 		return QA_Fail;
 
+	//The regular group is only started if it has channels, allowing the injected group to be used on its own
+	bool bRegular = (m_uChannelCount > 0);
+
+	//Check that a scan can be completed within each trigger period
+	if ((bRegular) && (imp_checkRate(m_sChannels, m_uChannelCount) != QA_OK))
+		return QA_Fail;
+
+	//Prepare block buffers
+	if ((bRegular) && (m_eDataMode == QAD_ADC_DataMode_Block)) {
+		QA_Result eRes = imp_prepareBlocks();
+		if (eRes)
+			return eRes;
+	}
+
 	//Initialize ADC
 	m_sADCHandle.Instance                   = ADC1;
-	m_sADCHandle.Init.ClockPrescaler        = ADC_CLOCKPRESCALER_PCLK_DIV4;
+	m_sADCHandle.Init.ClockPrescaler        = imp_getClockPrescaler();
 	m_sADCHandle.Init.Resolution            = ADC_RESOLUTION_12B;
 	m_sADCHandle.Init.ScanConvMode          = ENABLE;
-	m_sADCHandle.Init.ContinuousConvMode    = DISABLE;
+	m_sADCHandle.Init.ContinuousConvMode    = (m_bContinuous) ? ENABLE : DISABLE;
 	m_sADCHandle.Init.DiscontinuousConvMode = DISABLE;
 	m_sADCHandle.Init.NbrOfDiscConversion   = 0;
-	m_sADCHandle.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_RISING;
-	m_sADCHandle.Init.ExternalTrigConv      = imp_getTrigger();
+	m_sADCHandle.Init.ExternalTrigConvEdge  = ((m_bContinuous) || (!bRegular)) ? ADC_EXTERNALTRIGCONVEDGE_NONE : ADC_EXTERNALTRIGCONVEDGE_RISING;
+	m_sADCHandle.Init.ExternalTrigConv      = ((m_bContinuous) || (!bRegular)) ? ADC_SOFTWARE_START : imp_getTrigger();
 	m_sADCHandle.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
-	m_sADCHandle.Init.NbrOfConversion       = m_uChannelCount;
+	m_sADCHandle.Init.NbrOfConversion       = (bRegular) ? m_uChannelCount : 1;
 	m_sADCHandle.Init.DMAContinuousRequests = ENABLE;
-	m_sADCHandle.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;
+	m_sADCHandle.Init.EOCSelection          = (m_eDataMode != QAD_ADC_DataMode_Interrupt) ? ADC_EOC_SEQ_CONV : ADC_EOC_SINGLE_CONV;
 	if (HAL_ADC_Init(&m_sADCHandle) != HAL_OK) {
 		imp_stop();
 		return QA_Fail;
@@ -203,8 +450,7 @@ QA_Result QAD_ADC::imp_start(void) {
 	GPIO_Init.Speed = GPIO_SPEED_FREQ_LOW;
 
 	for (uint8_t i=0; i<m_uChannelCount; i++) {
-		if ((m_sChannels[i].eChannel != QAD_ADC_PeriphChannelVRefInt) ||
-				(m_sChannels[i].eChannel != QAD_ADC_PeriphChannelVBat)) {
+		if ((!imp_isInternal(m_sChannels[i].eChannel)) && (m_sChannels[i].pGPIO)) {
 			GPIO_Init.Pin       = m_sChannels[i].uPin;
 			HAL_GPIO_Init(m_sChannels[i].pGPIO, &GPIO_Init);
 		}
@@ -227,14 +473,34 @@ QA_Result QAD_ADC::imp_start(void) {
 
 	}
 
+	//Injected Group Configuration
+	if ((m_uInjectedCount) && (imp_startInjected() != QA_OK)) {
+		imp_stop();
+		return QA_Fail;
+	}
+
+	//Internal Channel Configuration
+	if (imp_enableInternal() != QA_OK) {
+		imp_stop();
+		return QA_Fail;
+	}
+
+	//Analog Watchdog Configuration
+	imp_applyWatchdog();
+
 	//Clear Data
 	for (uint8_t i=0; i<QAD_ADC_MAXCHANNELS; i++)
 		m_uData[i] = 0;
 	m_uDataIdx = 0;
 
-	//Enable ADC IRQ
-	HAL_ADC_Start_IT(&m_sADCHandle);
-	__HAL_TIM_ENABLE(&m_sTIMHandle);
+	//Start ADC in DMA/block or interrupt data mode. In continuous mode conversions start immediately, otherwise on the next timer trigger
+	if (bRegular) {
+		if (m_eDataMode != QAD_ADC_DataMode_Interrupt)
+			imp_startDMA(); else
+			HAL_ADC_Start_IT(&m_sADCHandle);
+		if ((m_eTimerMode == QAD_ADC_TimerMode_Internal) && (!m_bContinuous))
+			__HAL_TIM_ENABLE(&m_sTIMHandle);
+	}
 
 	//Set States
 	m_eState = QA_Active;
@@ -249,13 +515,31 @@ QA_Result QAD_ADC::imp_start(void) {
 void QAD_ADC::imp_stop(void) {
 
 	//Disable ADC IRQ
-	__HAL_TIM_DISABLE(&m_sTIMHandle);
-	HAL_ADC_Stop_IT(&m_sADCHandle);
+	if (m_eTimerMode == QAD_ADC_TimerMode_Internal)
+		__HAL_TIM_DISABLE(&m_sTIMHandle);
+	__HAL_ADC_DISABLE_IT(&m_sADCHandle, ADC_IT_JEOC);
+	m_sADCHandle.Instance->CR1 &= ~(uint32_t)(ADC_CR1_AWDEN | ADC_CR1_JAWDEN | ADC_CR1_AWDIE);
+	if (m_eDataMode != QAD_ADC_DataMode_Interrupt) {
+		__HAL_ADC_DISABLE_IT(&m_sADCHandle, ADC_IT_OVR);
+		m_sADCHandle.Instance->CR2 &= ~ADC_CR2_DMA;
+		HAL_ADC_Stop(&m_sADCHandle);
+		imp_stopDMAStream();
+	} else {
+		HAL_ADC_Stop_IT(&m_sADCHandle);
+	}
 
 	//GPIO Deinitialization
 	for (uint8_t i=0; i<m_uChannelCount; i++) {
-		HAL_GPIO_DeInit(m_sChannels[i].pGPIO, m_sChannels[i].uPin);
+		if ((!imp_isInternal(m_sChannels[i].eChannel)) && (m_sChannels[i].pGPIO))
+			HAL_GPIO_DeInit(m_sChannels[i].pGPIO, m_sChannels[i].uPin);
 	}
+	for (uint8_t i=0; i<m_uInjectedCount; i++) {
+		if ((!imp_isInternal(m_sInjected[i].eChannel)) && (m_sInjected[i].pGPIO))
+			HAL_GPIO_DeInit(m_sInjected[i].pGPIO, m_sInjected[i].uPin);
+	}
+
+	//Disable temperature sensor, VREFINT and VBAT to save power
+	ADC->CCR &= ~(uint32_t)(ADC_CCR_TSVREFE | ADC_CCR_VBATE);
 
 	//Deinitialize ADC
 	HAL_ADC_DeInit(&m_sADCHandle);
@@ -267,34 +551,255 @@ void QAD_ADC::imp_stop(void) {
 
 //QAD_ADC::imp_addChannel
 //QAD_ADC Control Method
+//
+//Adds a channel to the end of the regular group sequence. If a transaction is open the channel is staged until the transaction
+//is committed, otherwise it is applied immediately
 void QAD_ADC::imp_addChannel(QAD_ADC_ChannelData& sChannel) {
+	bool bCommit = !m_bTransaction;
+	if (bCommit)
+		imp_beginTransaction();
 
-	if (m_uChannelCount >= 16)
+	if (m_uStagedCount >= QAD_ADC_MAXCHANNELS) {
+		if (bCommit)
+			m_bTransaction = false;
 		return;
-
-	//Check if ADC is running
-  bool bStarted = false;
-  if (m_eState) {
-  	bStarted = true;
-  	imp_stop();
-  }
+	}
 
   //Update Channel Data
-  m_sChannels[m_uChannelCount] = sChannel;
-  m_uChannelCount++;
+	m_sStaged[m_uStagedCount] = sChannel;
+	m_uStagedCount++;
 
-  //Restart ADC if required
-  if (bStarted) {
-  	imp_start();
-  }
+	//Apply if not within a transaction
+	if (bCommit)
+		imp_commitTransaction();
 }
 
 
 //QAD_ADC::imp_removeChannel
 //QAD_ADC Control Method
+//
+//Removes a channel from the regular group sequence by its index. If a transaction is open the removal is staged until the
+//transaction is committed (with the index referring to the staged sequence), otherwise it is applied immediately
 void QAD_ADC::imp_removeChannel(QAD_ADC_Channel eChannel) {
-	if ((!m_uChannelCount) && (eChannel < m_uChannelCount))
+	bool bCommit = !m_bTransaction;
+	if (bCommit)
+		imp_beginTransaction();
+
+	if (eChannel >= m_uStagedCount) {
+		if (bCommit)
+			m_bTransaction = false;
+		return;
+	}
+
+  for (uint8_t i=eChannel; i<(m_uStagedCount-1); i++)
+  	m_sStaged[i] = m_sStaged[i+1];
+  m_uStagedCount--;
+
+	//Apply if not within a transaction
+	if (bCommit)
+		imp_commitTransaction();
+}
+
+
+//QAD_ADC::imp_removeChannelPeriph
+//QAD_ADC Control Method
+//
+//Removes a channel from the regular group sequence by its ADC channel. If a transaction is open the removal is staged until the
+//transaction is committed, otherwise it is applied immediately
+void QAD_ADC::imp_removeChannelPeriph(QAD_ADC_PeriphChannel eChannel) {
+	bool bCommit = !m_bTransaction;
+	if (bCommit)
+		imp_beginTransaction();
+
+	int8_t iChannelIdx = imp_findChannelList(m_sStaged, m_uStagedCount, eChannel);
+	if (iChannelIdx < 0) {
+		if (bCommit)
+			m_bTransaction = false;
 		return;
+	}
+
+  for (uint8_t i=iChannelIdx; i<(m_uStagedCount-1); i++)
+  	m_sStaged[i] = m_sStaged[i+1];
+  m_uStagedCount--;
+
+	//Apply if not within a transaction
+	if (bCommit)
+		imp_commitTransaction();
+}
+
+
+//QAD_ADC::imp_beginTransaction
+//QAD_ADC Control Method
+//
+//Opens a channel transaction, staging a copy of the current regular group sequence. Has no effect if a transaction is already open
+void QAD_ADC::imp_beginTransaction(void) {
+	if (m_bTransaction)
+		return;
+
+	for (uint8_t i=0; i<m_uChannelCount; i++)
+		m_sStaged[i] = m_sChannels[i];
+	m_uStagedCount = m_uChannelCount;
+	m_bTransaction = true;
+}
+
+
+//QAD_ADC::imp_commitTransaction
+//QAD_ADC Control Method
+//
+//Closes the open channel transaction and applies the staged regular group sequence
+//If the ADC is running and its regular group remains active, the sequence is applied incrementally by imp_reconfigure().
+//Otherwise (including when the regular group becomes empty or is added to an injected only configuration) the ADC is
+//stopped and restarted
+//Returns QA_OK if successful, QA_Fail if no transaction is open or the ADC fails to restart, or QA_Error_PeriphBusy if the
+//ADC is running in block data mode and a block retrieved by getBlock() has not been released, in which case the transaction
+//is left open so it can be committed again once the block is released
+QA_Result QAD_ADC::imp_commitTransaction(void) {
+	if (!m_bTransaction)
+		return QA_Fail;
+	if ((m_eState) && (m_eDataMode == QAD_ADC_DataMode_Block) && (m_bBlockHeld))
+		return QA_Error_PeriphBusy;
+	m_bTransaction = false;
+
+	//Apply incrementally if running
+	if ((m_eState) && (m_uChannelCount) && (m_uStagedCount))
+		return imp_reconfigure();
+
+	//Check if ADC is running
+	bool bStarted = false;
+	if (m_eState) {
+		bStarted = true;
+		imp_stop();
+	}
+
+	//Update Channel Data
+	for (uint8_t i=0; i<m_uStagedCount; i++)
+		m_sChannels[i] = m_sStaged[i];
+	m_uChannelCount = m_uStagedCount;
+
+	//Restart ADC if required
+	if ((bStarted) && ((m_uChannelCount) || (m_uInjectedCount)))
+		return imp_start();
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_reconfigure
+//QAD_ADC Control Method
+//
+//Applies the staged regular group sequence while the ADC is running, without deinitializing the ADC or its channel GPIOs
+//The trigger timer is paused and the ADC is briefly disabled (aborting any conversion in progress), then only the sequence
+//registers (SQR1 to SQR3, including the sequence length) and the affected sampling time fields (SMPR1 and SMPR2) are rewritten.
+//Data for channels present in both the old and new sequences is kept. In DMA and block data modes the DMA stream is restarted
+//for the new sequence length, with any partially filled block being discarded
+//Returns QA_OK if successful, or QA_Fail if the new sequence cannot be applied. If the new sequence cannot be converted within
+//the trigger period it is discarded and the ADC continues with the current sequence, otherwise on failure the ADC is stopped
+QA_Result QAD_ADC::imp_reconfigure(void) {
+
+	//Check that a scan can be completed within each trigger period, leaving the current sequence running if not
+	if (imp_checkRate(m_sStaged, m_uStagedCount) != QA_OK)
+		return QA_Fail;
+
+	//Channel GPIO Configuration for new channels
+	GPIO_InitTypeDef GPIO_Init = {0};
+	GPIO_Init.Mode  = GPIO_MODE_ANALOG;
+	GPIO_Init.Pull  = GPIO_NOPULL;
+	GPIO_Init.Speed = GPIO_SPEED_FREQ_LOW;
+
+	for (uint8_t i=0; i<m_uStagedCount; i++) {
+		if ((!imp_isInternal(m_sStaged[i].eChannel)) && (m_sStaged[i].pGPIO) &&
+				(imp_findChannelPeriph(m_sStaged[i].eChannel) < 0)) {
+			GPIO_Init.Pin = m_sStaged[i].uPin;
+			HAL_GPIO_Init(m_sStaged[i].pGPIO, &GPIO_Init);
+		}
+	}
+
+	//Pause trigger timer and disable ADC, which aborts any conversion in progress
+	if (m_eTimerMode == QAD_ADC_TimerMode_Internal)
+		__HAL_TIM_DISABLE(&m_sTIMHandle);
+	m_sADCHandle.Instance->CR2 &= ~ADC_CR2_ADON;
+	if (m_eDataMode != QAD_ADC_DataMode_Interrupt) {
+		m_sADCHandle.Instance->CR2 &= ~ADC_CR2_DMA;
+		imp_stopDMAStream();
+	}
+
+	//GPIO Deinitialization for removed channels
+	for (uint8_t i=0; i<m_uChannelCount; i++) {
+		if ((!imp_isInternal(m_sChannels[i].eChannel)) && (m_sChannels[i].pGPIO) &&
+				(imp_findChannelList(m_sStaged, m_uStagedCount, m_sChannels[i].eChannel) < 0))
+			HAL_GPIO_DeInit(m_sChannels[i].pGPIO, m_sChannels[i].uPin);
+	}
+
+	//Update Channel Data, keeping data for channels in both sequences
+	uint16_t uData[QAD_ADC_MAXCHANNELS];
+	for (uint8_t i=0; i<m_uStagedCount; i++) {
+		int8_t iChannelIdx = imp_findChannelPeriph(m_sStaged[i].eChannel);
+		uData[i] = (iChannelIdx >= 0) ? m_uData[iChannelIdx] : 0;
+	}
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	for (uint8_t i=0; i<m_uStagedCount; i++) {
+		m_sChannels[i] = m_sStaged[i];
+		m_uData[i]     = uData[i];
+	}
+	m_uChannelCount = m_uStagedCount;
+	m_uDataIdx      = 0;
+	m_sADCHandle.Init.NbrOfConversion = m_uChannelCount;
+	__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, (ADC_FLAG_EOC | ADC_FLAG_STRT | ADC_FLAG_OVR));
+	__set_PRIMASK(uPRIMASK);
+
+	//Write sequence and sampling time registers
+	imp_writeSequence();
+
+	//Internal Channel Configuration and block buffers
+	if ((imp_enableInternal() != QA_OK) ||
+			((m_eDataMode == QAD_ADC_DataMode_Block) && (imp_prepareBlocks() != QA_OK))) {
+		imp_stop();
+		return QA_Fail;
+	}
+
+	//Enable ADC and wait for it to stabilize
+	m_sADCHandle.Instance->CR2 |= ADC_CR2_ADON;
+	imp_delay(ADC_STAB_DELAY_US);
+
+	//Restart DMA stream, conversions and trigger timer
+	if (m_eDataMode != QAD_ADC_DataMode_Interrupt) {
+		imp_startDMAStream();
+		m_sADCHandle.Instance->CR2 |= ADC_CR2_DMA;
+	}
+	if (m_bContinuous)
+		m_sADCHandle.Instance->CR2 |= ADC_CR2_SWSTART;
+	if (m_eTimerMode == QAD_ADC_TimerMode_Internal)
+		__HAL_TIM_ENABLE(&m_sTIMHandle);
+
+	//Return
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_setScanCallback
+//QAD_ADC Control Method
+void QAD_ADC::imp_setScanCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_pScanCallback     = pCallback;
+	m_pScanCallbackData = pData;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+	//------------------------------
+	//------------------------------
+	//QAD_ADC Injected Group Methods
+
+//QAD_ADC::imp_addInjectedChannel
+//QAD_ADC Injected Group Method
+//
+//Adds a channel to the injected group, restarting the ADC if it is running
+//Returns QA_OK if successful, or QA_Fail if the injected group is full
+QA_Result QAD_ADC::imp_addInjectedChannel(QAD_ADC_ChannelData& sChannel) {
+	if (m_uInjectedCount >= QAD_ADC_MAXINJECTED)
+		return QA_Fail;
 
 	//Check if ADC is running
   bool bStarted = false;
@@ -303,24 +808,23 @@ void QAD_ADC::imp_removeChannel(QAD_ADC_Channel eChannel) {
   	imp_stop();
   }
 
-  if (eChannel != (m_uChannelCount - 1)) {
-  	for (uint8_t i=eChannel; i<(m_uChannelCount-1); i++)
-  		m_sChannels[i] = m_sChannels[i+1];
-  }
-  m_uChannelCount--;
+  m_sInjected[m_uInjectedCount] = sChannel;
+  m_uInjectedCount++;
 
   //Restart ADC if required
-  if (bStarted) {
-  	imp_start();
-  }
+  if (bStarted)
+  	return imp_start();
+  return QA_OK;
 }
 
 
-//QAD_ADC::imp_removeChannelPeriph
-//QAD_ADC Control Method
-void QAD_ADC::imp_removeChannelPeriph(QAD_ADC_PeriphChannel eChannel) {
-	int8_t iChannelIdx = imp_findChannelPeriph(eChannel);
-	if ((!m_uChannelCount) && (iChannelIdx < 0))
+//QAD_ADC::imp_removeInjectedChannel
+//QAD_ADC Injected Group Method
+//
+//Removes a channel from the injected group, restarting the ADC if it is running
+//uChannel - Index of the channel within the injected group
+void QAD_ADC::imp_removeInjectedChannel(uint8_t uChannel) {
+	if (uChannel >= m_uInjectedCount)
 		return;
 
 	//Check if ADC is running
@@ -330,16 +834,308 @@ void QAD_ADC::imp_removeChannelPeriph(QAD_ADC_PeriphChannel eChannel) {
   	imp_stop();
   }
 
-  if (iChannelIdx != (m_uChannelCount - 1)) {
-  	for (uint8_t i=iChannelIdx; i<(m_uChannelCount-1); i++)
-  		m_sChannels[i] = m_sChannels[i+1];
-  }
-  m_uChannelCount--;
+  for (uint8_t i=uChannel; i<(m_uInjectedCount-1); i++)
+  	m_sInjected[i] = m_sInjected[i+1];
+  m_uInjectedCount--;
 
   //Restart ADC if required
-  if (bStarted) {
+  if ((bStarted) && ((m_uChannelCount) || (m_uInjectedCount)))
   	imp_start();
-  }
+}
+
+
+//QAD_ADC::imp_setInjectedCallback
+//QAD_ADC Injected Group Method
+void QAD_ADC::imp_setInjectedCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_pInjectedCallback     = pCallback;
+	m_pInjectedCallbackData = pData;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+//QAD_ADC::imp_startInjected
+//QAD_ADC Injected Group Method
+//
+//Configures the injected group channels and trigger, and enables the injected group with its end of conversion interrupt
+//Used by imp_start() once the ADC has been initialized
+//Returns QA_OK if successful, or QA_Fail if channel configuration fails
+QA_Result QAD_ADC::imp_startInjected(void) {
+
+	//Channel GPIO Configuration
+	GPIO_InitTypeDef GPIO_Init = {0};
+	GPIO_Init.Mode  = GPIO_MODE_ANALOG;
+	GPIO_Init.Pull  = GPIO_NOPULL;
+	GPIO_Init.Speed = GPIO_SPEED_FREQ_LOW;
+
+	for (uint8_t i=0; i<m_uInjectedCount; i++) {
+		if ((!imp_isInternal(m_sInjected[i].eChannel)) && (m_sInjected[i].pGPIO)) {
+			GPIO_Init.Pin = m_sInjected[i].uPin;
+			HAL_GPIO_Init(m_sInjected[i].pGPIO, &GPIO_Init);
+		}
+	}
+
+	//Channel Configuration
+	ADC_InjectionConfTypeDef ADCInjected_Init = {0};
+	ADCInjected_Init.InjectedNbrOfConversion       = m_uInjectedCount;
+	ADCInjected_Init.InjectedOffset                = 0;
+	ADCInjected_Init.InjectedDiscontinuousConvMode = DISABLE;
+	ADCInjected_Init.AutoInjectedConv              = DISABLE;
+	ADCInjected_Init.ExternalTrigInjecConv         = m_eInjectedTrigger;
+	ADCInjected_Init.ExternalTrigInjecConvEdge     = ADC_EXTERNALTRIGINJECCONVEDGE_RISING;
+
+	for (uint8_t i=0; i<m_uInjectedCount; i++) {
+		ADCInjected_Init.InjectedChannel      = m_sInjected[i].eChannel;
+		ADCInjected_Init.InjectedRank         = i+1;
+		ADCInjected_Init.InjectedSamplingTime = m_sInjected[i].eSamplingTime;
+
+		if (HAL_ADCEx_InjectedConfigChannel(&m_sADCHandle, &ADCInjected_Init) != HAL_OK)
+			return QA_Fail;
+	}
+
+	//Clear Data
+	for (uint8_t i=0; i<QAD_ADC_MAXINJECTED; i++)
+		m_uInjectedData[i] = 0;
+
+	//Enable ADC and injected group end of conversion interrupt. Conversions start on the next injected trigger
+	HAL_ADCEx_InjectedStart_IT(&m_sADCHandle);
+
+	//Return
+	return QA_OK;
+}
+
+
+	//---------------------
+	//---------------------
+	//QAD_ADC Block Methods
+
+//QAD_ADC::imp_setBlockCallback
+//QAD_ADC Block Method
+void QAD_ADC::imp_setBlockCallback(QAD_ADC_BlockCallback pCallback, void* pData) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_pBlockCallback     = pCallback;
+	m_pBlockCallbackData = pData;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+//QAD_ADC::imp_getBlock
+//QAD_ADC Block Method
+//
+//Retrieves the most recently completed block in block data mode, when no block callback is set
+//The block is held until releaseBlock() is called. If a block is still held when the following block completes, the held block's
+//buffer is already being refilled and it is counted as dropped
+//Returns QA_OK if a new block was retrieved, or QA_Fail if no new block is available
+QA_Result QAD_ADC::imp_getBlock(QAD_ADC_Block& sBlock) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	if (!m_bBlockPending) {
+		__set_PRIMASK(uPRIMASK);
+		return QA_Fail;
+	}
+	sBlock          = m_sBlock;
+	m_bBlockPending = false;
+	m_bBlockHeld    = true;
+	__set_PRIMASK(uPRIMASK);
+	return QA_OK;
+}
+
+
+	//-------------------------------
+	//-------------------------------
+	//QAD_ADC Analog Watchdog Methods
+
+//QAD_ADC::imp_setWatchdog
+//QAD_ADC Analog Watchdog Method
+//
+//Sets the analog watchdog mode, channel and thresholds, and arms the watchdog. Takes effect immediately if the ADC is running
+//Returns QA_OK if successful, or QA_Fail if the thresholds are invalid
+QA_Result QAD_ADC::imp_setWatchdog(QAD_ADC_WatchdogMode eMode, QAD_ADC_PeriphChannel eChannel, uint16_t uLow, uint16_t uHigh) {
+	if ((uHigh > 4095) || (uLow > uHigh))
+		return QA_Fail;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_eWatchdogMode    = eMode;
+	m_eWatchdogChannel = eChannel;
+	m_uWatchdogLow     = uLow;
+	m_uWatchdogHigh    = uHigh;
+	if (m_eState)
+		imp_applyWatchdog();
+	__set_PRIMASK(uPRIMASK);
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_setWatchdogMillivolts
+//QAD_ADC Analog Watchdog Method
+//
+//Converts thresholds in millivolts to raw values using the current VDDA, then sets the analog watchdog as imp_setWatchdog()
+QA_Result QAD_ADC::imp_setWatchdogMillivolts(QAD_ADC_WatchdogMode eMode, QAD_ADC_PeriphChannel eChannel, uint16_t uLow, uint16_t uHigh) {
+	uint32_t uVdda = imp_getVdda();
+	uint32_t uRawLow  = (((uint32_t)uLow * 4095) + (uVdda / 2)) / uVdda;
+	uint32_t uRawHigh = (((uint32_t)uHigh * 4095) + (uVdda / 2)) / uVdda;
+	if (uRawLow > 4095)
+		uRawLow = 4095;
+	if (uRawHigh > 4095)
+		uRawHigh = 4095;
+	return imp_setWatchdog(eMode, eChannel, (uint16_t)uRawLow, (uint16_t)uRawHigh);
+}
+
+
+//QAD_ADC::imp_rearmWatchdog
+//QAD_ADC Analog Watchdog Method
+//
+//Enables the analog watchdog interrupt again after it has triggered
+void QAD_ADC::imp_rearmWatchdog(void) {
+	if ((!m_eState) || (m_eWatchdogMode == QAD_ADC_WatchdogMode_Disabled))
+		return;
+	__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_AWD);
+	__HAL_ADC_ENABLE_IT(&m_sADCHandle, ADC_IT_AWD);
+}
+
+
+//QAD_ADC::imp_setWatchdogCallback
+//QAD_ADC Analog Watchdog Method
+void QAD_ADC::imp_setWatchdogCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_pWatchdogCallback     = pCallback;
+	m_pWatchdogCallbackData = pData;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+//QAD_ADC::imp_applyWatchdog
+//QAD_ADC Analog Watchdog Method
+//
+//Writes the analog watchdog thresholds and configuration to the ADC, enabling the watchdog on the regular and/or injected groups
+//depending on which have channels, and arms its interrupt. Used by imp_start() and imp_setWatchdog()
+void QAD_ADC::imp_applyWatchdog(void) {
+	ADC_TypeDef* pADC = m_sADCHandle.Instance;
+	uint32_t uCR1 = pADC->CR1 & ~(uint32_t)(ADC_CR1_AWDEN | ADC_CR1_JAWDEN | ADC_CR1_AWDIE | ADC_CR1_AWDSGL | ADC_CR1_AWDCH);
+
+	if (m_eWatchdogMode != QAD_ADC_WatchdogMode_Disabled) {
+		pADC->HTR = m_uWatchdogHigh;
+		pADC->LTR = m_uWatchdogLow;
+
+		if (m_eWatchdogMode == QAD_ADC_WatchdogMode_Single)
+			uCR1 |= ADC_CR1_AWDSGL | ((uint32_t)(uint16_t)m_eWatchdogChannel & ADC_CR1_AWDCH);
+		if (m_uChannelCount)
+			uCR1 |= ADC_CR1_AWDEN;
+		if (m_uInjectedCount)
+			uCR1 |= ADC_CR1_JAWDEN;
+		uCR1 |= ADC_CR1_AWDIE;
+		__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_AWD);
+	}
+	pADC->CR1 = uCR1;
+}
+
+
+	//--------------------------
+	//--------------------------
+	//QAD_ADC Calibrated Methods
+
+//QAD_ADC::imp_getMillivolts
+//QAD_ADC Calibrated Method
+//
+//Converts a raw 12bit conversion result to millivolts
+//If the VRefInt channel is in either the regular or injected group, VDDA is measured from it using the factory VREFINT calibration
+//value, otherwise VDDA is assumed to be QAD_ADC_CAL_VDDA (3.3V)
+uint16_t QAD_ADC::imp_getMillivolts(uint16_t uRaw) {
+	imp_refreshCalibration();
+	return (uint16_t)(((uint32_t)uRaw * m_uCalScale) >> 16);
+}
+
+
+//QAD_ADC::imp_getVdda
+//QAD_ADC Calibrated Method
+//
+//Returns VDDA in millivolts, as measured from the VRefInt channel, or QAD_ADC_CAL_VDDA if the VRefInt channel is not in use
+uint16_t QAD_ADC::imp_getVdda(void) {
+	imp_refreshCalibration();
+	return m_uCalVdda;
+}
+
+
+//QAD_ADC::imp_getTemperature
+//QAD_ADC Calibrated Method
+//
+//Gets the die temperature in hundredths of a degree C, from the Temp channel in either the regular or injected group
+//The raw value is first scaled to the VDDA at which the factory calibration values were measured, then interpolated between the
+//30 and 110 degree C calibration points
+//iTemp - Set to the temperature. Left unchanged if the Temp channel is not in use
+//Returns QA_OK if successful, or QA_Fail if the Temp channel is not in use
+QA_Result QAD_ADC::imp_getTemperature(int32_t& iTemp) {
+	uint16_t uRaw;
+	if (imp_getInternalData(QAD_ADC_PeriphChannelTemp, uRaw) != QA_OK)
+		return QA_Fail;
+
+	imp_refreshCalibration();
+	int64_t iScaled = ((int64_t)uRaw * m_uCalTSScale) - ((int64_t)QAD_ADC_TS_CAL1 << 16);
+	iTemp = 3000 + (int32_t)((iScaled * (11000 - 3000)) / ((int64_t)(QAD_ADC_TS_CAL2 - QAD_ADC_TS_CAL1) << 16));
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_getVbat
+//QAD_ADC Calibrated Method
+//
+//Gets the backup battery voltage in millivolts, from the VBat channel in either the regular or injected group
+//uVbat - Set to the voltage. Left unchanged if the VBat channel is not in use
+//Returns QA_OK if successful, or QA_Fail if the VBat channel is not in use
+QA_Result QAD_ADC::imp_getVbat(uint16_t& uVbat) {
+	uint16_t uRaw;
+	if (imp_getInternalData(QAD_ADC_PeriphChannelVBat, uRaw) != QA_OK)
+		return QA_Fail;
+
+	uVbat = imp_getMillivolts(uRaw) * QAD_ADC_VBAT_DIVIDER;
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_getInternalData
+//QAD_ADC Calibrated Method
+//
+//Gets the most recent conversion result for an internal channel, from the regular group if it is present there, otherwise
+//from the injected group
+//uData - Set to the conversion result. Left unchanged if the channel is not in use
+//Returns QA_OK if successful, or QA_Fail if the channel is not in use
+QA_Result QAD_ADC::imp_getInternalData(QAD_ADC_PeriphChannel eChannel, uint16_t& uData) {
+	int8_t iChannelIdx = imp_findChannelPeriph(eChannel);
+	if (iChannelIdx >= 0) {
+		uData = m_uData[iChannelIdx];
+		return QA_OK;
+	}
+
+	for (uint8_t i=0; i<m_uInjectedCount; i++) {
+		if (m_sInjected[i].eChannel == eChannel) {
+			uData = m_uInjectedData[i];
+			return QA_OK;
+		}
+	}
+	return QA_Fail;
+}
+
+
+//QAD_ADC::imp_refreshCalibration
+//QAD_ADC Calibrated Method
+//
+//Recalculates VDDA and the fixed point conversion scales when the VREFINT conversion result has changed since they were last
+//calculated, so that the divisions are only performed when VREFINT has been resampled with a different value
+void QAD_ADC::imp_refreshCalibration(void) {
+	//A result of 0 is ignored as well as an unused channel, as VDDA is calculated by dividing by it
+	uint16_t uVref = 0;
+	imp_getInternalData(QAD_ADC_PeriphChannelVRefInt, uVref);
+	if ((!uVref) || (uVref == m_uCalVrefRaw))
+		return;
+
+	m_uCalVrefRaw = uVref;
+	m_uCalVdda    = (uint16_t)(((uint32_t)QAD_ADC_CAL_VDDA * QAD_ADC_VREFINT_CAL) / uVref);
+	m_uCalScale   = ((uint32_t)m_uCalVdda << 16) / 4095;
+	m_uCalTSScale = ((uint32_t)m_uCalVdda << 16) / QAD_ADC_CAL_VDDA;
 }
 
 
@@ -376,19 +1172,136 @@ uint16_t QAD_ADC::imp_getDataIdx(uint8_t uChannel) {
 
 //QAD_ADC::imp_getTrigger
 //QAD_ADC Tool Method
+//
+//Returns the regular group external trigger for the selected trigger source
+//Note that TIM1's TRGO can only trigger the injected group, so a center-aligned PWM on TIM1 must use a compare event trigger
 uint32_t QAD_ADC::imp_getTrigger(void) {
-	uint32_t uTrigger;
-	switch (m_eTimer) {
-		case QAD_Timer2:
-			uTrigger = ADC_EXTERNALTRIGCONV_T2_TRGO;
-			break;
-		case QAD_Timer3:
-			uTrigger = ADC_EXTERNALTRIGCONV_T3_TRGO;
-			break;
+	switch (m_eTrigger) {
+		case QAD_ADC_Trigger_TRGO:
+			return (m_eTimer == QAD_Timer2) ? ADC_EXTERNALTRIGCONV_T2_TRGO : ADC_EXTERNALTRIGCONV_T3_TRGO;
+		case QAD_ADC_Trigger_T1_CC1:
+			return ADC_EXTERNALTRIGCONV_T1_CC1;
+		case QAD_ADC_Trigger_T1_CC2:
+			return ADC_EXTERNALTRIGCONV_T1_CC2;
+		case QAD_ADC_Trigger_T1_CC3:
+			return ADC_EXTERNALTRIGCONV_T1_CC3;
+		case QAD_ADC_Trigger_T2_CC2:
+			return ADC_EXTERNALTRIGCONV_T2_CC2;
+		case QAD_ADC_Trigger_T2_CC3:
+			return ADC_EXTERNALTRIGCONV_T2_CC3;
+		case QAD_ADC_Trigger_T2_CC4:
+			return ADC_EXTERNALTRIGCONV_T2_CC4;
+		case QAD_ADC_Trigger_T3_CC1:
+			return ADC_EXTERNALTRIGCONV_T3_CC1;
+		case QAD_ADC_Trigger_T4_CC4:
+			return ADC_EXTERNALTRIGCONV_T4_CC4;
+		case QAD_ADC_Trigger_T5_CC1:
+			return ADC_EXTERNALTRIGCONV_T5_CC1;
+		case QAD_ADC_Trigger_T5_CC2:
+			return ADC_EXTERNALTRIGCONV_T5_CC2;
+		case QAD_ADC_Trigger_T5_CC3:
+			return ADC_EXTERNALTRIGCONV_T5_CC3;
+		default:
+			return ADC_EXTERNALTRIGCONV_Ext_IT11;
+	}
+}
+
+
+//QAD_ADC::imp_getTriggerTimer
+//QAD_ADC Tool Method
+//
+//Returns the timer used by a compare event trigger, setting uChannel to the timer channel (TIM_CHANNEL_x)
+//Returns QAD_TimerNone for QAD_ADC_Trigger_TRGO and QAD_ADC_Trigger_EXTI11
+QAD_Timer_Periph QAD_ADC::imp_getTriggerTimer(QAD_ADC_Trigger eTrigger, uint32_t& uChannel) {
+	switch (eTrigger) {
+		case QAD_ADC_Trigger_T1_CC1:
+			uChannel = TIM_CHANNEL_1;
+			return QAD_Timer1;
+		case QAD_ADC_Trigger_T1_CC2:
+			uChannel = TIM_CHANNEL_2;
+			return QAD_Timer1;
+		case QAD_ADC_Trigger_T1_CC3:
+			uChannel = TIM_CHANNEL_3;
+			return QAD_Timer1;
+		case QAD_ADC_Trigger_T2_CC2:
+			uChannel = TIM_CHANNEL_2;
+			return QAD_Timer2;
+		case QAD_ADC_Trigger_T2_CC3:
+			uChannel = TIM_CHANNEL_3;
+			return QAD_Timer2;
+		case QAD_ADC_Trigger_T2_CC4:
+			uChannel = TIM_CHANNEL_4;
+			return QAD_Timer2;
+		case QAD_ADC_Trigger_T3_CC1:
+			uChannel = TIM_CHANNEL_1;
+			return QAD_Timer3;
+		case QAD_ADC_Trigger_T4_CC4:
+			uChannel = TIM_CHANNEL_4;
+			return QAD_Timer4;
+		case QAD_ADC_Trigger_T5_CC1:
+			uChannel = TIM_CHANNEL_1;
+			return QAD_Timer5;
+		case QAD_ADC_Trigger_T5_CC2:
+			uChannel = TIM_CHANNEL_2;
+			return QAD_Timer5;
+		case QAD_ADC_Trigger_T5_CC3:
+			uChannel = TIM_CHANNEL_3;
+			return QAD_Timer5;
+		default:
+			uChannel = 0;
+			return QAD_TimerNone;
+	}
+}
+
+
+//QAD_ADC::imp_getClockPrescaler
+//QAD_ADC Tool Method
+//
+//Returns the HAL ADC clock prescaler for the selected clock divider
+uint32_t QAD_ADC::imp_getClockPrescaler(void) {
+	switch (m_uClockDivider) {
+		case 2:
+			return ADC_CLOCKPRESCALER_PCLK_DIV2;
+		case 6:
+			return ADC_CLOCKPRESCALER_PCLK_DIV6;
+		case 8:
+			return ADC_CLOCKPRESCALER_PCLK_DIV8;
 		default:
-			uTrigger = 0xFFFFFFFF;
+			return ADC_CLOCKPRESCALER_PCLK_DIV4;
 	}
-	return uTrigger;
+}
+
+
+//QAD_ADC::imp_getScanCycles
+//QAD_ADC Tool Method
+//
+//Returns the number of ADC clocks taken to convert a sequence of channels, with each conversion taking its sampling time
+//plus 12 clocks for 12bit successive approximation
+uint32_t QAD_ADC::imp_getScanCycles(const QAD_ADC_ChannelData* pChannels, uint8_t uChannels) {
+	static const uint16_t uSampleCycles[8] = {3, 15, 28, 56, 84, 112, 144, 480};
+
+	uint32_t uCycles = 0;
+	for (uint8_t i=0; i<uChannels; i++)
+		uCycles += uSampleCycles[pChannels[i].eSamplingTime & 0x07] + 12;
+	return uCycles;
+}
+
+
+//QAD_ADC::imp_checkRate
+//QAD_ADC Tool Method
+//
+//Checks that a sequence of channels can be converted within each period of the driver's trigger timer, so that impossible
+//rates are rejected rather than causing repeated overrun errors
+//Only checked in QAD_ADC_TimerMode_Internal mode with timer triggers, as otherwise the trigger rate is not known by the driver
+//Returns QA_OK if the sequence fits within the trigger period (or the rate is not known), otherwise QA_Fail
+QA_Result QAD_ADC::imp_checkRate(const QAD_ADC_ChannelData* pChannels, uint8_t uChannels) {
+	if ((m_eTimerMode != QAD_ADC_TimerMode_Internal) || (m_bContinuous) || (m_eTrigger == QAD_ADC_Trigger_EXTI11))
+		return QA_OK;
+
+	//Compare scan time against timer period, as (scan clocks / ADC clock) <= (timer clocks / timer clock)
+	uint64_t uScan  = (uint64_t)imp_getScanCycles(pChannels, uChannels) * QAD_TimerMgr::getClockSpeed(m_eTimer);
+	uint64_t uTimer = ((uint64_t)m_uTimer_Prescaler + 1) * ((uint64_t)m_uTimer_Period + 1) * (HAL_RCC_GetPCLK2Freq() / m_uClockDivider);
+	return (uScan <= uTimer) ? QA_OK : QA_Fail;
 }
 
 
@@ -405,30 +1318,260 @@ int8_t QAD_ADC::imp_findChannel(QAD_ADC_Channel eChannel) {
 //QAD_ADC::imp_findChannelPeriph
 //QAD_ADC Tool Method
 int8_t QAD_ADC::imp_findChannelPeriph(QAD_ADC_PeriphChannel eChannel) {
-	for (uint8_t i=0; i<m_uChannelCount; i++) {
-		if (m_sChannels[i].eChannel == eChannel)
+	return imp_findChannelList(m_sChannels, m_uChannelCount, eChannel);
+}
+
+
+//QAD_ADC::imp_findChannelList
+//QAD_ADC Tool Method
+//
+//Returns the index of a channel within a channel list, or -1 if not found
+int8_t QAD_ADC::imp_findChannelList(const QAD_ADC_ChannelData* pList, uint8_t uCount, QAD_ADC_PeriphChannel eChannel) {
+	for (uint8_t i=0; i<uCount; i++) {
+		if (pList[i].eChannel == eChannel)
 			return i;
 	}
 	return -1;
 }
 
 
+//QAD_ADC::imp_isInternal
+//QAD_ADC Tool Method
+//
+//Returns true if the channel is one of the internal channels (VREFINT, VBAT or temperature sensor), which have no GPIO pin
+bool QAD_ADC::imp_isInternal(QAD_ADC_PeriphChannel eChannel) {
+	return ((eChannel == QAD_ADC_PeriphChannelVRefInt) || (eChannel == QAD_ADC_PeriphChannelVBat) ||
+			    (eChannel == QAD_ADC_PeriphChannelTemp));
+}
+
+
+//QAD_ADC::imp_enableInternal
+//QAD_ADC Tool Method
+//
+//Sets the TSVREFE and VBATE bits in the ADC common control register to match the internal channels used by the regular and
+//injected groups, and waits for the temperature sensor to start up if it has just been enabled
+//Returns QA_Fail if both the Temp and VBat channels are in use, as they share ADC channel 18 on the STM32F411
+QA_Result QAD_ADC::imp_enableInternal(void) {
+	bool bVref = false;
+	bool bTemp = false;
+	bool bVbat = false;
+	for (uint8_t i=0; i<(m_uChannelCount + m_uInjectedCount); i++) {
+		QAD_ADC_PeriphChannel eChannel = (i < m_uChannelCount) ? m_sChannels[i].eChannel : m_sInjected[i-m_uChannelCount].eChannel;
+		bVref |= (eChannel == QAD_ADC_PeriphChannelVRefInt);
+		bTemp |= (eChannel == QAD_ADC_PeriphChannelTemp);
+		bVbat |= (eChannel == QAD_ADC_PeriphChannelVBat);
+	}
+
+	if (bTemp && bVbat)
+		return QA_Fail;
+
+	uint32_t uCCR = ADC->CCR & ~(uint32_t)(ADC_CCR_TSVREFE | ADC_CCR_VBATE);
+	if (bVref || bTemp)
+		uCCR |= ADC_CCR_TSVREFE;
+	if (bVbat)
+		uCCR |= ADC_CCR_VBATE;
+
+	//Temperature sensor startup time is 10us maximum
+	bool bStartup = (bTemp) && (!(ADC->CCR & ADC_CCR_TSVREFE));
+	ADC->CCR = uCCR;
+	if (bStartup)
+		imp_delay(10);
+
+	//Force calibration to be recalculated from the next VREFINT conversion
+	m_uCalVrefRaw = 0;
+
+	//Return
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_writeSequence
+//QAD_ADC Tool Method
+//
+//Writes the regular group sequence directly to the ADC's sequence registers (SQR1 to SQR3), including the sequence length,
+//and sets the sampling time fields (SMPR1 and SMPR2) of the channels in the sequence. Used by imp_reconfigure()
+void QAD_ADC::imp_writeSequence(void) {
+	uint32_t uSQR[3] = {0, 0, 0};
+	uint32_t uSMPR1  = m_sADCHandle.Instance->SMPR1;
+	uint32_t uSMPR2  = m_sADCHandle.Instance->SMPR2;
 
+	for (uint8_t i=0; i<m_uChannelCount; i++) {
+		uint32_t uChannel = (uint16_t)m_sChannels[i].eChannel;  //Removes the temperature sensor's channel 18 differentiation bit
+		uSQR[i / 6] |= uChannel << (5 * (i % 6));
 
+		if (uChannel >= 10) {
+			uSMPR1 = (uSMPR1 & ~(7UL << (3 * (uChannel - 10)))) | ((uint32_t)m_sChannels[i].eSamplingTime << (3 * (uChannel - 10)));
+		} else {
+			uSMPR2 = (uSMPR2 & ~(7UL << (3 * uChannel))) | ((uint32_t)m_sChannels[i].eSamplingTime << (3 * uChannel));
+		}
+	}
 
+	m_sADCHandle.Instance->SMPR1 = uSMPR1;
+	m_sADCHandle.Instance->SMPR2 = uSMPR2;
+	m_sADCHandle.Instance->SQR3  = uSQR[0];
+	m_sADCHandle.Instance->SQR2  = uSQR[1];
+	m_sADCHandle.Instance->SQR1  = uSQR[2] | ((uint32_t)(m_uChannelCount - 1) << ADC_SQR1_L_Pos);
+}
 
 
+//QAD_ADC::imp_delay
+//QAD_ADC Tool Method
+//
+//Busy waits for approximately the given number of microseconds, for ADC and temperature sensor startup times
+void QAD_ADC::imp_delay(uint32_t uMicros) {
+	for (volatile uint32_t i = uMicros * (SystemCoreClock / 1000000); i; i--) {}
+}
 
 
+//QAD_ADC::imp_startDMA
+//QAD_ADC Tool Method
+//
+//Starts the DMA stream and enables the ADC in DMA or block data modes. Conversions then start on the next trigger,
+//or immediately if in continuous mode
+void QAD_ADC::imp_startDMA(void) {
+	imp_startDMAStream();
+	m_sADCHandle.Instance->CR2 |= ADC_CR2_DMA;
+	HAL_ADC_Start(&m_sADCHandle);
+	__HAL_ADC_ENABLE_IT(&m_sADCHandle, ADC_IT_OVR);
+}
 
 
+//QAD_ADC::imp_recoverOverrun
+//QAD_ADC Tool Method
+//
+//Recovers from an overrun or DMA error in DMA or block data modes. The DMA stream is restarted from the start of the data array
+//(or first block buffer), and the ADC's DMA request is cleared and set again, so that the next trigger restarts the sequence from
+//the first rank. In block data mode the partially filled block is discarded and counted as dropped
+void QAD_ADC::imp_recoverOverrun(void) {
+	m_sADCHandle.Instance->CR2 &= ~ADC_CR2_DMA;
+	imp_stopDMAStream();
+	__HAL_ADC_CLEAR_FLAG(&m_sADCHandle, ADC_FLAG_OVR);
+
+	if (m_eDataMode == QAD_ADC_DataMode_Block) {
+		m_uBlockDrops++;
+		m_uBlockSequence++;
+		m_uBlockTime = QAT_Timestamp::get();
+	}
 
+	imp_startDMAStream();
+	m_sADCHandle.Instance->CR2 |= ADC_CR2_DMA;
 
+	//Conversions stop on overrun, so need to be restarted in continuous mode
+	if (m_bContinuous)
+		m_sADCHandle.Instance->CR2 |= ADC_CR2_SWSTART;
+}
 
 
+//QAD_ADC::imp_startDMAStream
+//QAD_ADC Tool Method
+//
+//Starts the DMA stream. In block data mode the stream is configured directly in double buffer mode, alternating between the
+//two block buffers, as HAL's multi-buffer functions require HAL callbacks which are not used by this driver
+void QAD_ADC::imp_startDMAStream(void) {
+	if (m_eDataMode != QAD_ADC_DataMode_Block) {
+		HAL_DMA_Start_IT(&m_sDMAHandle, (uint32_t)&m_sADCHandle.Instance->DR, (uint32_t)m_uData, m_uChannelCount);
+		return;
+	}
 
+	DMA_Stream_TypeDef* pStream = m_sDMAHandle.Instance;
+	DMA2->LIFCR   = (DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0);
+	pStream->PAR  = (uint32_t)&m_sADCHandle.Instance->DR;
+	pStream->M0AR = (uint32_t)m_pBlockBuffer[0];
+	pStream->M1AR = (uint32_t)m_pBlockBuffer[1];
+	pStream->NDTR = m_uBlockScans * m_uChannelCount;
+	pStream->CR   = (pStream->CR & ~(DMA_SxCR_CT | DMA_SxCR_HTIE)) | DMA_SxCR_DBM | DMA_SxCR_TCIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE;
+	pStream->CR  |= DMA_SxCR_EN;
+}
 
 
+//QAD_ADC::imp_stopDMAStream
+//QAD_ADC Tool Method
+//
+//Stops the DMA stream
+void QAD_ADC::imp_stopDMAStream(void) {
+	if (m_eDataMode != QAD_ADC_DataMode_Block) {
+		HAL_DMA_Abort(&m_sDMAHandle);
+		return;
+	}
 
+	DMA_Stream_TypeDef* pStream = m_sDMAHandle.Instance;
+	pStream->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE);
+	while (pStream->CR & DMA_SxCR_EN) {}
+	pStream->CR &= ~DMA_SxCR_DBM;
+	DMA2->LIFCR  = (DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0);
+}
 
 
+//QAD_ADC::imp_prepareBlocks
+//QAD_ADC Tool Method
+//
+//Selects the block buffers to be used for block data mode, allocating them if no buffers were supplied
+//Driver allocated buffers are only reallocated if they are too small for the current channel count
+//The block drop count is kept, so that drops are counted across reconfigurations
+//Returns QA_OK if successful, QA_Fail if the block size is invalid or the supplied buffers are too small, or QA_Error_PeriphBusy
+//if a block retrieved by getBlock() has not been released, as its buffer may be reallocated or refilled with a different layout
+QA_Result QAD_ADC::imp_prepareBlocks(void) {
+	if (m_bBlockHeld)
+		return QA_Error_PeriphBusy;
+
+	uint32_t uSize = m_uBlockScans * m_uChannelCount;
+	if ((!uSize) || (uSize > 0xFFFF))
+		return QA_Fail;
+
+	if ((m_pBlockUser[0]) && (m_pBlockUser[1])) {
+		if (uSize > m_uBlockUserSize)
+			return QA_Fail;
+		m_pBlockBuffer[0] = m_pBlockUser[0];
+		m_pBlockBuffer[1] = m_pBlockUser[1];
+	} else {
+		if (uSize > m_uBlockAllocSize) {
+			m_pBlockAlloc[0]  = std::make_unique<uint16_t[]>(uSize);
+			m_pBlockAlloc[1]  = std::make_unique<uint16_t[]>(uSize);
+			m_uBlockAllocSize = uSize;
+		}
+		m_pBlockBuffer[0] = m_pBlockAlloc[0].get();
+		m_pBlockBuffer[1] = m_pBlockAlloc[1].get();
+	}
+
+	m_bBlockPending  = false;
+	m_uBlockSequence = 0;
+	m_uBlockTime     = QAT_Timestamp::get();
+	return QA_OK;
+}
+
+
+//QAD_ADC::imp_completeBlock
+//QAD_ADC Tool Method
+//
+//Called from the DMA transfer complete interrupt in block data mode, when the DMA stream has switched to the other block buffer
+void QAD_ADC::imp_completeBlock(void) {
+	uint32_t uNow = QAT_Timestamp::get();
+
+	//The current target bit indicates the buffer now being filled, so the completed buffer is the other one
+	uint8_t uBuffer = (m_sDMAHandle.Instance->CR & DMA_SxCR_CT) ? 0 : 1;
+
+	//The DMA stream is now refilling the previous block's buffer, so if that block was not retrieved and released it is lost
+	if ((m_bBlockPending) || (m_bBlockHeld))
+		m_uBlockDrops++;
+
+	m_sBlock.pData      = m_pBlockBuffer[uBuffer];
+	m_sBlock.uScans     = m_uBlockScans;
+	m_sBlock.uChannels  = m_uChannelCount;
+	m_sBlock.uSequence  = m_uBlockSequence++;
+	m_sBlock.uTimestamp = m_uBlockTime;
+	m_uBlockTime        = uNow;
+
+	//Update latest data with the final scan of the block, so getData() can still be used
+	const uint16_t* pScan = m_sBlock.pData + ((m_uBlockScans - 1) * m_uChannelCount);
+	for (uint8_t i=0; i<m_uChannelCount; i++)
+		m_uData[i] = pScan[i];
+
+	//Pass block to callback, or make available to getBlock()
+	m_bBlockHeld = false;
+	if (m_pBlockCallback) {
+		m_bBlockPending = false;
+		m_pBlockCallback(m_sBlock, m_pBlockCallbackData);
+	} else {
+		m_bBlockPending = true;
+	}
+}
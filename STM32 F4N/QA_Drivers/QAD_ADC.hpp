@@ -23,6 +23,10 @@
 #include "setup.hpp"
 
 #include "QAD_TimerMgr.hpp"
+#include "QAD_DMAMgr.hpp"
+#include "QAT_Timestamp.hpp"
+
+#include <memory>
 
 
 	//------------------------------------------
@@ -54,6 +58,26 @@ enum QAD_ADC_Channel : uint8_t {
 //QAD_ADC_MAXCHANNELS
 #define QAD_ADC_MAXCHANNELS    16
 
+//QAD_ADC_MAXINJECTED
+#define QAD_ADC_MAXINJECTED    4
+
+
+//QAD_ADC_MAXCLOCK
+#define QAD_ADC_MAXCLOCK       36000000  //Maximum ADC clock in Hz (VDDA of 2.4V to 3.6V)
+
+
+//QAD_ADC_PLANMARGIN
+#define QAD_ADC_PLANMARGIN     90        //Percentage of the scan period that a scan's conversions may take, allowing for trigger
+                                         //latency and injected conversions
+
+
+//Factory calibration values, measured with VDDA = 3.3V
+#define QAD_ADC_VREFINT_CAL    (*((const uint16_t*)0x1FFF7A2A))  //Raw VREFINT conversion at 30 degrees C
+#define QAD_ADC_TS_CAL1        (*((const uint16_t*)0x1FFF7A2C))  //Raw temperature sensor conversion at 30 degrees C
+#define QAD_ADC_TS_CAL2        (*((const uint16_t*)0x1FFF7A2E))  //Raw temperature sensor conversion at 110 degrees C
+#define QAD_ADC_CAL_VDDA       3300                              //VDDA in millivolts at which calibration values were measured
+#define QAD_ADC_VBAT_DIVIDER   4                                 //VBAT is measured through an internal divide by 4 bridge on the STM32F411
+
 
 	//------------------------------------------
 	//------------------------------------------
@@ -82,8 +106,12 @@ enum QAD_ADC_PeriphChannel : uint32_t {
 	QAD_ADC_PeriphChannel17      = ADC_CHANNEL_17,
 	QAD_ADC_PeriphChannel18      = ADC_CHANNEL_18,
 	QAD_ADC_PeriphChannelVRefInt = ADC_CHANNEL_VREFINT,
-	QAD_ADC_PeriphChannelVBat    = ADC_CHANNEL_VBAT
+	QAD_ADC_PeriphChannelVBat    = ADC_CHANNEL_VBAT,
+	QAD_ADC_PeriphChannelTemp    = ADC_CHANNEL_TEMPSENSOR
 };
+//NOTE: The temperature sensor shares ADC channel 18 with VBAT on the STM32F411, so QAD_ADC_PeriphChannelTemp and
+//QAD_ADC_PeriphChannelVBat cannot be used at the same time. The temperature sensor requires a sampling time of at least 10us
+//(QAD_ADC_PeriphSamplingTime_480Cycles)
 
 
 //QAD_ADC_SamplingTime
@@ -99,6 +127,110 @@ enum QAD_ADC_SamplingTime : uint32_t {
 };
 
 
+//QAD_ADC_TimerMode
+//
+//Selects whether the trigger timer is owned and configured by the ADC driver, or is owned by another driver
+//(such as QAD_PWM with its trigger output enabled) which is responsible for generating the trigger output (TRGO)
+enum QAD_ADC_TimerMode : uint8_t {
+	QAD_ADC_TimerMode_Internal = 0,
+	QAD_ADC_TimerMode_External
+};
+
+
+//QAD_ADC_Trigger
+//
+//Trigger source for the regular group
+//QAD_ADC_Trigger_TRGO uses the update event (TRGO) of eTimer, which must be TIM2 or TIM3
+//Compare event triggers (CCx) require eTimer to be the trigger's timer. In QAD_ADC_TimerMode_Internal mode the driver configures
+//the timer channel in PWM mode so that one compare event occurs per timer period. In QAD_ADC_TimerMode_External mode the
+//owning driver must configure the channel in output compare or PWM mode
+//QAD_ADC_Trigger_EXTI11 triggers from EXTI line 11, which must be configured separately (such as with QAD_EXTI). No timer is used
+enum QAD_ADC_Trigger : uint8_t {
+	QAD_ADC_Trigger_TRGO = 0,
+	QAD_ADC_Trigger_T1_CC1,
+	QAD_ADC_Trigger_T1_CC2,
+	QAD_ADC_Trigger_T1_CC3,
+	QAD_ADC_Trigger_T2_CC2,
+	QAD_ADC_Trigger_T2_CC3,
+	QAD_ADC_Trigger_T2_CC4,
+	QAD_ADC_Trigger_T3_CC1,
+	QAD_ADC_Trigger_T4_CC4,
+	QAD_ADC_Trigger_T5_CC1,
+	QAD_ADC_Trigger_T5_CC2,
+	QAD_ADC_Trigger_T5_CC3,
+	QAD_ADC_Trigger_EXTI11
+};
+
+
+//QAD_ADC_DataMode
+//
+//Selects how conversion results are transferred from the ADC into the driver's data array
+enum QAD_ADC_DataMode : uint8_t {
+	QAD_ADC_DataMode_Interrupt = 0, //An interrupt is triggered for each conversion, with the result read by handler()
+	QAD_ADC_DataMode_DMA,           //DMA2 Stream0 transfers each conversion directly into the data array in circular mode,
+	                                //with a single interrupt at the end of each scan. handlerDMA() must be called from DMA2_Stream0_IRQHandler
+	QAD_ADC_DataMode_Block          //DMA2 Stream0 fills two block buffers of a set number of scans each in double buffer mode. Each completed
+	                                //block is passed to a callback or made available to getBlock() while the other buffer fills
+	                                //handlerDMA() must be called from DMA2_Stream0_IRQHandler
+};
+
+
+//-------------
+//QAD_ADC_Block
+//
+//Describes a completed block of scans in QAD_ADC_DataMode_Block data mode
+//Samples are interleaved by scan, so sample for channel c of scan s is pData[(s * uChannels) + c]
+typedef struct {
+
+	const uint16_t* pData;       //Pointer to the block's samples
+	uint32_t        uScans;      //Number of scans in the block
+	uint8_t         uChannels;   //Number of channels in each scan
+	uint32_t        uSequence;   //Sequence number of the block, incremented for every block completed including dropped blocks
+	uint32_t        uTimestamp;  //Timestamp (QAT_Timestamp) of the start of the block
+
+} QAD_ADC_Block;
+
+
+//---------------------
+//QAD_ADC_BlockCallback
+//
+//Function to be called from the DMA interrupt when a block completes in QAD_ADC_DataMode_Block data mode
+//The block's buffer is only valid until the function returns, and the function must return within one block period
+typedef void (*QAD_ADC_BlockCallback)(const QAD_ADC_Block& sBlock, void* pData);
+
+
+//QAD_ADC_InjectedTrigger
+//
+//Trigger source for the injected group. An injected conversion preempts any ongoing regular conversion, with the regular
+//sequence resuming once the injected group completes. Compare event triggers (CCx) require the timer's channel to be
+//configured in output compare or PWM mode, with the compare value setting the sampling point within the timer period
+enum QAD_ADC_InjectedTrigger : uint32_t {
+	QAD_ADC_InjectedTrigger_T1_CC4   = ADC_EXTERNALTRIGINJECCONV_T1_CC4,
+	QAD_ADC_InjectedTrigger_T1_TRGO  = ADC_EXTERNALTRIGINJECCONV_T1_TRGO,
+	QAD_ADC_InjectedTrigger_T2_CC1   = ADC_EXTERNALTRIGINJECCONV_T2_CC1,
+	QAD_ADC_InjectedTrigger_T2_TRGO  = ADC_EXTERNALTRIGINJECCONV_T2_TRGO,
+	QAD_ADC_InjectedTrigger_T3_CC2   = ADC_EXTERNALTRIGINJECCONV_T3_CC2,
+	QAD_ADC_InjectedTrigger_T3_CC4   = ADC_EXTERNALTRIGINJECCONV_T3_CC4,
+	QAD_ADC_InjectedTrigger_T4_CC1   = ADC_EXTERNALTRIGINJECCONV_T4_CC1,
+	QAD_ADC_InjectedTrigger_T4_CC2   = ADC_EXTERNALTRIGINJECCONV_T4_CC2,
+	QAD_ADC_InjectedTrigger_T4_CC3   = ADC_EXTERNALTRIGINJECCONV_T4_CC3,
+	QAD_ADC_InjectedTrigger_T4_TRGO  = ADC_EXTERNALTRIGINJECCONV_T4_TRGO,
+	QAD_ADC_InjectedTrigger_T5_CC4   = ADC_EXTERNALTRIGINJECCONV_T5_CC4,
+	QAD_ADC_InjectedTrigger_T5_TRGO  = ADC_EXTERNALTRIGINJECCONV_T5_TRGO,
+	QAD_ADC_InjectedTrigger_EXTI15   = ADC_EXTERNALTRIGINJECCONV_EXT_IT15
+};
+
+
+//QAD_ADC_WatchdogMode
+//
+//Selects which channels are monitored by the analog watchdog. The watchdog monitors both the regular and injected groups
+enum QAD_ADC_WatchdogMode : uint8_t {
+	QAD_ADC_WatchdogMode_Disabled = 0,
+	QAD_ADC_WatchdogMode_Single,     //A single channel is monitored
+	QAD_ADC_WatchdogMode_All         //All channels are monitored
+};
+
+
 	//------------------------------------------
 	//------------------------------------------
 	//------------------------------------------
@@ -108,8 +240,24 @@ enum QAD_ADC_SamplingTime : uint32_t {
 typedef struct {
 
 	QAD_Timer_Periph  eTimer;
-	uint32_t          uTimer_Prescaler;
-	uint32_t          uTimer_Period;
+	uint32_t          uTimer_Prescaler;  //Unused in QAD_ADC_TimerMode_External mode
+	uint32_t          uTimer_Period;     //Unused in QAD_ADC_TimerMode_External mode
+
+	QAD_ADC_TimerMode eTimerMode;
+	QAD_ADC_Trigger   eTrigger;          //Regular group trigger source. Member of QAD_ADC_Trigger enum
+	QAD_ADC_DataMode  eDataMode;
+
+	uint8_t           uClockDivider;     //ADC clock divider from the APB2 clock (2, 4, 6 or 8), or 0 for the default of 4
+	                                     //The ADC clock must not exceed QAD_ADC_MAXCLOCK
+
+	bool              bContinuous;       //Set to true for the ADC to convert continuously at its maximum rate rather than on each timer trigger
+	                                     //Intended for use with QAD_ADC_DataMode_Block data mode
+
+	uint32_t          uBlockScans;       //Number of scans per block in QAD_ADC_DataMode_Block data mode. Scans multiplied by channel count
+	                                     //must not exceed 65535
+	uint16_t*         pBlockBuffer0;     //First block buffer, or NULL for buffers to be allocated by the driver when started
+	uint16_t*         pBlockBuffer1;     //Second block buffer, or NULL for buffers to be allocated by the driver when started
+	uint32_t          uBlockBufferSize;  //Size of each supplied block buffer in samples. Unused if buffers are allocated by the driver
 
 } QAD_ADC_InitStruct;
 
@@ -123,7 +271,7 @@ typedef struct {
 //QAD_ADC_Channel
 typedef struct QAD_ADC_ChannelData {
 
-	GPIO_TypeDef*    pGPIO;
+	GPIO_TypeDef*    pGPIO;   //Unused for internal channels (VRefInt, VBat and Temp)
 	uint16_t         uPin;
 
 	QAD_ADC_PeriphChannel eChannel;
@@ -160,27 +308,120 @@ private:
 	QA_ActiveState          m_eState;
 
 	QAD_Timer_Periph        m_eTimer;
+	QAD_ADC_TimerMode       m_eTimerMode;
 	uint32_t                m_uTimer_Prescaler;
 	uint32_t                m_uTimer_Period;
+	QAD_ADC_Trigger         m_eTrigger;
+	uint8_t                 m_uClockDivider;
 
 	TIM_HandleTypeDef       m_sTIMHandle;
 	ADC_HandleTypeDef       m_sADCHandle;
 
+	QAD_ADC_DataMode        m_eDataMode;
+	DMA_HandleTypeDef       m_sDMAHandle;
+
+	QAD_IRQHandler_CallbackFunction m_pScanCallback;      //Function to be called at the end of each scan, or NULL
+	void*                           m_pScanCallbackData;  //Data to be passed to m_pScanCallback
+	uint32_t                        m_uOverrunCount;      //Number of overrun errors that have occurred
+
+	bool                            m_bContinuous;        //Set to true if ADC converts continuously rather than on each timer trigger
+
+	uint32_t                        m_uBlockScans;        //Number of scans per block
+	uint16_t*                       m_pBlockUser[2];      //User supplied block buffers, or NULL
+	uint32_t                        m_uBlockUserSize;     //Size of user supplied block buffers in samples
+	std::unique_ptr<uint16_t[]>     m_pBlockAlloc[2];     //Driver allocated block buffers
+	uint32_t                        m_uBlockAllocSize;    //Size of driver allocated block buffers in samples
+	uint16_t*                       m_pBlockBuffer[2];    //Block buffers currently in use
+
+	QAD_ADC_BlockCallback           m_pBlockCallback;     //Function to be called when a block completes, or NULL to use getBlock()
+	void*                           m_pBlockCallbackData; //Data to be passed to m_pBlockCallback
+	QAD_ADC_Block                   m_sBlock;             //Most recently completed block
+	volatile bool                   m_bBlockPending;      //Set to true when a completed block has not yet been retrieved by getBlock()
+	volatile bool                   m_bBlockHeld;         //Set to true while a block retrieved by getBlock() has not yet been released
+	uint32_t                        m_uBlockSequence;     //Sequence number for next completed block
+	uint32_t                        m_uBlockTime;         //Timestamp of start of block currently being filled
+	volatile uint32_t               m_uBlockDrops;        //Number of blocks dropped or overwritten before being released
+
 	QAD_ADC_ChannelData     m_sChannels[QAD_ADC_MAXCHANNELS];
 	uint8_t                 m_uChannelCount;
 
-	uint16_t                m_uData[QAD_ADC_MAXCHANNELS];
+	QAD_ADC_ChannelData     m_sStaged[QAD_ADC_MAXCHANNELS];  //Staged channel list, applied to m_sChannels when a transaction is committed
+	uint8_t                 m_uStagedCount;
+	bool                    m_bTransaction;                  //Set to true while a channel transaction is open
+
+	volatile uint16_t       m_uData[QAD_ADC_MAXCHANNELS];
 	uint8_t                 m_uDataIdx;
 
+	QAD_ADC_ChannelData     m_sInjected[QAD_ADC_MAXINJECTED];
+	uint8_t                 m_uInjectedCount;
+	QAD_ADC_InjectedTrigger m_eInjectedTrigger;
+	volatile uint16_t       m_uInjectedData[QAD_ADC_MAXINJECTED];
+
+	QAD_IRQHandler_CallbackFunction m_pInjectedCallback;      //Function to be called when the injected group completes, or NULL
+	void*                           m_pInjectedCallbackData;  //Data to be passed to m_pInjectedCallback
+
+	QAD_ADC_WatchdogMode            m_eWatchdogMode;          //Analog watchdog mode
+	QAD_ADC_PeriphChannel           m_eWatchdogChannel;       //Channel monitored in QAD_ADC_WatchdogMode_Single mode
+	uint16_t                        m_uWatchdogLow;           //Analog watchdog low threshold (raw)
+	uint16_t                        m_uWatchdogHigh;          //Analog watchdog high threshold (raw)
+	QAD_IRQHandler_CallbackFunction m_pWatchdogCallback;      //Function to be called when the analog watchdog triggers, or NULL
+	void*                           m_pWatchdogCallbackData;  //Data to be passed to m_pWatchdogCallback
+	volatile uint32_t               m_uWatchdogCount;         //Number of times the analog watchdog has triggered
+
+	uint16_t                m_uCalVrefRaw;     //VREFINT conversion from which calibration scales were last calculated
+	uint16_t                m_uCalVdda;        //Calculated VDDA in millivolts
+	uint32_t                m_uCalScale;       //Raw to millivolt scale (Q16)
+	uint32_t                m_uCalTSScale;     //Raw to calibration referenced (3.3V) raw scale, used for temperature sensor (Q16)
+
 
 	//-----------
 	//Constructor
 	QAD_ADC() :
 		m_eInitState(QA_NotInitialized),
 		m_eState(QA_Inactive),
+		m_eTimerMode(QAD_ADC_TimerMode_Internal),
+		m_eTrigger(QAD_ADC_Trigger_TRGO),
+		m_uClockDivider(4),
 		m_sTIMHandle({0}),
 		m_sADCHandle({0}),
-		m_uChannelCount(0) {}
+		m_eDataMode(QAD_ADC_DataMode_Interrupt),
+		m_sDMAHandle({0}),
+		m_pScanCallback(NULL),
+		m_pScanCallbackData(NULL),
+		m_uOverrunCount(0),
+		m_bContinuous(false),
+		m_uBlockScans(0),
+		m_pBlockUser{NULL, NULL},
+		m_uBlockUserSize(0),
+		m_uBlockAllocSize(0),
+		m_pBlockBuffer{NULL, NULL},
+		m_pBlockCallback(NULL),
+		m_pBlockCallbackData(NULL),
+		m_sBlock({0}),
+		m_bBlockPending(false),
+		m_bBlockHeld(false),
+		m_uBlockSequence(0),
+		m_uBlockTime(0),
+		m_uBlockDrops(0),
+		m_uChannelCount(0),
+		m_uStagedCount(0),
+		m_bTransaction(false),
+		m_uInjectedCount(0),
+		m_eInjectedTrigger(QAD_ADC_InjectedTrigger_T1_CC4),
+		m_uInjectedData{0, 0, 0, 0},
+		m_pInjectedCallback(NULL),
+		m_pInjectedCallbackData(NULL),
+		m_eWatchdogMode(QAD_ADC_WatchdogMode_Disabled),
+		m_eWatchdogChannel(QAD_ADC_PeriphChannel0),
+		m_uWatchdogLow(0),
+		m_uWatchdogHigh(4095),
+		m_pWatchdogCallback(NULL),
+		m_pWatchdogCallbackData(NULL),
+		m_uWatchdogCount(0),
+		m_uCalVrefRaw(0),
+		m_uCalVdda(QAD_ADC_CAL_VDDA),
+		m_uCalScale(((uint32_t)QAD_ADC_CAL_VDDA << 16) / 4095),
+		m_uCalTSScale(1 << 16) {}
 
 public:
 
@@ -210,6 +451,20 @@ public:
 		get().imp_deinit();
 	}
 
+	//Plans the ADC clock divider, channel sampling times and trigger timer settings for a target scan rate, filling the
+	//uClockDivider, uTimer_Prescaler and uTimer_Period fields of sInit. To be called before init()
+	//sInit           - Initialization structure, with eTimer, eTimerMode, eTrigger and bContinuous already set
+	//uScanRate       - Target rate in Hz at which all channels are to be converted
+	//pChannels       - Channels to be converted, with their minimum sampling times
+	//uChannels       - Number of channels
+	//bExtendSampling - Set to true to increase sampling times to the longest that still fit the scan period, improving accuracy
+	//                  for high impedance sources
+	//Returns QA_OK if successful, or QA_Fail if the channels' conversion time cannot meet the scan rate
+	static QA_Result plan(QAD_ADC_InitStruct& sInit, uint32_t uScanRate, QAD_ADC_ChannelData* pChannels, uint8_t uChannels,
+			                  bool bExtendSampling) {
+		return get().imp_plan(sInit, uScanRate, pChannels, uChannels, bExtendSampling);
+	}
+
 
 	  //--------------
 	  //Handler Method
@@ -218,6 +473,10 @@ public:
 		get().imp_handler();
 	}
 
+	static void handlerDMA(void) {
+		get().imp_handlerDMA();
+	}
+
 
 	  //---------------
 	  //Control Methods
@@ -246,6 +505,149 @@ public:
   	return get().m_uChannelCount;
   }
 
+  //Opens a channel transaction. Channels added or removed while the transaction is open are staged, and are applied together
+  //when commitTransaction() is called. Without a transaction, each addChannel() and removeChannel() call is applied immediately
+  static void beginTransaction(void) {
+  	get().imp_beginTransaction();
+  }
+
+  //Applies the staged channel changes. If the ADC is running the new sequence is written directly to the ADC's sequence and
+  //sampling time registers, without deinitializing the ADC, so conversions only pause for a few microseconds
+  //In block data mode, returns QA_Error_PeriphBusy while a block retrieved by getBlock() is held, leaving the transaction open
+  static QA_Result commitTransaction(void) {
+  	return get().imp_commitTransaction();
+  }
+
+  //Discards the staged channel changes
+  static void cancelTransaction(void) {
+  	get().m_bTransaction = false;
+  }
+
+  //Sets a function to be called at the end of each scan of all channels, from the ADC (interrupt data mode)
+  //or DMA (DMA data mode) interrupt. Set pCallback to NULL to disable
+  static void setScanCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+  	get().imp_setScanCallback(pCallback, pData);
+  }
+
+  static uint32_t getOverrunCount(void) {
+  	return get().m_uOverrunCount;
+  }
+
+
+		//----------------------
+		//Injected Group Methods
+
+  //Adds a channel to the injected group. Up to QAD_ADC_MAXINJECTED channels are supported, with results read by
+  //getInjectedData() in the order in which channels were added
+  static QA_Result addInjectedChannel(QAD_ADC_ChannelData& sChannel) {
+  	return get().imp_addInjectedChannel(sChannel);
+  }
+
+  static void removeInjectedChannel(uint8_t uChannel) {
+  	get().imp_removeInjectedChannel(uChannel);
+  }
+
+  static uint8_t getInjectedCount(void) {
+  	return get().m_uInjectedCount;
+  }
+
+  //Sets the injected group trigger. Takes effect the next time the ADC is started
+  static void setInjectedTrigger(QAD_ADC_InjectedTrigger eTrigger) {
+  	get().m_eInjectedTrigger = eTrigger;
+  }
+
+  //Sets a function to be called from the ADC interrupt when the injected group completes. Set pCallback to NULL to disable
+  static void setInjectedCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+  	get().imp_setInjectedCallback(pCallback, pData);
+  }
+
+  static uint16_t getInjectedData(uint8_t uChannel) {
+  	return (uChannel < QAD_ADC_MAXINJECTED) ? get().m_uInjectedData[uChannel] : 0;
+  }
+
+
+		//-----------------------
+		//Analog Watchdog Methods
+
+  //Configures the analog watchdog, which triggers when a conversion result is above uHigh or below uLow
+  //The watchdog is one-shot: its interrupt is disabled once it triggers, and rearmWatchdog() must be called to enable it again
+  //This prevents an interrupt on every conversion while a channel remains outside of its thresholds
+  //eMode    - Member of QAD_ADC_WatchdogMode enum
+  //eChannel - Channel to be monitored in QAD_ADC_WatchdogMode_Single mode
+  //uLow     - Low threshold (raw 12bit value)
+  //uHigh    - High threshold (raw 12bit value)
+  static QA_Result setWatchdog(QAD_ADC_WatchdogMode eMode, QAD_ADC_PeriphChannel eChannel, uint16_t uLow, uint16_t uHigh) {
+  	return get().imp_setWatchdog(eMode, eChannel, uLow, uHigh);
+  }
+
+  //As setWatchdog(), with thresholds in millivolts. Thresholds are converted to raw values using the VDDA measured at the
+  //time of the call (see getVdda()), so should be set again if VDDA changes significantly
+  static QA_Result setWatchdogMillivolts(QAD_ADC_WatchdogMode eMode, QAD_ADC_PeriphChannel eChannel, uint16_t uLow, uint16_t uHigh) {
+  	return get().imp_setWatchdogMillivolts(eMode, eChannel, uLow, uHigh);
+  }
+
+  static void disableWatchdog(void) {
+  	get().imp_setWatchdog(QAD_ADC_WatchdogMode_Disabled, QAD_ADC_PeriphChannel0, 0, 4095);
+  }
+
+  static void rearmWatchdog(void) {
+  	get().imp_rearmWatchdog();
+  }
+
+  //Sets a function to be called from the ADC interrupt when the analog watchdog triggers. Set pCallback to NULL to disable
+  static void setWatchdogCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+  	get().imp_setWatchdogCallback(pCallback, pData);
+  }
+
+  static uint32_t getWatchdogCount(void) {
+  	return get().m_uWatchdogCount;
+  }
+
+
+		//-------------------
+		//Calibrated Methods
+
+  //Converts a raw conversion result to millivolts, using VDDA measured from VREFINT if the VRefInt channel is in use
+  static uint16_t getMillivolts(uint16_t uRaw) {
+  	return get().imp_getMillivolts(uRaw);
+  }
+
+  static uint16_t getVdda(void) {
+  	return get().imp_getVdda();
+  }
+
+  //Sets iTemp to the die temperature in hundredths of a degree C. Returns QA_Fail, leaving iTemp unchanged, if the Temp channel is not in use
+  static QA_Result getTemperature(int32_t& iTemp) {
+  	return get().imp_getTemperature(iTemp);
+  }
+
+  //Sets uVbat to the backup battery voltage in millivolts. Returns QA_Fail, leaving uVbat unchanged, if the VBat channel is not in use
+  static QA_Result getVbat(uint16_t& uVbat) {
+  	return get().imp_getVbat(uVbat);
+  }
+
+
+		//-------------
+		//Block Methods
+
+  //Sets a function to be called when each block completes in QAD_ADC_DataMode_Block data mode. Set pCallback to NULL to use getBlock()
+  static void setBlockCallback(QAD_ADC_BlockCallback pCallback, void* pData) {
+  	get().imp_setBlockCallback(pCallback, pData);
+  }
+
+  static QA_Result getBlock(QAD_ADC_Block& sBlock) {
+  	return get().imp_getBlock(sBlock);
+  }
+
+  static void releaseBlock(void) {
+  	get().m_bBlockHeld = false;
+  }
+
+  //Returns the number of blocks dropped since the driver was created. The count is kept across reconfigurations and restarts
+  static uint32_t getBlockDrops(void) {
+  	return get().m_uBlockDrops;
+  }
+
 		//------------
 		//Data Methods
 
@@ -268,12 +670,16 @@ private:
 
 	QA_Result imp_init(QAD_ADC_InitStruct& sInit);
 	void imp_deinit(void);
+	QA_Result imp_plan(QAD_ADC_InitStruct& sInit, uint32_t uScanRate, QAD_ADC_ChannelData* pChannels, uint8_t uChannels,
+			               bool bExtendSampling);
 
 
 		//---------------------------------
 		//Peripheral Initialization Methods
 
 	QA_Result imp_periphInit(QAD_ADC_InitStruct& sInit);
+	QA_Result imp_periphInitADC(void);
+	QA_Result imp_periphInitDMA(void);
 	void imp_periphDeinit(DeinitMode eMode);
 
 
@@ -281,6 +687,7 @@ private:
 		//Handler Methods
 
 	void imp_handler(void);
+	void imp_handlerDMA(void);
 
 
 		//---------------
@@ -293,6 +700,49 @@ private:
 	void imp_removeChannel(QAD_ADC_Channel eChannel);
 	void imp_removeChannelPeriph(QAD_ADC_PeriphChannel eChannel);
 
+	void imp_beginTransaction(void);
+	QA_Result imp_commitTransaction(void);
+	QA_Result imp_reconfigure(void);
+
+	void imp_setScanCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData);
+
+
+		//----------------------
+		//Injected Group Methods
+
+	QA_Result imp_addInjectedChannel(QAD_ADC_ChannelData& sChannel);
+	void imp_removeInjectedChannel(uint8_t uChannel);
+	void imp_setInjectedCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData);
+	QA_Result imp_startInjected(void);
+
+
+		//-----------------------
+		//Analog Watchdog Methods
+
+	QA_Result imp_setWatchdog(QAD_ADC_WatchdogMode eMode, QAD_ADC_PeriphChannel eChannel, uint16_t uLow, uint16_t uHigh);
+	QA_Result imp_setWatchdogMillivolts(QAD_ADC_WatchdogMode eMode, QAD_ADC_PeriphChannel eChannel, uint16_t uLow, uint16_t uHigh);
+	void imp_rearmWatchdog(void);
+	void imp_setWatchdogCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData);
+	void imp_applyWatchdog(void);
+
+
+		//------------------
+		//Calibrated Methods
+
+	uint16_t imp_getMillivolts(uint16_t uRaw);
+	uint16_t imp_getVdda(void);
+	QA_Result imp_getTemperature(int32_t& iTemp);
+	QA_Result imp_getVbat(uint16_t& uVbat);
+	QA_Result imp_getInternalData(QAD_ADC_PeriphChannel eChannel, uint16_t& uData);
+	void imp_refreshCalibration(void);
+
+
+		//-------------
+		//Block Methods
+
+	void imp_setBlockCallback(QAD_ADC_BlockCallback pCallback, void* pData);
+	QA_Result imp_getBlock(QAD_ADC_Block& sBlock);
+
 
 		//------------
 		//Data Methods
@@ -305,8 +755,23 @@ private:
 		//Tool Methods
 
 	uint32_t imp_getTrigger(void);
+	QAD_Timer_Periph imp_getTriggerTimer(QAD_ADC_Trigger eTrigger, uint32_t& uChannel);
+	uint32_t imp_getClockPrescaler(void);
+	uint32_t imp_getScanCycles(const QAD_ADC_ChannelData* pChannels, uint8_t uChannels);
+	QA_Result imp_checkRate(const QAD_ADC_ChannelData* pChannels, uint8_t uChannels);
+	void imp_startDMA(void);
+	void imp_startDMAStream(void);
+	void imp_stopDMAStream(void);
+	void imp_recoverOverrun(void);
+	QA_Result imp_prepareBlocks(void);
+	void imp_completeBlock(void);
 	int8_t imp_findChannel(QAD_ADC_Channel eChannel);
 	int8_t imp_findChannelPeriph(QAD_ADC_PeriphChannel eChannel);
+	int8_t imp_findChannelList(const QAD_ADC_ChannelData* pList, uint8_t uCount, QAD_ADC_PeriphChannel eChannel);
+	bool imp_isInternal(QAD_ADC_PeriphChannel eChannel);
+	QA_Result imp_enableInternal(void);
+	void imp_writeSequence(void);
+	void imp_delay(uint32_t uMicros);
 
 
 };
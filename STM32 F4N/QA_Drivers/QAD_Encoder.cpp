@@ -47,6 +47,11 @@ QA_Result QAD_Encoder::init(void) {
   //Register Timer peripheral as now being in use
   QAD_TimerMgr::registerTimer(m_eTimer, QAD_Timer_InUse_Encoder);
 
+  //Convert zero velocity timeout to timestamp ticks, limited to half of the timestamp wrap period
+  //This is done here rather than in the constructor, as the system clock may not yet be configured when a global driver is constructed
+  uint64_t uTimeout = ((uint64_t)m_uVelTimeoutMs * QAT_Timestamp::getFrequency()) / 1000;
+  m_uVelTimeout = ((uTimeout == 0) || (uTimeout > 0x7FFFFFFF)) ? 0x7FFFFFFF : (uint32_t)uTimeout;
+
   //Initialize the Timer peripheral
   QA_Result eRes = periphInit();
 
@@ -77,6 +82,61 @@ void QAD_Encoder::deinit(void) {
 }
 
 
+  //-------------------------------
+  //-------------------------------
+  //QAD_Encoder IRQ Handler Methods
+
+//QAD_Encoder::handler
+//QAD_Encoder IRQ Handler Method
+//
+//To be called from the timer peripheral's update IRQ handler (and capture/compare IRQ handler for TIM1)
+//Adds any counter overflow or underflow to the accumulated position, records the position and timestamp of captured edges
+//used by the M/T velocity method, and processes index edges
+void QAD_Encoder::handler(void) {
+	TIM_TypeDef* pTIM = m_sHandle.Instance;
+	uint32_t     uSR  = pTIM->SR & pTIM->DIER;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+
+	//Process counter overflow/underflow
+	checkOverflow();
+
+	//Process captured edge
+	if (uSR & TIM_SR_CC1IF) {
+		uint32_t uTime    = QAT_Timestamp::get();
+		uint32_t uCapture = pTIM->CCR1;             //Reading the capture register also clears the capture flag
+		pTIM->SR = ~(uint32_t)TIM_SR_CC1OF;
+
+		int64_t iEdgePos = readCapture(uCapture);
+
+		//If the speed since the previous edge is above the threshold then switch to the M method here, rather than waiting for
+		//update(), so that a fast encoder cannot flood the CPU with capture interrupts
+		if (m_uVelThreshold) {
+			uint64_t uCounts = (uint64_t)((iEdgePos < m_iEdgePos) ? (m_iEdgePos - iEdgePos) : (iEdgePos - m_iEdgePos));
+			if ((uCounts * QAT_Timestamp::getFrequency()) > ((uint64_t)m_uVelThreshold * (uTime - m_uEdgeTime))) {
+				pTIM->DIER &= ~(uint32_t)TIM_DIER_CC1IE;
+				m_bVelEdge = false;
+			}
+		}
+
+		m_iEdgePos  = iEdgePos;
+		m_uEdgeTime = uTime;
+		m_uEdgeCount++;
+	}
+
+	//Process index edge
+	if (uSR & TIM_SR_CC3IF) {
+		uint32_t uCapture = pTIM->CCR3;             //Reading the capture register also clears the capture flag
+		pTIM->SR = ~(uint32_t)TIM_SR_CC3OF;
+
+		processIndex(readCapture(uCapture));
+	}
+
+	__set_PRIMASK(uPRIMASK);
+}
+
+
   //---------------------------
   //---------------------------
   //QAD_Encoder Control Methods
@@ -90,8 +150,23 @@ void QAD_Encoder::start(void) {
 	//Check encoder driver is initialized and is not currently active
   if ((m_eInitState) && (!m_eState)) {
 
-  	//Clear encoder/counter data
+  	//Clear encoder/counter and velocity data
   	clearData();
+  	clearVelocity();
+
+  	//Clear any pending update flag and enable the update interrupt used for overflow tracking
+  	m_sHandle.Instance->SR = ~(uint32_t)TIM_SR_UIF;
+  	__HAL_TIM_ENABLE_IT(&m_sHandle, TIM_IT_UPDATE);
+
+  	//Start in M/T velocity method if enabled
+  	setEdgeCapture(m_uVelThreshold != 0);
+
+  	//Enable index capture and interrupt
+  	if (m_pIdx_GPIO) {
+  		m_sHandle.Instance->SR = ~(uint32_t)(TIM_SR_CC3IF | TIM_SR_CC3OF);
+  		m_sHandle.Instance->CCER |= TIM_CCER_CC3E;
+  		__HAL_TIM_ENABLE_IT(&m_sHandle, TIM_IT_CC3);
+  	}
 
   	//Start Timer peripheral in encoder mode
   	HAL_TIM_Encoder_Start(&m_sHandle, TIM_CHANNEL_ALL);
@@ -114,6 +189,14 @@ void QAD_Encoder::stop(void) {
   	//Stop Timer peripheral
   	HAL_TIM_Encoder_Stop(&m_sHandle, TIM_CHANNEL_ALL);
 
+  	//Disable the update and capture interrupts
+  	__HAL_TIM_DISABLE_IT(&m_sHandle, TIM_IT_UPDATE);
+  	setEdgeCapture(false);
+
+  	//Disable index capture and interrupt
+  	__HAL_TIM_DISABLE_IT(&m_sHandle, TIM_IT_CC3);
+  	m_sHandle.Instance->CCER &= ~TIM_CCER_CC3E;
+
   	//Set driver state to inactive
   	m_eState = QA_Inactive;
   }
@@ -123,37 +206,35 @@ void QAD_Encoder::stop(void) {
 //QAD_Encoder::update
 //QAD_Encoder Control Method
 //
-//This method is used to update the encoder/counter data and should be called at a regular rate
-//This method needs to be called prior to calling the getValue() method in order for getValue() to return
-//the most recent encoder value.
+//This method is used to update the encoder velocity returned by getVelocity() and the acceleration value returned by getAccel(),
+//and if used should be called at a regular rate
+//Calling this method is optional, as the position is tracked by the timer's update interrupt, and so getPosition() and getValue()
+//do not depend on it
 //
 //uTicks - The time (in milliseconds) that has passed since this method was last called
-//         This is used to be able to calculate the encoder acceleration value
+//         This is used to be able to calculate the encoder acceleration value. If 0 the acceleration value is left unchanged
 void QAD_Encoder::update(uint32_t uTicks) {
 
 	//Check that encoder driver is active
 	if (m_eState) {
 
-		m_uValueOld = m_uValueNew;                        //Store previous current value into old value
-		m_uValueNew = __HAL_TIM_GET_COUNTER(&m_sHandle);  //Update current value from Timer's counter register
-
-		//The following code is used to determine if the encoder has been moved in a clockwise or counter-clockwise rotation,
-		//while also taking into account whether the counter register value has wrapped around
-		uint16_t uDiffA;
-		uint16_t uDiffB;
-		bool bValComp = (m_uValueNew < m_uValueOld);
-		if (bValComp) {
-			uDiffA = m_uValueOld - m_uValueNew;
-			uDiffB = m_uValueNew + (m_uMaxVal - m_uValueOld);
-		} else {
-			uDiffA = m_uValueNew - m_uValueOld;
-			uDiffB = m_uValueOld + (m_uMaxVal - m_uValueNew);
-		}
-		uint16_t uDiff = (uDiffA < uDiffB) ? uDiffA : uDiffB;
-		m_iValue += (bValComp ? 0-uDiff : uDiff);
+		//Account for any position adjustments made by setPosition() or index edges
+		syncShift();
+
+		//Find change in position since last update
+		int64_t iPos  = getPosition();
+		int64_t iDiff = iPos - m_iUpdatePos;
+		m_iUpdatePos  = iPos;
+
+		//Update velocity
+		updateVelocity(iPos);
 
 		//Calculate encoder acceleration value
-		m_uAccel = uDiff * 1000 / uTicks;
+		if (uTicks) {
+			uint64_t uDiff = (iDiff < 0) ? (uint64_t)(0-iDiff) : (uint64_t)iDiff;
+			uint64_t uAccel = uDiff * 1000 / uTicks;
+			m_uAccel = (uAccel > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)uAccel;
+		}
 	}
 }
 
@@ -170,21 +251,23 @@ QA_ActiveState QAD_Encoder::getState(void) {
 //QAD_Encoder::getValue
 //QAD_Encoder Control Method
 //
-//Returns the current change in encoder value
+//Returns the change in encoder value since getValue() was last called
 //Takes into account if the encoder mode is set to linear (QAD_EncoderMode_Linear) or exponential (QAD_EncoderMode_Exp)
-//NOTE: the update() method needs to be called prior to getValue() in order to obtain the most recent value
 //
 //Returns a positive number if encoder is turned clockwise, or a negative number if encoder is turned anti-clockwise
 //If you get opposite results than this then try swapping the two quadrature signal wires
-int16_t QAD_Encoder::getValue(void) {
+int32_t QAD_Encoder::getValue(void) {
 
 	//Check that driver is currently active
   if (m_eInitState) {
 
   	//As each click of the encoder generates four quadrature signal 'edges', a single click of the encoder will change the timer
-  	//counter register value by a value of +/- 4. The following code is used to take this into account.
-  	int16_t iOutVal = m_iValue / 4;
-  	m_iValue = m_iValue % 4;
+  	//counter register value by a value of +/- 4. The following code is used to take this into account, with any remaining
+  	//partial click being kept for the next call
+  	syncShift();
+  	int64_t iDiff   = getPosition() - m_iValuePos;
+  	int32_t iOutVal = (int32_t)(iDiff / 4);
+  	m_iValuePos += (int64_t)iOutVal * 4;
 
   	//Return the current value based on the currently selected encoder mode
   	return (m_eMode) ? (iOutVal * iOutVal * iOutVal) : iOutVal;
@@ -201,11 +284,121 @@ int16_t QAD_Encoder::getValue(void) {
 //Returns the current acceleration value of the encoder (how fast the encoder is being rotated)
 //This will return a positive value regardless of whether the encoder is being rotated clockwise or anti-clockwise
 //NOTE: the update() method needs to be called prior to getAccel() in order to obtain the most recent value
-uint16_t QAD_Encoder::getAccel(void) {
+uint32_t QAD_Encoder::getAccel(void) {
   return (m_eInitState) ? m_uAccel : 0;
 }
 
 
+//QAD_Encoder::getPosition
+//QAD_Encoder Control Method
+//
+//Returns the current encoder position in counts (four counts per encoder click), including all counter overflows and underflows
+//Safe to be called from any context, including interrupt handlers of a higher priority than the timer's update interrupt
+int64_t QAD_Encoder::getPosition(void) {
+
+	//Return 0 if driver is not initialized
+	if (!m_eInitState)
+		return 0;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	int64_t iPos = readPosition();
+	__set_PRIMASK(uPRIMASK);
+
+	return iPos;
+}
+
+
+//QAD_Encoder::setPosition
+//QAD_Encoder Control Method
+//
+//Sets the current encoder position. The timer counter itself is not modified
+//iPosition - The new position in counts
+void QAD_Encoder::setPosition(int64_t iPosition) {
+
+	//Return if driver is not initialized
+	if (!m_eInitState)
+		return;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	applyShift(iPosition - readPosition());
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+//QAD_Encoder::getVelocity
+//QAD_Encoder Control Method
+//
+//Returns the filtered encoder velocity in counts per second, as Q24.8 fixed point (divide by 256 for counts per second)
+//NOTE: the update() method needs to be called at a regular rate in order for the velocity to be updated
+int32_t QAD_Encoder::getVelocity(void) {
+	return (m_eInitState) ? m_iVelocity : 0;
+}
+
+
+//QAD_Encoder::getVelocityRaw
+//QAD_Encoder Control Method
+//
+//Returns the unfiltered encoder velocity from the most recent update() call in counts per second, as Q24.8 fixed point
+int32_t QAD_Encoder::getVelocityRaw(void) {
+	return (m_eInitState) ? m_iVelRaw : 0;
+}
+
+
+//QAD_Encoder::home
+//QAD_Encoder Control Method
+//
+//Used to rehome the encoder when using QAD_Encoder_IndexMode_Home or QAD_Encoder_IndexMode_Correct index modes
+//The position will be set to 0 on the next index edge
+void QAD_Encoder::home(void) {
+	m_bHomed = false;
+}
+
+
+//QAD_Encoder::isHomed
+//QAD_Encoder Control Method
+//
+//Returns true if the position has been set by an index edge since start() or home() were last called
+bool QAD_Encoder::isHomed(void) {
+	return m_bHomed;
+}
+
+
+//QAD_Encoder::getIndexPosition
+//QAD_Encoder Control Method
+//
+//Returns the position of the most recent index edge, as latched by the timer at the index edge
+//Any adjustment made to the position by the index edge itself is included
+int64_t QAD_Encoder::getIndexPosition(void) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	int64_t iPos = m_iIndexPos;
+	__set_PRIMASK(uPRIMASK);
+	return iPos;
+}
+
+
+//QAD_Encoder::getIndexCount
+//QAD_Encoder Control Method
+//
+//Returns the number of index edges that have occurred since start() was called
+uint32_t QAD_Encoder::getIndexCount(void) {
+	return m_uIndexCount;
+}
+
+
+//QAD_Encoder::getIndexDrift
+//QAD_Encoder Control Method
+//
+//Returns the difference in counts between the most recent index edge and the nearest multiple of the counts per revolution
+//A drift that grows over time indicates lost or spurious counts. Drift is measured in QAD_Encoder_IndexMode_Home and
+//QAD_Encoder_IndexMode_Correct index modes, once homed
+int32_t QAD_Encoder::getIndexDrift(void) {
+	return m_iIndexDrift;
+}
+
+
 //QAD_Encoder::setMode
 //QAD_Encoder Control Method
 //
@@ -252,14 +445,27 @@ QA_Result QAD_Encoder::periphInit(void) {
   GPIO_Init.Alternate = m_uCh2_AF;             //Set alternate function to suit required timer peripheral
   HAL_GPIO_Init(m_pCh2_GPIO, &GPIO_Init);
 
+  //Encoder Index GPIO Initialization
+  if (m_pIdx_GPIO) {
+  	GPIO_Init.Pin       = m_uIdx_Pin;          //Set pin number
+  	GPIO_Init.Alternate = m_uIdx_AF;           //Set alternate function to suit required timer peripheral
+  	HAL_GPIO_Init(m_pIdx_GPIO, &GPIO_Init);
+  }
+
+  //Enable cycle counter used for velocity timestamps
+  QAT_Timestamp::init();
+
   //Enable Timer Clock
   QAD_TimerMgr::enableClock(m_eTimer);
 
+  //Use the full counter range of the timer
+  m_uPeriod = (QAD_TimerMgr::getType(m_eTimer) == QAD_Timer_32bit) ? 0xFFFFFFFF : 0xFFFF;
+
   //Initialize Timer
   m_sHandle.Instance               = QAD_TimerMgr::getInstance(m_eTimer);  //Set instance for required timer peripheral
   m_sHandle.Init.Prescaler         = 0;                                    //Prescaler is unused as timer counter is clocked by the encoder's quadrature signal
   m_sHandle.Init.CounterMode       = TIM_COUNTERMODE_UP;                   //Counter mode is unused as timer counter is updated based on quadrature signal
-  m_sHandle.Init.Period            = m_uMaxVal;                            //Set timer period
+  m_sHandle.Init.Period            = m_uPeriod;                            //Set timer period to full counter range
   m_sHandle.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;               //Unused
   m_sHandle.Init.RepetitionCounter = 0x0;                                  //
   m_sHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;        //Enable preload of the timer's auto-reload register
@@ -268,12 +474,12 @@ QA_Result QAD_Encoder::periphInit(void) {
   ENC_Init.EncoderMode   = TIM_ENCODERMODE_TI12;                           //Set mode to counting on both TI1 and TI2
   ENC_Init.IC1Polarity   = TIM_ICPOLARITY_RISING;                          //Set IC1 polarity to rising edge
   ENC_Init.IC1Selection  = TIM_ICSELECTION_DIRECTTI;                       //Set IC1 to direct connection mode
-  ENC_Init.IC1Prescaler  = TIM_ICPSC_DIV1;                                 //IC1 capture performed on each edge
-  ENC_Init.IC1Filter     = 0x0;                                            //Disable IC1 input capture filter
+  ENC_Init.IC1Prescaler  = ((uint32_t)m_eInputPrescaler << 2);           //Set IC1 capture prescaler (TIM_ICPSC_DIV1 to TIM_ICPSC_DIV8)
+  ENC_Init.IC1Filter     = m_uInputFilter;                                 //Set IC1 input capture filter
   ENC_Init.IC2Polarity   = TIM_ICPOLARITY_RISING;                          //Set IC2 polarity to rising edge
   ENC_Init.IC2Selection  = TIM_ICSELECTION_DIRECTTI;                       //Set IC2 to direct connection mode
-  ENC_Init.IC2Prescaler  = TIM_ICPSC_DIV1;                                 //IC2 capture performed on each edge
-  ENC_Init.IC2Filter     = 0x0;                                            //Disable IC2 input capture filter
+  ENC_Init.IC2Prescaler  = ((uint32_t)m_eInputPrescaler << 2);           //Set IC2 capture prescaler (TIM_ICPSC_DIV1 to TIM_ICPSC_DIV8)
+  ENC_Init.IC2Filter     = m_uInputFilter;                                 //Set IC2 input capture filter
 
   //Initialize Timer in encoder mode, performing a partial deinitialization if the initialization fails
   if (HAL_TIM_Encoder_Init(&m_sHandle, &ENC_Init) != HAL_OK) {
@@ -281,6 +487,33 @@ QA_Result QAD_Encoder::periphInit(void) {
   	return QA_Fail;
   }
 
+  //Initialize channel 3 to capture the counter on rising edges of the index signal
+  if (m_pIdx_GPIO) {
+  	TIM_IC_InitTypeDef IC_Init = {0};
+  	IC_Init.ICPolarity  = TIM_ICPOLARITY_RISING;                           //Capture on rising edge of index signal
+  	IC_Init.ICSelection = TIM_ICSELECTION_DIRECTTI;                        //Set IC3 to direct connection mode
+  	IC_Init.ICPrescaler = TIM_ICPSC_DIV1;                                  //Capture performed on each index edge
+  	IC_Init.ICFilter    = m_uInputFilter;                                  //Use same input filter as quadrature channels
+  	if (HAL_TIM_IC_ConfigChannel(&m_sHandle, &IC_Init, TIM_CHANNEL_3) != HAL_OK) {
+  		periphDeinit(DeinitFull);
+  		return QA_Fail;
+  	}
+  }
+
+  //Only generate update events on counter overflow/underflow, and clear the update flag set during initialization
+  m_sHandle.Instance->CR1 |= TIM_CR1_URS;
+  m_sHandle.Instance->SR   = ~(uint32_t)TIM_SR_UIF;
+
+  //Initialize update interrupt used for overflow tracking
+  HAL_NVIC_SetPriority(QAD_TimerMgr::getUpdateIRQ(m_eTimer), m_uIRQPriority, 0);
+  HAL_NVIC_EnableIRQ(QAD_TimerMgr::getUpdateIRQ(m_eTimer));
+
+  //Initialize capture interrupt used for M/T velocity method, where it is separate to the update interrupt (TIM1)
+  if (QAD_TimerMgr::getCCIRQ(m_eTimer) != QAD_TimerMgr::getUpdateIRQ(m_eTimer)) {
+  	HAL_NVIC_SetPriority(QAD_TimerMgr::getCCIRQ(m_eTimer), m_uIRQPriority, 0);
+  	HAL_NVIC_EnableIRQ(QAD_TimerMgr::getCCIRQ(m_eTimer));
+  }
+
   //Set Driver States
   m_eInitState = QA_Initialized; //Set driver state as initialized
   m_eState     = QA_Inactive;    //Set driver as currently inactive
@@ -302,6 +535,10 @@ void QAD_Encoder::periphDeinit(QAD_Encoder::DeinitMode eDeinitMode) {
 	//Check if full deinitialization is required
 	if (eDeinitMode) {
 
+		//Disable update and capture interrupts
+		HAL_NVIC_DisableIRQ(QAD_TimerMgr::getUpdateIRQ(m_eTimer));
+		HAL_NVIC_DisableIRQ(QAD_TimerMgr::getCCIRQ(m_eTimer));
+
 		//Deinitialize Timer Peripheral
 		HAL_TIM_Encoder_DeInit(&m_sHandle);
 	}
@@ -312,6 +549,8 @@ void QAD_Encoder::periphDeinit(QAD_Encoder::DeinitMode eDeinitMode) {
 	//Deinit GPIOs
 	HAL_GPIO_DeInit(m_pCh1_GPIO, m_uCh1_Pin);
 	HAL_GPIO_DeInit(m_pCh2_GPIO, m_uCh2_Pin);
+	if (m_pIdx_GPIO)
+		HAL_GPIO_DeInit(m_pIdx_GPIO, m_uIdx_Pin);
 
 	//Set States
 	m_eState     = QA_Inactive;        //Set driver as currently inactive
@@ -326,15 +565,289 @@ void QAD_Encoder::periphDeinit(QAD_Encoder::DeinitMode eDeinitMode) {
 //QAD_Encoder::clearData
 //QAD_Encoder Private Tool Method
 //
-//Used to clear the encoder/counter data, as well as clearing the Timer's counter register to 0
+//Used to clear the encoder/counter data. The Timer's counter register is set to the middle of its range, with the offset removed
+//from the accumulated position, so that a stationary encoder sitting at its start position cannot jitter across the counter wrap
 void QAD_Encoder::clearData(void) {
-  m_uValueOld = 0;
-  m_uValueNew = 0;
-  m_iValue    = 0;
-  m_uAccel    = 0;
-  __HAL_TIM_SET_COUNTER(&m_sHandle, 0);
+  uint32_t uStart = (m_uPeriod >> 1) + 1;
+  m_iOverflow   = -(int64_t)uStart;
+  m_iValuePos   = 0;
+  m_iUpdatePos  = 0;
+  m_uAccel      = 0;
+  m_iShift      = 0;
+  m_iShiftSeen  = 0;
+  m_bHomed      = false;
+  m_iIndexPos   = 0;
+  m_uIndexCount = 0;
+  m_iIndexDrift = 0;
+  __HAL_TIM_SET_COUNTER(&m_sHandle, uStart);
+}
+
+
+//QAD_Encoder::checkOverflow
+//QAD_Encoder Private Tool Method
+//
+//Checks for a pending update event, and if found adds the counter overflow or underflow to the accumulated position
+//The direction of the wrap is taken from the counter value rather than the direction bit, as the direction bit only shows
+//which way the counter is moving now, and the encoder may have reversed since it wrapped. As the counter cannot move half of
+//its range between the wrap and this check, a value in the lower half means it overflowed from the top of the range to 0,
+//and a value in the upper half means it underflowed from 0 to the top of the range
+//Must be called with interrupts disabled
+void QAD_Encoder::checkOverflow(void) {
+	TIM_TypeDef* pTIM = m_sHandle.Instance;
+
+	if (pTIM->SR & TIM_SR_UIF) {
+		pTIM->SR = ~(uint32_t)TIM_SR_UIF;
+
+		int64_t iRange = (int64_t)m_uPeriod + 1;
+		if (pTIM->CNT < (uint32_t)(((uint64_t)m_uPeriod + 1) >> 1))
+			m_iOverflow += iRange;  //Counter overflowed from top of range to 0 while counting up
+		else
+			m_iOverflow -= iRange;  //Counter underflowed from 0 to top of range while counting down
+	}
+}
+
+
+//QAD_Encoder::readPosition
+//QAD_Encoder Private Tool Method
+//
+//Returns the current position, processing any pending overflow before reading the counter. If the counter wraps between the
+//overflow check and the counter read then this is repeated, so the overflow count and counter value always match
+//Must be called with interrupts disabled
+//pCount - Optional pointer to return the counter value the position was read from
+int64_t QAD_Encoder::readPosition(uint32_t* pCount) {
+	uint32_t uCount;
+	do {
+		checkOverflow();
+		uCount = m_sHandle.Instance->CNT;
+	} while (m_sHandle.Instance->SR & TIM_SR_UIF);
+
+	if (pCount)
+		*pCount = uCount;
+	return m_iOverflow + uCount;
+}
+
+
+//QAD_Encoder::readCapture
+//QAD_Encoder Private Tool Method
+//
+//Returns the position at which a capture occurred, found from the current position as the counter may have moved since the capture
+//Must be called with interrupts disabled
+//uCapture - The value of the capture register
+int64_t QAD_Encoder::readCapture(uint32_t uCapture) {
+	uint32_t uCount;
+	int64_t  iPos    = readPosition(&uCount);
+	int32_t  iOffset = (m_uPeriod == 0xFFFF) ? (int16_t)(uCapture - uCount) : (int32_t)(uCapture - uCount);
+	return iPos + iOffset;
 }
 
 
+//QAD_Encoder::applyShift
+//QAD_Encoder Private Tool Method
+//
+//Adjusts the position, along with positions stored by interrupt handlers. Positions stored by update() and getValue() are
+//adjusted later by syncShift(), so that the adjustment is not seen as movement
+//Must be called with interrupts disabled
+//iShift - The adjustment to be made to the position in counts
+void QAD_Encoder::applyShift(int64_t iShift) {
+	m_iOverflow += iShift;
+	m_iEdgePos  += iShift;
+	m_iIndexPos += iShift;
+	m_iShift    += iShift;
+}
 
 
+//QAD_Encoder::syncShift
+//QAD_Encoder Private Tool Method
+//
+//Applies any position adjustments made since this method was last called to positions stored by update() and getValue()
+void QAD_Encoder::syncShift(void) {
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	int64_t iShift = m_iShift;
+	__set_PRIMASK(uPRIMASK);
+
+	int64_t iDelta = iShift - m_iShiftSeen;
+	m_iShiftSeen   = iShift;
+
+	m_iValuePos   += iDelta;
+	m_iUpdatePos  += iDelta;
+	m_iVelPos     += iDelta;
+	m_iVelEdgePos += iDelta;
+}
+
+
+//QAD_Encoder::processIndex
+//QAD_Encoder Private Tool Method
+//
+//Used by handler() to latch an index edge, and to home or correct the position depending on the index mode
+//Corrections of a single count are not applied, as the captured count at the index edge differs slightly with direction
+//Must be called with interrupts disabled
+//iIndexPos - The position at which the index edge occurred
+void QAD_Encoder::processIndex(int64_t iIndexPos) {
+	m_iIndexPos = iIndexPos;
+	m_uIndexCount++;
+
+	if (m_eIndexMode == QAD_Encoder_IndexMode_Latch)
+		return;
+
+	//Home position to first index edge
+	if (!m_bHomed) {
+		applyShift(0-iIndexPos);
+		m_iIndexDrift = 0;
+		m_bHomed      = true;
+		return;
+	}
+
+	//Measure drift from nearest multiple of the counts per revolution
+	if (!m_uCountsPerRev)
+		return;
+	int64_t iCPR   = m_uCountsPerRev;
+	int64_t iRev   = (iIndexPos >= 0) ? ((iIndexPos + (iCPR >> 1)) / iCPR) : (0-((0-iIndexPos + (iCPR >> 1)) / iCPR));
+	int32_t iDrift = (int32_t)(iIndexPos - (iRev * iCPR));
+	m_iIndexDrift  = iDrift;
+
+	//Correct drift
+	if ((m_eIndexMode == QAD_Encoder_IndexMode_Correct) && ((iDrift > 1) || (iDrift < -1)))
+		applyShift(0-iDrift);
+}
+
+
+//QAD_Encoder::clearVelocity
+//QAD_Encoder Private Tool Method
+//
+//Used to clear velocity data
+void QAD_Encoder::clearVelocity(void) {
+	uint32_t uNow = QAT_Timestamp::get();
+
+	m_iVelocity     = 0;
+	m_iVelRaw       = 0;
+	m_iVelPos       = 0;
+	m_uVelTime      = uNow;
+	m_bVelEdgeValid = false;
+	m_iEdgePos      = 0;
+	m_uEdgeTime     = uNow;
+	m_iVelEdgePos   = 0;
+	m_uVelEdgeTime  = uNow;
+	m_uVelEdgeCount = m_uEdgeCount;
+}
+
+
+//QAD_Encoder::updateVelocity
+//QAD_Encoder Private Tool Method
+//
+//Used by update() to calculate the raw and filtered velocity, and to switch between M and M/T methods
+//iPos - The current position
+void QAD_Encoder::updateVelocity(int64_t iPos) {
+	uint32_t uNow     = QAT_Timestamp::get();
+	bool     bVelEdge = m_bVelEdge;  //Copy taken as the capture interrupt may switch to the M method during this calculation
+	int32_t  iRaw;
+
+	if (bVelEdge) {
+
+		//M/T Method
+		//Take copy of most recent captured edge data
+		uint32_t uPRIMASK = __get_PRIMASK();
+		__disable_irq();
+		int64_t  iEdgePos   = m_iEdgePos;
+		uint32_t uEdgeTime  = m_uEdgeTime;
+		uint32_t uEdgeCount = m_uEdgeCount;
+		__set_PRIMASK(uPRIMASK);
+
+		if (uEdgeCount != m_uVelEdgeCount) {
+
+			//New edge captured. Velocity is the change in position between the previous and current edges divided by the
+			//time between them. If there is no valid previous edge then the previous velocity is kept
+			iRaw = (m_bVelEdgeValid) ? calcVelocity(iEdgePos - m_iVelEdgePos, uEdgeTime - m_uVelEdgeTime) : m_iVelRaw;
+
+			m_iVelEdgePos   = iEdgePos;
+			m_uVelEdgeTime  = uEdgeTime;
+			m_uVelEdgeCount = uEdgeCount;
+			m_bVelEdgeValid = true;
+
+		} else {
+
+			//No new edge captured
+			uint32_t uElapsed = uNow - m_uVelEdgeTime;
+			if (uElapsed > m_uVelTimeout) {
+
+				//Encoder has stopped
+				iRaw = 0;
+				m_bVelEdgeValid = false;
+				m_uVelEdgeTime  = uNow - m_uVelTimeout;
+
+			} else {
+
+				//As no edge has occurred, the speed is at most one capture period (four counts per quadrature cycle, multiplied by
+				//the capture prescaler) over the time since the last edge, so limit the previous velocity to this
+				iRaw = m_iVelRaw;
+				if (m_bVelEdgeValid) {
+					int32_t iLimit = calcVelocity(4 << m_eInputPrescaler, uElapsed);
+					if (iRaw > iLimit)
+						iRaw = iLimit;
+					if (iRaw < -iLimit)
+						iRaw = -iLimit;
+				}
+			}
+		}
+
+	} else {
+
+		//M Method
+		iRaw = calcVelocity(iPos - m_iVelPos, uNow - m_uVelTime);
+	}
+
+	m_iVelPos  = iPos;
+	m_uVelTime = uNow;
+	m_iVelRaw  = iRaw;
+
+	//Switch between methods, with 25% hysteresis to prevent repeated switching close to the threshold
+	if (m_uVelThreshold) {
+		uint32_t uSpeed = ((iRaw < 0) ? (uint32_t)(0-iRaw) : (uint32_t)iRaw) >> 8;
+		if ((bVelEdge) && (uSpeed > m_uVelThreshold))
+			setEdgeCapture(false);
+		else if ((!bVelEdge) && (uSpeed < (m_uVelThreshold - (m_uVelThreshold >> 2))))
+			setEdgeCapture(true);
+	}
+
+	//Apply IIR filter
+	m_iVelocity += (iRaw - m_iVelocity) >> m_uVelFilter;
+}
+
+
+//QAD_Encoder::calcVelocity
+//QAD_Encoder Private Tool Method
+//
+//Calculates a velocity from a change in position over a time period
+//iCounts - The change in position in counts
+//uTicks  - The time period in timestamp ticks
+//Returns the velocity in counts per second as Q24.8 fixed point, or 0 if uTicks is 0
+int32_t QAD_Encoder::calcVelocity(int64_t iCounts, uint32_t uTicks) {
+	if (!uTicks)
+		return 0;
+
+	int64_t iVel = (iCounts * ((int64_t)QAT_Timestamp::getFrequency() << 8)) / uTicks;
+	if (iVel > INT32_MAX)
+		return INT32_MAX;
+	if (iVel < -INT32_MAX)
+		return -INT32_MAX;
+	return (int32_t)iVel;
+}
+
+
+//QAD_Encoder::setEdgeCapture
+//QAD_Encoder Private Tool Method
+//
+//Used to enable or disable the capture interrupt used by the M/T velocity method
+//bEnable - Set to true to use the M/T method, or false to use the M method
+void QAD_Encoder::setEdgeCapture(bool bEnable) {
+	if (bEnable) {
+		m_bVelEdgeValid = false;
+		m_uVelEdgeTime  = QAT_Timestamp::get();
+		m_uVelEdgeCount = m_uEdgeCount;
+		m_sHandle.Instance->SR = ~(uint32_t)(TIM_SR_CC1IF | TIM_SR_CC1OF);
+		__HAL_TIM_ENABLE_IT(&m_sHandle, TIM_IT_CC1);
+	} else {
+		__HAL_TIM_DISABLE_IT(&m_sHandle, TIM_IT_CC1);
+	}
+	m_bVelEdge = bEnable;
+}
@@ -23,6 +23,7 @@
 #include "setup.hpp"
 
 #include "QAD_TimerMgr.hpp"
+#include "QAT_Timestamp.hpp"
 
 
 	//------------------------------------------
@@ -43,6 +44,31 @@ enum QAD_EncoderMode : uint8_t {
 };
 
 
+//---------------------
+//QAD_Encoder_Prescaler
+//
+//Used with QAD_Encoder driver class to set the input capture prescaler for the quadrature channels
+//The prescaler does not affect counting, only how many quadrature cycles occur per capture used by the M/T velocity method
+enum QAD_Encoder_Prescaler : uint8_t {
+	QAD_Encoder_Prescaler_Div1 = 0, //Capture on every quadrature cycle
+	QAD_Encoder_Prescaler_Div2,     //Capture on every 2nd quadrature cycle
+	QAD_Encoder_Prescaler_Div4,     //Capture on every 4th quadrature cycle
+	QAD_Encoder_Prescaler_Div8      //Capture on every 8th quadrature cycle
+};
+
+
+//---------------------
+//QAD_Encoder_IndexMode
+//
+//Used with QAD_Encoder driver class to determine how the index (Z) pulse is used
+enum QAD_Encoder_IndexMode : uint8_t {
+	QAD_Encoder_IndexMode_Latch = 0, //Position at each index edge is latched, but position is not modified
+	QAD_Encoder_IndexMode_Home,      //On the first index edge after start() or home() the position is set to 0, with further edges only latched
+	QAD_Encoder_IndexMode_Correct    //As for QAD_Encoder_IndexMode_Home, with the position then corrected on each further index edge so that
+	                                 //index edges are always at a multiple of the counts per revolution
+};
+
+
 //----------------------
 //QAD_Encoder_InitStruct
 //
@@ -57,11 +83,34 @@ typedef struct {
 	uint16_t          uCh2_Pin;  //Pin number to be used for channel 2 of the encoder's quadrature signal
 	uint8_t           uCh2_AF;   //Alternate function to be used to link GPIO pin to Timer peripheral
 
+	GPIO_TypeDef*     pIdx_GPIO; //GPIO port to be used for the encoder's index (Z) signal, or NULL if no index signal is used
+	uint16_t          uIdx_Pin;  //Pin number to be used for the index signal. Must be connected to channel 3 of the timer peripheral
+	uint8_t           uIdx_AF;   //Alternate function to be used to link GPIO pin to Timer peripheral
+
 	QAD_Timer_Periph  eTimer;    //Timer peripheral to be used (member of QAD_Timer_Periph, as defined in QAD_TimerMgr.hpp)
 	                             //Note that the selected timer must have rotary encoder mode support
 
+	uint8_t           uInputFilter;      //Digital filter applied to quadrature and index inputs (0 to 15, as per ICxF bits of the timer's CCMR registers)
+	                                     //0 disables the filter. Higher values require an input to be stable for longer before a change is accepted,
+	                                     //rejecting noise such as motor EMI. The filter is sampled at the timer's clock
+	QAD_Encoder_Prescaler eInputPrescaler; //Input capture prescaler for quadrature channels (member of QAD_Encoder_Prescaler)
+
+	QAD_Encoder_IndexMode eIndexMode;  //How the index signal is used (member of QAD_Encoder_IndexMode). Unused if pIdx_GPIO is NULL
+	uint32_t          uCountsPerRev;     //Counts per revolution (four times encoder lines per revolution), used by QAD_Encoder_IndexMode_Correct
+
 	QAD_EncoderMode   eMode;     //Encoder output data mode (QAD_EncoderMode_Linear or QAD_EncoderMode_Exp)
 
+	uint8_t           uIRQPriority; //IRQ Priority for the timer's update interrupt (a value between 0 and 15), used for counter overflow tracking
+	                                //This should be a high priority, as the interrupt must be serviced before the counter moves back across
+	                                //the wrap point
+
+	uint32_t          uVelocityThreshold; //Velocity in counts per second above which velocity is measured by counting edges over each update()
+	                                      //period (M method), and below which velocity is measured from timestamped capture edges (M/T method)
+	                                      //Set to 0 to always use the M method, which avoids the capture interrupt at the cost of low speed resolution
+	uint16_t          uVelocityTimeout;   //Time in milliseconds without an encoder edge after which velocity is reported as zero
+	                                      //Set to 0 to use the longest supported timeout (approximately 21 seconds at 100MHz)
+	uint8_t           uVelocityFilter;    //Velocity IIR filter strength, as a shift value (0 = unfiltered, 1 to 8 = increasing filtering)
+
 } QAD_Encoder_InitStruct;
 
 
@@ -73,6 +122,18 @@ typedef struct {
 //QAD_Encoder
 //
 //Driver class for using timer peripheral in rotary encoder mode
+//The timer counter uses its full range (16bit, or 32bit for TIM2 and TIM5), with counter overflows and underflows tracked by the
+//timer's update interrupt to provide an exact 64bit position. The counter starts from the middle of its range so that it is well
+//away from the wrap point at rest, and the direction of each wrap is taken from which half of the range the counter is in when the wrap is processed. handler() must be called from the timer's update IRQ handler
+//(TIM1_UP_TIM10_IRQHandler for TIM1), and when the M/T velocity method or index signal are used, also from TIM1_CC_IRQHandler for TIM1
+//
+//Velocity is measured in update(). At high speeds the change in position over each update() period is used (M method). At low
+//speeds, channel 1 captures the counter on each quadrature cycle, with the capture interrupt recording a CPU cycle counter timestamp.
+//Velocity is then the change in position between the most recent captured edges divided by the time between them (M/T method),
+//which gives full resolution regardless of how often update() is called. The capture interrupt itself switches to the M method
+//as soon as edges arrive faster than the threshold, so a fast encoder cannot flood the CPU with capture interrupts between update() calls
+//
+//The optional index signal is captured by channel 3, latching the counter in hardware at the index edge
 class QAD_Encoder {
 private:
 
@@ -82,8 +143,6 @@ private:
 		DeinitFull            //Used for full driver deinitialization when driver is in a fully initialized state
 	};
 
-	const uint16_t     m_uMaxVal = 1024;  //Value used for timer period and encoder value calculation
-
 	GPIO_TypeDef*      m_pCh1_GPIO;       //GPIO port to be used for channel 1 of the encoder's quadrature signal
 	uint16_t           m_uCh1_Pin;        //Pin number to be used for channel 1 of the encoder's quadrature signal
 	uint8_t            m_uCh1_AF;         //Alternate function to be used to link GPIO pin to timer peripheral
@@ -92,6 +151,13 @@ private:
 	uint16_t           m_uCh2_Pin;        //Pin number to be used for channel 2 of the encoder's quadrature signal
 	uint8_t            m_uCh2_AF;         //Alternate function to be used to link GPIO pin to timer peripheral
 
+	GPIO_TypeDef*      m_pIdx_GPIO;       //GPIO port to be used for the encoder's index signal, or NULL if unused
+	uint16_t           m_uIdx_Pin;        //Pin number to be used for the encoder's index signal
+	uint8_t            m_uIdx_AF;         //Alternate function to be used to link GPIO pin to timer peripheral
+
+	uint8_t            m_uInputFilter;    //Digital input filter value
+	QAD_Encoder_Prescaler m_eInputPrescaler; //Input capture prescaler for quadrature channels
+
 	QAD_Timer_Periph   m_eTimer;          //Stores the particular timer peripheral to be used by the driver.
 	                                      //Member of QAD_Timer_Periph as defined in QAD_TimerMgr.hpp
 
@@ -101,10 +167,41 @@ private:
 
 	QA_ActiveState     m_eState;          //Stores whether the driver is currently active. Member of QA_ActiveState enum defined in setup.hpp
 
-	uint16_t           m_uValueOld;       //Stores the previous timer counter value
-	uint16_t           m_uValueNew;       //Stores the current timer counter value
-	int16_t            m_iValue;          //Stores the difference in between the previous and current timer counter values
-	uint16_t           m_uAccel;          //Stores the acceleration value of the encoder (how fast the encoder is being rotated)
+	uint8_t            m_uIRQPriority;    //IRQ Priority for the timer's update interrupt
+	uint32_t           m_uPeriod;         //Timer period (0xFFFF for 16bit timers, 0xFFFFFFFF for 32bit timers)
+
+	volatile int64_t   m_iOverflow;       //Accumulated counter overflows/underflows, in counts. Position is m_iOverflow plus the counter value
+	int64_t            m_iValuePos;       //Position at which the value returned by getValue() was last taken
+	int64_t            m_iUpdatePos;      //Position at the time update() was last called
+	uint32_t           m_uAccel;          //Stores the acceleration value of the encoder (how fast the encoder is being rotated)
+
+	uint32_t           m_uVelThreshold;   //Velocity in counts per second for switching between M and M/T methods
+	uint16_t           m_uVelTimeoutMs;   //Zero velocity timeout, in milliseconds
+	uint32_t           m_uVelTimeout;     //Zero velocity timeout, in timestamp ticks. Calculated by init() once the system clock is configured
+	uint8_t            m_uVelFilter;      //Velocity IIR filter shift value
+	volatile bool      m_bVelEdge;        //Set to true while velocity is measured from captured edges (M/T method)
+	bool               m_bVelEdgeValid;   //Set to true once a previous edge is available for the M/T method
+	int32_t            m_iVelocity;       //Filtered velocity in counts per second (Q24.8 fixed point)
+	int32_t            m_iVelRaw;         //Unfiltered velocity from most recent update() in counts per second (Q24.8 fixed point)
+	int64_t            m_iVelPos;         //Position at previous update() call, used by M method
+	uint32_t           m_uVelTime;        //Timestamp of previous update() call, used by M method
+
+	volatile int64_t   m_iEdgePos;        //Position of most recent captured edge
+	volatile uint32_t  m_uEdgeTime;       //Timestamp of most recent captured edge
+	volatile uint32_t  m_uEdgeCount;      //Number of edges captured, used to detect new edges
+	int64_t            m_iVelEdgePos;     //Position of edge used by previous M/T velocity calculation
+	uint32_t           m_uVelEdgeTime;    //Timestamp of edge used by previous M/T velocity calculation
+	uint32_t           m_uVelEdgeCount;   //Edge count at previous M/T velocity calculation
+
+	QAD_Encoder_IndexMode m_eIndexMode;   //How the index signal is used
+	uint32_t           m_uCountsPerRev;   //Counts per revolution, used for index drift correction
+	volatile bool      m_bHomed;          //Set to true once the position has been set by an index edge
+	volatile int64_t   m_iIndexPos;       //Position of most recent index edge
+	volatile uint32_t  m_uIndexCount;     //Number of index edges captured
+	volatile int32_t   m_iIndexDrift;     //Difference in counts between most recent index edge and its expected position
+
+	volatile int64_t   m_iShift;          //Total adjustment made to position by setPosition() and index edges
+	int64_t            m_iShiftSeen;      //Value of m_iShift when stored positions were last adjusted
 
 	QAD_EncoderMode    m_eMode;           //Stores whether the encoder data output is in linear or exponential mode
 	                                      //See QAD_EncoderMode definition for further details
@@ -123,14 +220,45 @@ public:
 		m_pCh2_GPIO(sInit.pCh2_GPIO),
 		m_uCh2_Pin(sInit.uCh2_Pin),
 		m_uCh2_AF(sInit.uCh2_AF),
+		m_pIdx_GPIO(sInit.pIdx_GPIO),
+		m_uIdx_Pin(sInit.uIdx_Pin),
+		m_uIdx_AF(sInit.uIdx_AF),
+		m_uInputFilter(sInit.uInputFilter & 0x0F),
+		m_eInputPrescaler(sInit.eInputPrescaler),
 		m_eTimer(sInit.eTimer),
 		m_sHandle({0}),
 		m_eInitState(QA_NotInitialized),
 		m_eState(QA_Inactive),
-		m_uValueOld(0),
-		m_uValueNew(0),
-		m_iValue(0),
+		m_uIRQPriority(sInit.uIRQPriority),
+		m_uPeriod(0),
+		m_iOverflow(0),
+		m_iValuePos(0),
+		m_iUpdatePos(0),
 		m_uAccel(0),
+		m_uVelThreshold(sInit.uVelocityThreshold),
+		m_uVelTimeoutMs(sInit.uVelocityTimeout),
+		m_uVelTimeout(0x7FFFFFFF),
+		m_uVelFilter((sInit.uVelocityFilter > 8) ? 8 : sInit.uVelocityFilter),
+		m_bVelEdge(false),
+		m_bVelEdgeValid(false),
+		m_iVelocity(0),
+		m_iVelRaw(0),
+		m_iVelPos(0),
+		m_uVelTime(0),
+		m_iEdgePos(0),
+		m_uEdgeTime(0),
+		m_uEdgeCount(0),
+		m_iVelEdgePos(0),
+		m_uVelEdgeTime(0),
+		m_uVelEdgeCount(0),
+		m_eIndexMode(sInit.eIndexMode),
+		m_uCountsPerRev(sInit.uCountsPerRev),
+		m_bHomed(false),
+		m_iIndexPos(0),
+		m_uIndexCount(0),
+		m_iIndexDrift(0),
+		m_iShift(0),
+		m_iShiftSeen(0),
 		m_eMode(sInit.eMode) {};
 
   ~QAD_Encoder() {       //Destructor to make sure peripheral is mode inactive and deinitialized upon class destruction
@@ -154,6 +282,12 @@ public:
   void deinit(void);
 
 
+  //-------------------
+  //IRQ Handler Methods
+
+  void handler(void);
+
+
   //---------------
   //Control Methods
 
@@ -163,8 +297,20 @@ public:
   void update(uint32_t uTicks);
 
   QA_ActiveState getState(void);
-  int16_t getValue(void);
-  uint16_t getAccel(void);
+  int32_t getValue(void);
+  uint32_t getAccel(void);
+
+  int64_t getPosition(void);
+  void setPosition(int64_t iPosition);
+
+  int32_t getVelocity(void);
+  int32_t getVelocityRaw(void);
+
+  void home(void);
+  bool isHomed(void);
+  int64_t getIndexPosition(void);
+  uint32_t getIndexCount(void);
+  int32_t getIndexDrift(void);
 
   void setMode(QAD_EncoderMode eMode);
   QAD_EncoderMode getMode(void);
@@ -182,6 +328,16 @@ private:
   //Tool Methods
 
   void clearData(void);
+  void checkOverflow(void);
+  int64_t readPosition(uint32_t* pCount = NULL);
+  int64_t readCapture(uint32_t uCapture);
+  void applyShift(int64_t iShift);
+  void syncShift(void);
+  void processIndex(int64_t iIndexPos);
+  void clearVelocity(void);
+  void updateVelocity(int64_t iPos);
+  int32_t calcVelocity(int64_t iCounts, uint32_t uTicks);
+  void setEdgeCapture(bool bEnable);
 
 };
 
@@ -39,6 +39,31 @@ QA_Result QAD_PWM::init(void) {
   if (QAD_TimerMgr::getState(m_eTimer))
   	return QA_Error_PeriphBusy;
 
+  //Check that complementary outputs, dead-time or break input have only been requested for an advanced-control timer
+  if (!checkAdvanced())
+  	return QA_Error_PeriphNotSupported;
+
+  //Check that peak/valley trigger output has been requested with a center-aligned counter mode, and that channel 4 is
+  //available to generate it
+  if ((m_eTrigger >= QAD_PWM_Trigger_Valley) &&
+  		((m_eCounterMode == QAD_PWM_CounterMode_Up) || (QAD_TimerMgr::getChannels(m_eTimer) < 4) || (m_sChannels[QAD_PWM_Channel_4].eActive)))
+  	return QA_Error_PeriphNotSupported;
+
+  //If a target frequency has been provided then calculate the prescaler and period
+  if (m_uFrequency) {
+  	if (QAD_TimerMgr::calcFrequency(m_eTimer, m_uFrequency, m_uResolution, (m_eCounterMode != QAD_PWM_CounterMode_Up),
+  			                            m_uPrescaler, m_uPeriod))
+  		return QA_Fail;
+  }
+
+  //Calculate compare value for 100% duty cycle
+  //In edge-aligned mode the output is fully on when the compare value is greater than the period. If the period is already the
+  //largest value the compare register can hold (0xFFFF on 16bit timers) then the scale is limited to that value, as a larger value
+  //would be truncated by the register and give 0% duty rather than 100%. In this case 100% duty is one count short of fully on
+  uint64_t uDutyScale = (m_eCounterMode == QAD_PWM_CounterMode_Up) ? ((uint64_t)m_uPeriod + 1) : m_uPeriod;
+  uint64_t uDutyMax   = (QAD_TimerMgr::getType(m_eTimer) == QAD_Timer_32bit) ? 0xFFFFFFFFULL : 0xFFFFULL;
+  m_uDutyScale = (uint32_t)((uDutyScale > uDutyMax) ? uDutyMax : uDutyScale);
+
   //Register Timer peripheral as now being in use
   QAD_TimerMgr::registerTimer(m_eTimer, QAD_Timer_InUse_PWM);
 
@@ -88,6 +113,10 @@ void QAD_PWM::start(void) {
 		//If channel is set to active then start PWM on that channel
 		if (m_sChannels[i].eActive)
 			HAL_TIM_PWM_Start(&m_sHandle, m_uChannelSelect[i]);
+
+		//If complementary output is set to active then start complementary PWM output on that channel
+		if (m_sChannels[i].eCompActive)
+			HAL_TIMEx_PWMN_Start(&m_sHandle, m_uChannelSelect[i]);
 	}
 
 	//Set PWM driver state to active
@@ -104,6 +133,10 @@ void QAD_PWM::stop(void) {
 	//Iterate through the number of channels supported by the specific timer peripheral
 	for (uint8_t i=0; i<QAD_TimerMgr::getChannels(m_eTimer); i++) {
 
+		//If complementary output is currently active then stop complementary PWM output on that channel
+		if (m_sChannels[i].eCompActive)
+			HAL_TIMEx_PWMN_Stop(&m_sHandle, m_uChannelSelect[i]);
+
 		//If channel is currently active then stop PWM on that channel
 		if (m_sChannels[i].eActive)
 			HAL_TIM_PWM_Stop(&m_sHandle, m_uChannelSelect[i]);
@@ -120,7 +153,8 @@ void QAD_PWM::stop(void) {
 //Sets the current PWM value for a specific channel
 //eChannel - The PWM channel to set the value for. A member of QAD_PWM_Channel as defined in QAD_PWM.hpp
 //uVal     - The PWM value to set. This value should not be larger than the timer period set within the driver initialization structure
-void QAD_PWM::setPWMVal(QAD_PWM_Channel eChannel, uint16_t uVal) {
+//           The upper 16 bits are ignored by 16bit timers
+void QAD_PWM::setPWMVal(QAD_PWM_Channel eChannel, uint32_t uVal) {
 
 	//Return if the selected channel is higher than the number of channels supported by the selected timer peripheral
   if (eChannel >= QAD_TimerMgr::getChannels(m_eTimer))
@@ -134,12 +168,101 @@ void QAD_PWM::setPWMVal(QAD_PWM_Channel eChannel, uint16_t uVal) {
 //QAD_PWM::getPeriod
 //QAD_PWM Control Method
 //
-//Returns the current timer period value
-uint16_t QAD_PWM::getPeriod(void) {
+//Returns the current timer period value. On the 32bit timers (TIM2 and TIM5) the period may be larger than 16 bits
+uint32_t QAD_PWM::getPeriod(void) {
 	return m_uPeriod;
 }
 
 
+//QAD_PWM::getFrequency
+//QAD_PWM Control Method
+//
+//Returns the actual PWM frequency in Hz generated by the current prescaler and period
+uint32_t QAD_PWM::getFrequency(void) {
+	uint64_t uTicks = (uint64_t)(m_uPrescaler + 1) *
+			              ((m_eCounterMode == QAD_PWM_CounterMode_Up) ? ((uint64_t)m_uPeriod + 1) : ((uint64_t)m_uPeriod * 2));
+	if (!uTicks)
+		return 0;
+	return (uint32_t)((QAD_TimerMgr::getClockSpeed(m_eTimer) + (uTicks / 2)) / uTicks);
+}
+
+
+  //------------------------------
+  //------------------------------
+  //QAD_PWM Advanced Timer Methods
+
+//QAD_PWM::enableOutputs
+//QAD_PWM Advanced Timer Method
+//
+//Sets the Main Output Enable (MOE) bit of an advanced-control timer, enabling the main and complementary outputs
+//Note that start() will also set the MOE bit. If the break input is currently active then the outputs will remain disabled
+void QAD_PWM::enableOutputs(void) {
+	if (!QAD_TimerMgr::getAdvanced(m_eTimer))
+		return;
+
+	__HAL_TIM_MOE_ENABLE(&m_sHandle);
+}
+
+
+//QAD_PWM::disableOutputs
+//QAD_PWM Advanced Timer Method
+//
+//Clears the Main Output Enable (MOE) bit of an advanced-control timer
+//The main and complementary outputs will be driven to their idle (inactive) levels while the timer continues to run
+void QAD_PWM::disableOutputs(void) {
+	if (!QAD_TimerMgr::getAdvanced(m_eTimer))
+		return;
+
+	__HAL_TIM_MOE_DISABLE_UNCONDITIONALLY(&m_sHandle);
+}
+
+
+//QAD_PWM::getBreakState
+//QAD_PWM Advanced Timer Method
+//
+//Returns true if a break event has occurred and has not yet been cleared using clearBreak(), otherwise returns false
+bool QAD_PWM::getBreakState(void) {
+	if (!QAD_TimerMgr::getAdvanced(m_eTimer))
+		return false;
+
+	return (__HAL_TIM_GET_FLAG(&m_sHandle, TIM_FLAG_BREAK) != RESET);
+}
+
+
+//QAD_PWM::clearBreak
+//QAD_PWM Advanced Timer Method
+//
+//Clears a break event and re-enables the main and complementary outputs
+//Returns QA_OK if the break has been cleared, or QA_Fail if the break input is still active or the timer peripheral
+//is not an advanced-control timer
+QA_Result QAD_PWM::clearBreak(void) {
+	if (!QAD_TimerMgr::getAdvanced(m_eTimer))
+		return QA_Fail;
+
+	//Clear break flag. The flag will be set again immediately by hardware if the break input is still active
+	__HAL_TIM_CLEAR_FLAG(&m_sHandle, TIM_FLAG_BREAK);
+	if (__HAL_TIM_GET_FLAG(&m_sHandle, TIM_FLAG_BREAK) != RESET)
+		return QA_Fail;
+
+	//Re-enable outputs if driver is currently active
+	if (m_eState)
+		__HAL_TIM_MOE_ENABLE(&m_sHandle);
+
+	return QA_OK;
+}
+
+
+//QAD_PWM::getDeadTime
+//QAD_PWM Advanced Timer Method
+//
+//Returns the dead-time in nanoseconds that is actually being generated by the timer peripheral
+//This may be slightly longer than the dead-time requested in the initialization structure due to the resolution
+//of the timer's dead-time generator
+uint32_t QAD_PWM::getDeadTime(void) {
+	return m_uDeadTimeActual;
+}
+
+
   //--------------------------------------
   //--------------------------------------
   //QAD_PWM Private Initialization Methods
@@ -170,6 +293,28 @@ QA_Result QAD_PWM::periphInit(void) {
 			GPIO_Init.Alternate   = m_sChannels[i].uAF;  //Set alternate function to suit required timer peripheral
 			HAL_GPIO_Init(m_sChannels[i].pGPIO, &GPIO_Init);
 		}
+
+		//If complementary output is set to be active then initialize complementary GPIO pin
+		if (m_sChannels[i].eCompActive) {
+			GPIO_Init.Pin         = m_sChannels[i].uCompPin; //Set pin number
+			GPIO_Init.Alternate   = m_sChannels[i].uCompAF;  //Set alternate function to suit required timer peripheral
+			HAL_GPIO_Init(m_sChannels[i].pCompGPIO, &GPIO_Init);
+		}
+	}
+
+	//If break input is to be used then initialize break input GPIO pin
+	//Pull resistor is set to hold the break input in its inactive state if left unconnected
+	if (m_eBreakActive) {
+		GPIO_Init.Pin         = m_uBreakPin;
+		GPIO_Init.Pull        = (m_eBreakPolarity == QAD_PWM_BreakPolarity_High) ? GPIO_PULLDOWN : GPIO_PULLUP;
+		GPIO_Init.Alternate   = m_uBreakAF;
+		HAL_GPIO_Init(m_pBreakGPIO, &GPIO_Init);
+	}
+
+	//Calculate dead-time generator settings
+	if (calcDeadTime()) {
+		periphDeinit(DeinitPartial);
+		return QA_Fail;
 	}
 
 	//Enable Timer Clock
@@ -179,8 +324,8 @@ QA_Result QAD_PWM::periphInit(void) {
 	m_sHandle.Instance                     = QAD_TimerMgr::getInstance(m_eTimer);  //Set instance for required timer peripheral
 	m_sHandle.Init.Prescaler               = m_uPrescaler;                         //Set timer prescaler
 	m_sHandle.Init.Period                  = m_uPeriod;                            //Set timer counter period
-	m_sHandle.Init.CounterMode             = TIM_COUNTERMODE_UP;                   //Set counter mode to up
-	m_sHandle.Init.ClockDivision           = TIM_CLOCKDIVISION_DIV1;               //Unused
+	m_sHandle.Init.CounterMode             = getCounterMode();                     //Set counter mode
+	m_sHandle.Init.ClockDivision           = m_uClockDivision;                     //Set clock division used for dead-time generation
 	m_sHandle.Init.RepetitionCounter       = 0x0;                                  //
 	m_sHandle.Init.AutoReloadPreload       = TIM_AUTORELOAD_PRELOAD_ENABLE;        //Enable preload of the timer's auto-reload register
 
@@ -194,8 +339,9 @@ QA_Result QAD_PWM::periphInit(void) {
 	TIM_OC_InitTypeDef TIM_OC_Init;
 	//Iterate through number of channels supported by selected timer peripheral
 	for (uint8_t i=0; i<QAD_TimerMgr::getChannels(m_eTimer); i++) {
-		//If channel is set to active then initialize PWM channel
-		if (m_sChannels[i].eActive) {
+		//If either the main or complementary output of the channel is set to active then initialize PWM channel
+		//A channel using only its complementary output still requires its output compare mode to be configured
+		if ((m_sChannels[i].eActive) || (m_sChannels[i].eCompActive)) {
 			TIM_OC_Init = {0};
 			TIM_OC_Init.OCMode        = TIM_OCMODE_PWM1;        //Set Output Compare mode to PWM1
 			TIM_OC_Init.OCIdleState   = TIM_OCIDLESTATE_SET;    //Set Output Compare Idle State to Set
@@ -203,6 +349,14 @@ QA_Result QAD_PWM::periphInit(void) {
 			TIM_OC_Init.OCPolarity    = TIM_OCPOLARITY_HIGH;    //Set Output Compare Polarity to High
 			TIM_OC_Init.OCFastMode    = TIM_OCFAST_ENABLE;      //Enable Output Compare Fast Mode
 
+			//If complementary output is active then both outputs are set to idle low, so that neither side of a
+			//half-bridge is switched on while the main outputs are disabled
+			if (m_sChannels[i].eCompActive) {
+				TIM_OC_Init.OCIdleState   = TIM_OCIDLESTATE_RESET;  //Set Output Compare Idle State to Reset
+				TIM_OC_Init.OCNIdleState  = TIM_OCNIDLESTATE_RESET; //Set Complementary Output Compare Idle State to Reset
+				TIM_OC_Init.OCNPolarity   = TIM_OCNPOLARITY_HIGH;   //Set Complementary Output Compare Polarity to High
+			}
+
 			//Configure PWM Channel, performing a full deinitialization if the configuration fails
 			if (HAL_TIM_PWM_ConfigChannel(&m_sHandle, &TIM_OC_Init, m_uChannelSelect[i]) != HAL_OK) {
 				periphDeinit(DeinitFull);
@@ -211,6 +365,67 @@ QA_Result QAD_PWM::periphInit(void) {
 		}
 	}
 
+	//Init Trigger Output
+	if (m_eTrigger) {
+		TIM_MasterConfigTypeDef MC_Init = {0};
+		MC_Init.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+
+		if (m_eTrigger == QAD_PWM_Trigger_Update) {
+
+			//Trigger on update event
+			MC_Init.MasterOutputTrigger = TIM_TRGO_UPDATE;
+
+		} else {
+
+			//Trigger on rising edge of channel 4 reference signal
+			//For the valley, PWM1 mode with a compare value of 1 makes OC4REF rise as the counter reaches the bottom of the count
+			//For the peak, PWM2 mode with a compare value equal to the period makes OC4REF rise as the counter reaches the top
+			MC_Init.MasterOutputTrigger = TIM_TRGO_OC4REF;
+
+			TIM_OC_Init = {0};
+			TIM_OC_Init.OCMode        = (m_eTrigger == QAD_PWM_Trigger_Valley) ? TIM_OCMODE_PWM1 : TIM_OCMODE_PWM2;
+			TIM_OC_Init.Pulse         = (m_eTrigger == QAD_PWM_Trigger_Valley) ? 1 : m_uPeriod;
+			TIM_OC_Init.OCPolarity    = TIM_OCPOLARITY_HIGH;
+			TIM_OC_Init.OCFastMode    = TIM_OCFAST_DISABLE;
+			if (HAL_TIM_PWM_ConfigChannel(&m_sHandle, &TIM_OC_Init, TIM_CHANNEL_4) != HAL_OK) {
+				periphDeinit(DeinitFull);
+				return QA_Fail;
+			}
+		}
+
+		//Configure trigger output, performing a full deinitialization if the configuration fails
+		if (HAL_TIMEx_MasterConfigSynchronization(&m_sHandle, &MC_Init) != HAL_OK) {
+			periphDeinit(DeinitFull);
+			return QA_Fail;
+		}
+	}
+
+	//Init Dead-Time and Break Input
+	//Only available on advanced-control timers
+	if (QAD_TimerMgr::getAdvanced(m_eTimer)) {
+		bool bComp = false;
+		for (uint8_t i=0; i<QAD_TimerMgr::getChannels(m_eTimer); i++) {
+			if (m_sChannels[i].eCompActive)
+				bComp = true;
+		}
+
+		TIM_BreakDeadTimeConfigTypeDef TIM_BDT_Init = {0};
+		TIM_BDT_Init.OffStateRunMode  = bComp ? TIM_OSSR_ENABLE : TIM_OSSR_DISABLE;  //Drive outputs to inactive levels rather than releasing them
+		TIM_BDT_Init.OffStateIDLEMode = bComp ? TIM_OSSI_ENABLE : TIM_OSSI_DISABLE;  //when complementary outputs are in use
+		TIM_BDT_Init.LockLevel        = TIM_LOCKLEVEL_OFF;                            //
+		TIM_BDT_Init.DeadTime         = m_uDeadTimeGen;                               //Set encoded dead-time
+		TIM_BDT_Init.BreakState       = m_eBreakActive ? TIM_BREAK_ENABLE : TIM_BREAK_DISABLE;
+		TIM_BDT_Init.BreakPolarity    = (m_eBreakPolarity == QAD_PWM_BreakPolarity_High) ? TIM_BREAKPOLARITY_HIGH : TIM_BREAKPOLARITY_LOW;
+		TIM_BDT_Init.BreakFilter      = 0;                                            //
+		TIM_BDT_Init.AutomaticOutput  = m_eAutoOutput ? TIM_AUTOMATICOUTPUT_ENABLE : TIM_AUTOMATICOUTPUT_DISABLE;
+
+		//Configure dead-time and break input, performing a full deinitialization if the configuration fails
+		if (HAL_TIMEx_ConfigBreakDeadTime(&m_sHandle, &TIM_BDT_Init) != HAL_OK) {
+			periphDeinit(DeinitFull);
+			return QA_Fail;
+		}
+	}
+
 	//Set Driver States
 	m_eInitState = QA_Initialized; //Set driver state as initialized
 	m_eState     = QA_Inactive;    //Set driver as currently inactive
@@ -244,7 +459,11 @@ void QAD_PWM::periphDeinit(QAD_PWM::DeinitMode eDeinitMode) {
 	for (uint8_t i=0; i<QAD_TimerMgr::getChannels(m_eTimer); i++) {
 		if (m_sChannels[i].eActive)
 			HAL_GPIO_DeInit(m_sChannels[i].pGPIO, m_sChannels[i].uPin);
+		if (m_sChannels[i].eCompActive)
+			HAL_GPIO_DeInit(m_sChannels[i].pCompGPIO, m_sChannels[i].uCompPin);
 	}
+	if (m_eBreakActive)
+		HAL_GPIO_DeInit(m_pBreakGPIO, m_uBreakPin);
 
 	//Set Driver States
 	m_eState     = QA_Inactive;        //Set driver as currently inactive
@@ -252,13 +471,102 @@ void QAD_PWM::periphDeinit(QAD_PWM::DeinitMode eDeinitMode) {
 }
 
 
+  //---------------------
+  //---------------------
+  //QAD_PWM Tools Methods
 
+//QAD_PWM::getCounterMode
+//QAD_PWM Tools Method
+//
+//Returns the TIM_Counter_Mode define (as defined in stm32f4xx_hal_tim.h) for the selected counter mode
+uint32_t QAD_PWM::getCounterMode(void) {
+	switch (m_eCounterMode) {
+		case QAD_PWM_CounterMode_Center1:
+			return TIM_COUNTERMODE_CENTERALIGNED1;
+		case QAD_PWM_CounterMode_Center2:
+			return TIM_COUNTERMODE_CENTERALIGNED2;
+		case QAD_PWM_CounterMode_Center3:
+			return TIM_COUNTERMODE_CENTERALIGNED3;
+		default:
+			return TIM_COUNTERMODE_UP;
+	}
+}
 
 
+//QAD_PWM::checkAdvanced
+//QAD_PWM Tools Method
+//
+//Used to check that complementary outputs, dead-time and break input have only been requested when an advanced-control
+//timer is selected, and that complementary outputs have not been requested for channel 4, which has no CH4N output
+//Returns true if the requested configuration is supported, or false if not supported
+bool QAD_PWM::checkAdvanced(void) {
+
+	for (uint8_t i=0; i<QAD_PWM_CHANNEL_COUNT; i++) {
+		if (m_sChannels[i].eCompActive) {
+			if ((!QAD_TimerMgr::getAdvanced(m_eTimer)) || (i == QAD_PWM_Channel_4))
+				return false;
+		}
+	}
 
+	if ((m_uDeadTime || m_eBreakActive || m_eAutoOutput) && (!QAD_TimerMgr::getAdvanced(m_eTimer)))
+		return false;
 
+	return true;
+}
 
 
+//QAD_PWM::calcDeadTime
+//QAD_PWM Tools Method
+//
+//Used to convert the requested dead-time in nanoseconds into the timer's clock division and the encoded DTG bits of the
+//BDTR register. The smallest clock division able to produce the requested dead-time is used, in order to retain the
+//finest possible resolution. The dead-time is always rounded up so that it is never shorter than requested.
+//DTG encoding (in tDTS ticks):   0 -  127 : DTG[7:0] = t
+//                              128 -  254 : DTG[7:6] = 10b,  t = (64 + DTG[5:0]) * 2
+//                              256 -  504 : DTG[7:5] = 110b, t = (32 + DTG[4:0]) * 8
+//                              512 - 1008 : DTG[7:5] = 111b, t = (32 + DTG[4:0]) * 16
+//Returns QA_OK if successful, or QA_Fail if the requested dead-time is too long to be generated
+QA_Result QAD_PWM::calcDeadTime(void) {
+	const uint32_t uClockDivision[3] = {TIM_CLOCKDIVISION_DIV1, TIM_CLOCKDIVISION_DIV2, TIM_CLOCKDIVISION_DIV4};
+
+	m_uClockDivision  = TIM_CLOCKDIVISION_DIV1;
+	m_uDeadTimeGen    = 0;
+	m_uDeadTimeActual = 0;
+
+	if (!m_uDeadTime)
+		return QA_OK;
+
+	uint64_t uClock = QAD_TimerMgr::getClockSpeed(m_eTimer);
+
+	for (uint8_t i=0; i<3; i++) {
+		uint64_t uDiv   = 1000000000ULL << i;
+		uint32_t uTicks = (uint32_t)((((uint64_t)m_uDeadTime * uClock) + uDiv - 1) / uDiv);
+		uint32_t uActual;
+
+		if (uTicks <= 127) {
+			m_uDeadTimeGen = uTicks;
+			uActual        = uTicks;
+		} else if (uTicks <= 254) {
+			uActual        = (uTicks + 1) / 2;
+			m_uDeadTimeGen = 0x80 | (uActual - 64);
+			uActual       *= 2;
+		} else if (uTicks <= 504) {
+			uActual        = (uTicks + 7) / 8;
+			m_uDeadTimeGen = 0xC0 | (uActual - 32);
+			uActual       *= 8;
+		} else if (uTicks <= 1008) {
+			uActual        = (uTicks + 15) / 16;
+			m_uDeadTimeGen = 0xE0 | (uActual - 32);
+			uActual       *= 16;
+		} else {
+			continue;
+		}
 
+		m_uClockDivision  = uClockDivision[i];
+		m_uDeadTimeActual = (uint32_t)((((uint64_t)uActual << i) * 1000000000ULL) / uClock);
+		return QA_OK;
+	}
 
+	return QA_Fail;
+}
 
@@ -54,6 +54,46 @@ enum QAD_PWM_Channel : uint8_t {
 };
 
 
+//-------------------
+//QAD_PWM_CounterMode
+//
+//Enum used to select the counter mode of the timer peripheral
+//In the center-aligned modes the counter counts up to the period and then back down to zero, so the PWM frequency
+//is half that of edge-aligned (up) mode for the same prescaler and period. The center-aligned modes only differ in
+//when the channel compare interrupt flags are set (1 - downcounting, 2 - upcounting, 3 - both)
+enum QAD_PWM_CounterMode : uint8_t {
+	QAD_PWM_CounterMode_Up = 0,   //Edge-aligned mode, counting up
+	QAD_PWM_CounterMode_Center1,  //Center-aligned mode 1
+	QAD_PWM_CounterMode_Center2,  //Center-aligned mode 2
+	QAD_PWM_CounterMode_Center3   //Center-aligned mode 3
+};
+
+
+//---------------
+//QAD_PWM_Trigger
+//
+//Enum used to select when the timer peripheral generates its trigger output (TRGO), which can be used to trigger ADC conversions
+//QAD_PWM_Trigger_Valley and QAD_PWM_Trigger_Peak are only available in the center-aligned counter modes, and use channel 4
+//internally to generate the trigger, so channel 4 must not be set as active when either of these are selected
+enum QAD_PWM_Trigger : uint8_t {
+	QAD_PWM_Trigger_None = 0,     //No trigger output
+	QAD_PWM_Trigger_Update,       //Trigger output on every update event (both peak and valley in center-aligned modes)
+	QAD_PWM_Trigger_Valley,       //Trigger output when the counter reaches zero (center of the PWM low/off period)
+	QAD_PWM_Trigger_Peak          //Trigger output when the counter reaches the period (center of the PWM high/on period)
+};
+
+
+//---------------------
+//QAD_PWM_BreakPolarity
+//
+//Enum used to select the active level of the break input
+//Only supported by advanced-control timers (see QAD_TimerMgr::getAdvanced())
+enum QAD_PWM_BreakPolarity : uint8_t {
+	QAD_PWM_BreakPolarity_Low = 0,  //Break is triggered when break input is low
+	QAD_PWM_BreakPolarity_High      //Break is triggered when break input is high
+};
+
+
 //--------------------------
 //QAD_PWM_Channel_InitStruct
 //
@@ -67,6 +107,12 @@ typedef struct QAD_PWM_Channel_InitStruct {
 	uint16_t       uPin;     //Pin number to be used by this PWM channel
 	uint8_t        uAF;      //Alternate function used to connect the GPIO pin to the respective timer peripheral
 
+	QA_ActiveState eCompActive;  //Stores whether the complementary (CHxN) output of this channel is active
+	                             //Complementary outputs are only supported by advanced-control timers, and only on channels 1 to 3
+	GPIO_TypeDef*  pCompGPIO;    //GPIO port to be used by the complementary output of this PWM channel
+	uint16_t       uCompPin;     //Pin number to be used by the complementary output of this PWM channel
+	uint8_t        uCompAF;      //Alternate function used to connect the complementary GPIO pin to the respective timer peripheral
+
 
 	//Assignment operator definition to allow easy copying of channel data from QAD_PWM_InitStruct to
 	//members of m_sChannels array in QAD_PWM driver class
@@ -75,6 +121,11 @@ typedef struct QAD_PWM_Channel_InitStruct {
 		pGPIO     = other.pGPIO;
 		uPin      = other.uPin;
 		uAF       = other.uAF;
+
+		eCompActive = other.eCompActive;
+		pCompGPIO   = other.pCompGPIO;
+		uCompPin    = other.uCompPin;
+		uCompAF     = other.uCompAF;
 		return *this;
 	}
 
@@ -92,10 +143,32 @@ typedef struct {
 	uint32_t          uPrescaler;   //Prescaler to be used for the selected timer
 	uint32_t          uPeriod;      //Counter period to be used for the selected timer
 
+	uint32_t          uFrequency;   //Target PWM frequency in Hz. If non-zero then uPrescaler and uPeriod are ignored, and are instead
+	                                //calculated during init() to give the closest achievable frequency (see QAD_TimerMgr::calcFrequency())
+	uint32_t          uResolution;  //Minimum number of duty cycle steps required when uFrequency is used
+
+	QAD_PWM_CounterMode eCounterMode; //Counter mode to be used for the selected timer. Member of QAD_PWM_CounterMode
+	QAD_PWM_Trigger     eTrigger;     //Selects when the timer's trigger output (TRGO) is generated. Member of QAD_PWM_Trigger
+
 	QAD_PWM_Channel_InitStruct sChannels[QAD_PWM_CHANNEL_COUNT];  //Data for individual PWM channels
 	                                                              //Note that although four channels worth of init data can be supplied, the selected
 	                                                              //timer peripheral may support less than four channels
 
+	//The following members are only supported by advanced-control timers (see QAD_TimerMgr::getAdvanced()), and must be
+	//set to 0/QA_Inactive when any other timer peripheral is selected
+	uint32_t              uDeadTime;       //Dead-time in nanoseconds to be inserted between a channel's main and complementary outputs
+	                                       //This will be rounded up to the nearest dead-time the timer peripheral is able to generate
+
+	QA_ActiveState        eBreakActive;    //Stores whether the break input is to be used for hardware shutdown of the PWM outputs
+	GPIO_TypeDef*         pBreakGPIO;      //GPIO port to be used by the break input
+	uint16_t              uBreakPin;       //Pin number to be used by the break input
+	uint8_t               uBreakAF;        //Alternate function used to connect the break input GPIO pin to the timer peripheral
+	QAD_PWM_BreakPolarity eBreakPolarity;  //Active level of the break input. Member of QAD_PWM_BreakPolarity
+
+	QA_ActiveState        eAutoOutput;     //Set to QA_Active to allow the main outputs to be re-enabled automatically on the next
+	                                       //update event once the break input is no longer active. If set to QA_Inactive
+	                                       //then clearBreak() must be called to re-enable the outputs after a break
+
 } QAD_PWM_InitStruct;
 
 
@@ -128,11 +201,30 @@ private:
   uint32_t           m_uPrescaler;  //Prescaler to be used for selected timer
   uint32_t           m_uPeriod;     //Counter period to be used for selected timer
 
+  uint32_t           m_uFrequency;  //Target PWM frequency in Hz, or 0 if m_uPrescaler and m_uPeriod are to be used directly
+  uint32_t           m_uResolution; //Minimum number of duty cycle steps required when m_uFrequency is used
+  uint32_t           m_uDutyScale;  //Compare value equal to 100% duty cycle, used by setDuty(). Limited to the compare register's range
+
+  QAD_PWM_CounterMode m_eCounterMode; //Counter mode to be used for selected timer
+  QAD_PWM_Trigger     m_eTrigger;     //Trigger output (TRGO) mode to be used for selected timer
+
   QAD_PWM_Channel_InitStruct m_sChannels[QAD_PWM_CHANNEL_COUNT];  //Array of channel specific data
                                                                   //See QAD_PWM_Channel_InitStruct for more details
 
   uint32_t           m_uChannelSelect[QAD_PWM_CHANNEL_COUNT];     //Array used to select TIM_Channel defines as defined in stm32f4xx_hal_tim.h
 
+  uint32_t              m_uDeadTime;       //Requested dead-time in nanoseconds
+  uint32_t              m_uDeadTimeActual; //Dead-time in nanoseconds actually generated by the timer peripheral, once initialized
+  uint32_t              m_uClockDivision;  //TIM_ClockDivision define used to generate the dead-time clock (tDTS)
+  uint8_t               m_uDeadTimeGen;    //Encoded value for DTG bits of timer peripheral's BDTR register
+
+  QA_ActiveState        m_eBreakActive;    //Stores whether the break input is being used
+  GPIO_TypeDef*         m_pBreakGPIO;      //GPIO port used by the break input
+  uint16_t              m_uBreakPin;       //Pin number used by the break input
+  uint8_t               m_uBreakAF;        //Alternate function used by the break input
+  QAD_PWM_BreakPolarity m_eBreakPolarity;  //Active level of the break input
+  QA_ActiveState        m_eAutoOutput;     //Stores whether automatic output enable is used
+
 public:
 
   //--------------------------
@@ -146,7 +238,22 @@ public:
 		m_eTimer(sInit.eTimer),
 		m_sHandle({0}),
 		m_uPrescaler(sInit.uPrescaler),
-		m_uPeriod(sInit.uPeriod) {
+		m_uPeriod(sInit.uPeriod),
+		m_uFrequency(sInit.uFrequency),
+		m_uResolution(sInit.uResolution),
+		m_uDutyScale(0),
+		m_eCounterMode(sInit.eCounterMode),
+		m_eTrigger(sInit.eTrigger),
+		m_uDeadTime(sInit.uDeadTime),
+		m_uDeadTimeActual(0),
+		m_uClockDivision(TIM_CLOCKDIVISION_DIV1),
+		m_uDeadTimeGen(0),
+		m_eBreakActive(sInit.eBreakActive),
+		m_pBreakGPIO(sInit.pBreakGPIO),
+		m_uBreakPin(sInit.uBreakPin),
+		m_uBreakAF(sInit.uBreakAF),
+		m_eBreakPolarity(sInit.eBreakPolarity),
+		m_eAutoOutput(sInit.eAutoOutput) {
 
   	//Copy channel specific data from initialization structure to m_sChannels array in QAD_PWM class
   	for (uint8_t i=0; i<QAD_PWM_CHANNEL_COUNT; i++) {
@@ -187,9 +294,44 @@ public:
   void start(void);
   void stop(void);
 
-  void setPWMVal(QAD_PWM_Channel eChannel, uint16_t uVal);
+  void setPWMVal(QAD_PWM_Channel eChannel, uint32_t uVal);
+
+  //Sets the duty cycle for a specific channel
+  //eChannel - The PWM channel to set the duty cycle for. A member of QAD_PWM_Channel
+  //uDuty    - Duty cycle in Q16 format, where 0x10000 is 100%. Values above 0x10000 are clamped to 100%
+  void setDuty(QAD_PWM_Channel eChannel, uint32_t uDuty) {
+  	if (eChannel >= QAD_TimerMgr::getChannels(m_eTimer))
+  		return;
+  	if (uDuty > 0x10000)
+  		uDuty = 0x10000;
+  	__HAL_TIM_SET_COMPARE(&m_sHandle, m_uChannelSelect[eChannel], (uint32_t)(((uint64_t)uDuty * m_uDutyScale) >> 16));
+  }
+
+  //Prevents update events, so that new compare values written while the update is held are not transferred from the
+  //preload registers until releaseUpdate() is called. Used to make sure multiple channels change within the same PWM period
+  void holdUpdate(void) {
+  	m_sHandle.Instance->CR1 |= TIM_CR1_UDIS;
+  }
+
+  //Allows update events again following a call to holdUpdate()
+  void releaseUpdate(void) {
+  	m_sHandle.Instance->CR1 &= ~TIM_CR1_UDIS;
+  }
 
-  uint16_t getPeriod(void);
+  uint32_t getPeriod(void);
+  uint32_t getFrequency(void);
+
+
+  //----------------------
+  //Advanced Timer Methods
+
+  void enableOutputs(void);
+  void disableOutputs(void);
+
+  bool getBreakState(void);
+  QA_Result clearBreak(void);
+
+  uint32_t getDeadTime(void);
 
 private:
 
@@ -199,6 +341,14 @@ private:
   QA_Result periphInit(void);
   void periphDeinit(DeinitMode eDeinitMode);
 
+
+  //-------------
+  //Tools Methods
+
+  uint32_t getCounterMode(void);
+  bool checkAdvanced(void);
+  QA_Result calcDeadTime(void);
+
 };
 
 
@@ -0,0 +1,126 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Drivers                                                       */
+/*   Role: DMA Management Driver                                           */
+/*   Filename: QAD_DMAMgr.cpp                                              */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAD_DMAMgr.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //-----------------------
+  //-----------------------
+	//QAD_DMAMgr Constructors
+
+//QAD_DMAMgr::QAD_DMAMgr
+//QAD_DMAMgr Constructor
+//
+//As this is a private method in a singleton class, this method will be called the first time the class's get() method is called
+QAD_DMAMgr::QAD_DMAMgr() {
+	for (uint8_t i=0; i<QAD_DMA_StreamCountTotal; i++)
+		m_eStreams[i] = QAD_DMA_Unused;
+}
+
+
+  //-----------------------
+  //-----------------------
+  //QAD_DMAMgr Data Methods
+
+//QAD_DMAMgr::imp_getState
+//QAD_DMAMgr Data Method
+//
+//To be called from static method getState()
+QAD_DMA_State QAD_DMAMgr::imp_getState(DMA_Stream_TypeDef* pStream) {
+	int8_t iIdx = imp_findStream(pStream);
+	if (iIdx < 0)
+		return QAD_DMA_Unused;
+	return m_eStreams[iIdx];
+}
+
+
+  //-----------------------------
+  //-----------------------------
+  //QAD_DMAMgr Management Methods
+
+//QAD_DMAMgr::imp_registerStream
+//QAD_DMAMgr Management Method
+//
+//To be called from static method registerStream()
+//The check and claim are made with interrupts disabled, so a stream cannot be claimed by two drivers at once
+//pStream - The DMA stream to be registered
+//eState  - The purpose the stream is to be used for. A member of QAD_DMA_State other than QAD_DMA_Unused
+//Returns QA_OK if registration is successful.
+//        QA_Fail if the stream is not a DMA1 or DMA2 stream, or eState is set to QAD_DMA_Unused.
+//        QA_Error_PeriphBusy if the stream is already in use
+QA_Result QAD_DMAMgr::imp_registerStream(DMA_Stream_TypeDef* pStream, QAD_DMA_State eState) {
+	int8_t iIdx = imp_findStream(pStream);
+	if ((iIdx < 0) || (!eState))
+		return QA_Fail;
+
+	QA_Result eRes = QA_OK;
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	if (m_eStreams[iIdx])
+		eRes = QA_Error_PeriphBusy; else
+		m_eStreams[iIdx] = eState;
+	__set_PRIMASK(uPRIMASK);
+	return eRes;
+}
+
+
+//QAD_DMAMgr::imp_deregisterStream
+//QAD_DMAMgr Management Method
+//
+//To be called from static method deregisterStream()
+//pStream - The DMA stream to be deregistered
+//eState  - The purpose the stream was registered for. The stream is only released if its state matches
+void QAD_DMAMgr::imp_deregisterStream(DMA_Stream_TypeDef* pStream, QAD_DMA_State eState) {
+	int8_t iIdx = imp_findStream(pStream);
+	if (iIdx < 0)
+		return;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	if (m_eStreams[iIdx] == eState)
+		m_eStreams[iIdx] = QAD_DMA_Unused;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+  //------------------------
+  //------------------------
+  //QAD_DMAMgr Tools Methods
+
+//QAD_DMAMgr::imp_findStream
+//QAD_DMAMgr Tools Method
+//
+//Returns the index of a DMA stream in the stream array (DMA1 streams 0 to 7, then DMA2 streams 0 to 7), or -1 if the
+//stream is not a DMA1 or DMA2 stream
+int8_t QAD_DMAMgr::imp_findStream(DMA_Stream_TypeDef* pStream) {
+	static DMA_Stream_TypeDef* const pStreams[QAD_DMA_StreamCountTotal] = {
+		DMA1_Stream0, DMA1_Stream1, DMA1_Stream2, DMA1_Stream3, DMA1_Stream4, DMA1_Stream5, DMA1_Stream6, DMA1_Stream7,
+		DMA2_Stream0, DMA2_Stream1, DMA2_Stream2, DMA2_Stream3, DMA2_Stream4, DMA2_Stream5, DMA2_Stream6, DMA2_Stream7
+	};
+
+	for (uint8_t i=0; i<QAD_DMA_StreamCountTotal; i++) {
+		if (pStreams[i] == pStream)
+			return i;
+	}
+	return -1;
+}
@@ -0,0 +1,150 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Drivers                                                       */
+/*   Role: DMA Management Driver                                           */
+/*   Filename: QAD_DMAMgr.hpp                                              */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAD_DMAMGR_HPP_
+#define __QAD_DMAMGR_HPP_
+
+//Includes
+#include "setup.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//-------------------
+//QAD_DMA_StreamCount
+//
+//Number of DMA streams on each DMA controller, and total number of DMA streams managed
+const uint8_t QAD_DMA_StreamCount      = 8;
+const uint8_t QAD_DMA_StreamCountTotal = QAD_DMA_StreamCount * 2;
+
+
+//-------------
+//QAD_DMA_State
+//
+//Used to store whether a particular DMA stream is in use or not, and what purpose it is being used for
+enum QAD_DMA_State : uint8_t {
+	QAD_DMA_Unused = 0,
+	QAD_DMA_InUse_SPI,
+	QAD_DMA_InUse_ADC,
+	QAD_DMA_InUse_ServoSeq
+};
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//----------
+//QAD_DMAMgr
+//
+//Singleton class
+//Used to allow management of DMA streams in order to make sure that a driver is prevented from using a DMA stream
+//that is already being used by another driver
+//
+//NOTE: A stream is only marked as in use. A driver that fails to register a stream must not configure or enable it,
+//and must not deregister it, so deregisterStream() only releases a stream that is registered for the given purpose
+class QAD_DMAMgr {
+private:
+
+	//Stream Data (DMA1 streams 0 to 7, followed by DMA2 streams 0 to 7)
+	QAD_DMA_State  m_eStreams[QAD_DMA_StreamCountTotal];
+
+	//------------
+	//Constructors
+	QAD_DMAMgr();
+
+public:
+
+	//------------------------------------------------------------------------------
+	//Delete copy constructor and assignment operator due to being a singleton class
+	QAD_DMAMgr(const QAD_DMAMgr& other) = delete;
+	QAD_DMAMgr& operator=(const QAD_DMAMgr& other) = delete;
+
+
+	//-----------------
+	//Singleton Methods
+	//
+	//Used to retrieve a reference to the singleton class
+	static QAD_DMAMgr& get(void) {
+		static QAD_DMAMgr instance;
+		return instance;
+	}
+
+
+	//------------
+  //Data Methods
+
+	//Used to retrieve the current state of a DMA stream
+	//pStream - The DMA stream to retrieve the state for (e.g. DMA2_Stream3)
+	//Returns member of QAD_DMA_State enum. Invalid streams are returned as QAD_DMA_Unused
+	static QAD_DMA_State getState(DMA_Stream_TypeDef* pStream) {
+		return get().imp_getState(pStream);
+	}
+
+
+	//------------------
+	//Management Methods
+
+	//Used to register a DMA stream as being used by a driver
+	//pStream - The DMA stream to be registered (e.g. DMA2_Stream3)
+	//eState  - The purpose the stream is to be used for. Member of QAD_DMA_State
+	//Returns QA_OK if registration is successful, QA_Fail if the stream or state is invalid, or QA_Error_PeriphBusy if the
+	//stream is already in use
+	static QA_Result registerStream(DMA_Stream_TypeDef* pStream, QAD_DMA_State eState) {
+		return get().imp_registerStream(pStream, eState);
+	}
+
+	//Used to deregister a DMA stream to mark it as no longer being used by a driver
+	//pStream - The DMA stream to be deregistered
+	//eState  - The purpose the stream was registered for. The stream is left registered if it is being used for another purpose
+	static void deregisterStream(DMA_Stream_TypeDef* pStream, QAD_DMA_State eState) {
+		get().imp_deregisterStream(pStream, eState);
+	}
+
+
+private:
+
+	//NOTE: See QAD_DMAMgr.cpp for details of the following methods
+
+	//------------
+	//Data Methods
+
+	QAD_DMA_State imp_getState(DMA_Stream_TypeDef* pStream);
+
+
+	//------------------
+	//Management Methods
+
+	QA_Result imp_registerStream(DMA_Stream_TypeDef* pStream, QAD_DMA_State eState);
+	void imp_deregisterStream(DMA_Stream_TypeDef* pStream, QAD_DMA_State eState);
+
+
+	//-------------
+	//Tools Methods
+
+	int8_t imp_findStream(DMA_Stream_TypeDef* pStream);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAD_DMAMGR_HPP_ */
@@ -35,6 +35,8 @@ QAD_SPIMgr::QAD_SPIMgr() {
 	for (uint8_t i=0; i<QAD_SPI_PeriphCount; i++) {
 		m_sSPIs[i].eState = QAD_SPI_Unused;
 		m_sSPIs[i].bI2S   = true;
+		m_sSPIs[i].pDMAHandler = NULL;
+		m_sSPIs[i].pDMAData    = NULL;
 	}
 
 	//Set SPI Periph ID
@@ -58,6 +60,39 @@ QAD_SPIMgr::QAD_SPIMgr() {
   m_sSPIs[QAD_SPI4].eIRQ = SPI4_IRQn;
   m_sSPIs[QAD_SPI5].eIRQ = SPI5_IRQn;
 
+	//Set DMA Streams
+  imp_setDMAStream(m_sSPIs[QAD_SPI1].sDMARX, DMA2, DMA2_Stream2, 2, DMA_CHANNEL_3, DMA2_Stream2_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI1].sDMATX, DMA2, DMA2_Stream5, 5, DMA_CHANNEL_3, DMA2_Stream5_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI2].sDMARX, DMA1, DMA1_Stream3, 3, DMA_CHANNEL_0, DMA1_Stream3_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI2].sDMATX, DMA1, DMA1_Stream4, 4, DMA_CHANNEL_0, DMA1_Stream4_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI3].sDMARX, DMA1, DMA1_Stream0, 0, DMA_CHANNEL_0, DMA1_Stream0_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI3].sDMATX, DMA1, DMA1_Stream5, 5, DMA_CHANNEL_0, DMA1_Stream5_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI4].sDMARX, DMA2, DMA2_Stream3, 3, DMA_CHANNEL_5, DMA2_Stream3_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI4].sDMATX, DMA2, DMA2_Stream4, 4, DMA_CHANNEL_5, DMA2_Stream4_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI5].sDMARX, DMA2, DMA2_Stream3, 3, DMA_CHANNEL_2, DMA2_Stream3_IRQn);
+  imp_setDMAStream(m_sSPIs[QAD_SPI5].sDMATX, DMA2, DMA2_Stream4, 4, DMA_CHANNEL_2, DMA2_Stream4_IRQn);
+
+}
+
+
+//---------------------------------
+//---------------------------------
+//QAD_SPIMgr Initialization Methods
+
+//QAD_SPIMgr::imp_setDMAStream
+//QAD_SPIMgr Initialization Method
+//
+//Fills in the data for a DMA stream. Streams 0 to 3 have their flags in LISR/LIFCR and streams 4 to 7 in HISR/HIFCR,
+//at bit positions 0, 6, 16 and 22 respectively
+void QAD_SPIMgr::imp_setDMAStream(QAD_SPI_DMAStream& sDMA, DMA_TypeDef* pDMA, DMA_Stream_TypeDef* pStream, uint8_t uStream, uint32_t uChannel, IRQn_Type eIRQ) {
+	const uint8_t uShifts[4] = {0, 6, 16, 22};
+
+	sDMA.pDMA       = pDMA;
+	sDMA.pStream    = pStream;
+	sDMA.uChannel   = uChannel;
+	sDMA.eIRQ       = eIRQ;
+	sDMA.uFlagShift = uShifts[uStream & 0x03];
+	sDMA.bFlagHigh  = (uStream >= 4);
 }
 
 
@@ -92,6 +127,75 @@ void QAD_SPIMgr::imp_deregisterSPI(QAD_SPI_Periph eSPI) {
 }
 
 
+//QAD_SPIMgr::imp_registerDMA
+//QAD_SPIMgr Management Method
+//
+//Claims the RX and TX DMA streams of an SPI peripheral through QAD_DMAMgr, setting the function to be called from their interrupts
+//Returns QA_OK if successful, QA_Fail if the peripheral or handler is invalid, or QA_Error_PeriphBusy if the streams are already
+//claimed or either stream is in use by another driver (SPI4 and SPI5 share DMA2 Stream3 and Stream4, and QAD_ServoSeq uses
+//DMA2 Stream3 in DMA mode)
+QA_Result QAD_SPIMgr::imp_registerDMA(QAD_SPI_Periph eSPI, QAD_IRQHandler_CallbackFunction pHandler, void* pData) {
+	if ((eSPI >= QAD_SPINone) || (!pHandler))
+		return QA_Fail;
+
+	QAD_SPI_Data& sSPI = m_sSPIs[eSPI];
+	if (sSPI.pDMAHandler)
+		return QA_Error_PeriphBusy;
+
+	QA_Result eRes = QAD_DMAMgr::registerStream(sSPI.sDMARX.pStream, QAD_DMA_InUse_SPI);
+	if (eRes)
+		return eRes;
+
+	eRes = QAD_DMAMgr::registerStream(sSPI.sDMATX.pStream, QAD_DMA_InUse_SPI);
+	if (eRes) {
+		QAD_DMAMgr::deregisterStream(sSPI.sDMARX.pStream, QAD_DMA_InUse_SPI);
+		return eRes;
+	}
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	sSPI.pDMAHandler = pHandler;
+	sSPI.pDMAData    = pData;
+	__set_PRIMASK(uPRIMASK);
+	return QA_OK;
+}
+
+
+//QAD_SPIMgr::imp_deregisterDMA
+//QAD_SPIMgr Management Method
+//Releases the DMA streams of an SPI peripheral, if they have been claimed with imp_registerDMA()
+void QAD_SPIMgr::imp_deregisterDMA(QAD_SPI_Periph eSPI) {
+	if ((eSPI >= QAD_SPINone) || (!m_sSPIs[eSPI].pDMAHandler))
+		return;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_sSPIs[eSPI].pDMAHandler = NULL;
+	m_sSPIs[eSPI].pDMAData    = NULL;
+	__set_PRIMASK(uPRIMASK);
+
+	QAD_DMAMgr::deregisterStream(m_sSPIs[eSPI].sDMARX.pStream, QAD_DMA_InUse_SPI);
+	QAD_DMAMgr::deregisterStream(m_sSPIs[eSPI].sDMATX.pStream, QAD_DMA_InUse_SPI);
+}
+
+
+//------------------------------
+//------------------------------
+//QAD_SPIMgr IRQ Handler Methods
+
+//QAD_SPIMgr::imp_handlerDMA
+//QAD_SPIMgr IRQ Handler Method
+//
+//Passes a DMA stream interrupt to the driver that has claimed the SPI peripheral's DMA streams, if any
+void QAD_SPIMgr::imp_handlerDMA(QAD_SPI_Periph eSPI) {
+	if (eSPI >= QAD_SPINone)
+		return;
+
+	if (m_sSPIs[eSPI].pDMAHandler)
+		m_sSPIs[eSPI].pDMAHandler(m_sSPIs[eSPI].pDMAData);
+}
+
+
 //------------------------
 //------------------------
 //QAD_SPIMgr Clock Methods
@@ -156,6 +260,39 @@ void QAD_SPIMgr::imp_disableClock(QAD_SPI_Periph eSPI) {
 }
 
 
+//QAD_SPIMgr::imp_resetPeriph
+//QAD_SPIMgr Clock Method
+//
+//Resets the SPI peripheral through RCC, returning all of its registers to their reset values
+//This is the only way to discard data already loaded into the peripheral's TX buffer
+void QAD_SPIMgr::imp_resetPeriph(QAD_SPI_Periph eSPI) {
+	switch (eSPI) {
+		case (QAD_SPI1):
+			__HAL_RCC_SPI1_FORCE_RESET();
+			__HAL_RCC_SPI1_RELEASE_RESET();
+			break;
+		case (QAD_SPI2):
+			__HAL_RCC_SPI2_FORCE_RESET();
+			__HAL_RCC_SPI2_RELEASE_RESET();
+			break;
+		case (QAD_SPI3):
+			__HAL_RCC_SPI3_FORCE_RESET();
+			__HAL_RCC_SPI3_RELEASE_RESET();
+			break;
+		case (QAD_SPI4):
+			__HAL_RCC_SPI4_FORCE_RESET();
+			__HAL_RCC_SPI4_RELEASE_RESET();
+			break;
+		case (QAD_SPI5):
+			__HAL_RCC_SPI5_FORCE_RESET();
+			__HAL_RCC_SPI5_RELEASE_RESET();
+			break;
+		case (QAD_SPINone):
+			break;
+	}
+}
+
+
 //-------------------------
 //-------------------------
 //QAD_SPIMgr Status Methods
@@ -22,6 +22,8 @@
 //Includes
 #include "setup.hpp"
 
+#include "QAD_DMAMgr.hpp"
+
 
 	//------------------------------------------
 	//------------------------------------------
@@ -58,6 +60,35 @@ enum QAD_SPI_State : uint8_t {
 	//------------------------------------------
 
 
+//-----------------
+//QAD_SPI_DMAStream
+//
+//Describes a DMA stream used for SPI transfers
+typedef struct {
+
+	DMA_TypeDef*        pDMA;        //DMA controller (DMA1 or DMA2)
+	DMA_Stream_TypeDef* pStream;     //DMA stream
+	uint32_t            uChannel;    //DMA channel selection, as a DMA_CHANNEL_x value from stm32f4xx_hal_dma.h
+	IRQn_Type           eIRQ;        //DMA stream IRQ
+	uint8_t             uFlagShift;  //Bit position of the stream's flags within the LISR/HISR and LIFCR/HIFCR registers
+	bool                bFlagHigh;   //true if the stream's flags are in HISR/HIFCR (streams 4 to 7)
+
+} QAD_SPI_DMAStream;
+
+
+//NOTE: DMA streams are mapped as follows. DMA2 Stream0 is avoided as it is used by QAD_ADC.
+//SPI4 and SPI5 share DMA2 Stream3 and Stream4, so only one of them can perform asynchronous transfers at a time. A driver claims
+//its streams with registerDMA(), which registers them with QAD_DMAMgr and fails if either stream is already in use by another SPI
+//peripheral or another driver (e.g. QAD_ServoSeq in DMA mode uses DMA2 Stream3). The DMA stream IRQ handlers in
+//Core/handlers.cpp call handlerDMA() for the SPI peripherals that map to their stream, which passes the interrupt to the driver
+//holding the stream
+//  SPI1 - RX: DMA2 Stream2 Channel3, TX: DMA2 Stream5 Channel3
+//  SPI2 - RX: DMA1 Stream3 Channel0, TX: DMA1 Stream4 Channel0
+//  SPI3 - RX: DMA1 Stream0 Channel0, TX: DMA1 Stream5 Channel0
+//  SPI4 - RX: DMA2 Stream3 Channel5, TX: DMA2 Stream4 Channel5
+//  SPI5 - RX: DMA2 Stream3 Channel2, TX: DMA2 Stream4 Channel2
+
+
 //------------
 //QAD_SPI_Data
 typedef struct {
@@ -72,6 +103,14 @@ typedef struct {
 
 	bool               bI2S;
 
+	QAD_SPI_DMAStream  sDMARX;
+
+	QAD_SPI_DMAStream  sDMATX;
+
+	QAD_IRQHandler_CallbackFunction pDMAHandler;  //Function to be called from the DMA stream interrupts, or NULL if the streams are not claimed
+
+	void*              pDMAData;                  //Data pointer passed to pDMAHandler
+
 } QAD_SPI_Data;
 
 
@@ -147,6 +186,22 @@ public:
 	}
 
 
+	static const QAD_SPI_DMAStream* getDMARX(QAD_SPI_Periph eSPI) {
+		if (eSPI >= QAD_SPINone)
+			return NULL;
+
+		return &get().m_sSPIs[eSPI].sDMARX;
+	}
+
+
+	static const QAD_SPI_DMAStream* getDMATX(QAD_SPI_Periph eSPI) {
+		if (eSPI >= QAD_SPINone)
+			return NULL;
+
+		return &get().m_sSPIs[eSPI].sDMATX;
+	}
+
+
 	//------------------
 	//Management Methods
 
@@ -158,6 +213,23 @@ public:
 		get().imp_deregisterSPI(eSPI);
 	}
 
+	static QA_Result registerDMA(QAD_SPI_Periph eSPI, QAD_IRQHandler_CallbackFunction pHandler, void* pData) {
+		return get().imp_registerDMA(eSPI, pHandler, pData);
+	}
+
+	static void deregisterDMA(QAD_SPI_Periph eSPI) {
+		get().imp_deregisterDMA(eSPI);
+	}
+
+
+	//-------------------
+	//IRQ Handler Methods
+
+	//To be called from the IRQ handlers of the DMA streams used by the SPI peripheral (see NOTE above)
+	static void handlerDMA(QAD_SPI_Periph eSPI) {
+		get().imp_handlerDMA(eSPI);
+	}
+
 
 	//-------------
 	//Clock Methods
@@ -170,6 +242,10 @@ public:
 		get().imp_disableClock(eSPI);
 	}
 
+	static void resetPeriph(QAD_SPI_Periph eSPI) {
+		get().imp_resetPeriph(eSPI);
+	}
+
 
 	//--------------
 	//Status Methods
@@ -184,16 +260,29 @@ public:
 
 private:
 
+	//----------------------
+	//Initialization Methods
+	void imp_setDMAStream(QAD_SPI_DMAStream& sDMA, DMA_TypeDef* pDMA, DMA_Stream_TypeDef* pStream, uint8_t uStream, uint32_t uChannel, IRQn_Type eIRQ);
+
+
 	//------------------
 	//Management Methods
 	QA_Result imp_registerSPI(QAD_SPI_Periph eSPI, QAD_SPI_State eState);
 	void imp_deregisterSPI(QAD_SPI_Periph eSPI);
+	QA_Result imp_registerDMA(QAD_SPI_Periph eSPI, QAD_IRQHandler_CallbackFunction pHandler, void* pData);
+	void imp_deregisterDMA(QAD_SPI_Periph eSPI);
+
+
+	//-------------------
+	//IRQ Handler Methods
+	void imp_handlerDMA(QAD_SPI_Periph eSPI);
 
 
 	//-------------
 	//Clock Methods
 	void imp_enableClock(QAD_SPI_Periph eSPI);
 	void imp_disableClock(QAD_SPI_Periph eSPI);
+	void imp_resetPeriph(QAD_SPI_Periph eSPI);
 
 
 	//--------------
@@ -36,9 +36,10 @@
 QAD_TimerMgr::QAD_TimerMgr() {
 
   for (uint8_t i=0; i < QAD_Timer_PeriphCount; i++) {
-  	m_sTimers[i].eState   = QAD_Timer_Unused;
-  	m_sTimers[i].bEncoder = (i < QAD_Timer9);
-  	m_sTimers[i].bADC     = ((i == QAD_Timer2) || (i == QAD_Timer3));
+  	m_sTimers[i].eState    = QAD_Timer_Unused;
+  	m_sTimers[i].bEncoder  = (i < QAD_Timer9);
+  	m_sTimers[i].bADC      = ((i == QAD_Timer2) || (i == QAD_Timer3));
+  	m_sTimers[i].bAdvanced = (i == QAD_Timer1);
   }
 
   //Set Timer Periph ID
@@ -101,6 +102,16 @@ QAD_TimerMgr::QAD_TimerMgr() {
 	m_sTimers[QAD_Timer10].eIRQ_Update = TIM1_UP_TIM10_IRQn;
 	m_sTimers[QAD_Timer11].eIRQ_Update = TIM1_TRG_COM_TIM11_IRQn;
 
+	//Set Capture/Compare IRQs
+	m_sTimers[QAD_Timer1].eIRQ_CC      = TIM1_CC_IRQn;
+	m_sTimers[QAD_Timer2].eIRQ_CC      = TIM2_IRQn;
+	m_sTimers[QAD_Timer3].eIRQ_CC      = TIM3_IRQn;
+	m_sTimers[QAD_Timer4].eIRQ_CC      = TIM4_IRQn;
+	m_sTimers[QAD_Timer5].eIRQ_CC      = TIM5_IRQn;
+	m_sTimers[QAD_Timer9].eIRQ_CC      = TIM1_BRK_TIM9_IRQn;
+	m_sTimers[QAD_Timer10].eIRQ_CC     = TIM1_UP_TIM10_IRQn;
+	m_sTimers[QAD_Timer11].eIRQ_CC     = TIM1_TRG_COM_TIM11_IRQn;
+
 }
 
 
@@ -119,6 +130,7 @@ QAD_TimerMgr::QAD_TimerMgr() {
 //         QAD_Timer_InUse_Encoder - Specifies timer as being used in rotary encoder mode
 //         QAD_Timer_InUse_PWM     - Specifies timer as being used to generate PWM signals
 //         QAD_Timer_InUse_ADC     - Specifies timer as being used to trigger ADC conversions
+//         QAD_Timer_InUse_ServoSeq - Specifies timer as being used to sequence multiple servo pulses
 //Returns QA_OK if registration is successful.
 //        QA_Fail if eState is set to QAD_Timer_Unused.
 //        QA_Error_PeriphBusy if selected Timer is already in use
@@ -292,6 +304,85 @@ void QAD_TimerMgr::imp_disableClock(QAD_Timer_Periph eTimer) {
 }
 
 
+  //--------------------------------
+  //--------------------------------
+  //QAD_TimerMgr Calculation Methods
+
+//QAD_TimerMgr::imp_calcFrequency
+//QAD_TimerMgr Calculation Method
+//
+//To be called by calcFrequency()
+//Searches each usable prescaler for the period giving the smallest frequency error, preferring the smallest prescaler
+//(and therefore the largest period) where two combinations give the same error. The search stops early on an exact match.
+//In center-aligned counter modes the counter period is 2*ARR clocks, rather than ARR+1 clocks in edge-aligned mode.
+//eTimer         - The Timer peripheral to calculate the values for. Member of QAD_Timer_Periph
+//uFrequency     - The target frequency in Hz
+//uResolution    - The minimum number of counts per period
+//bCenterAligned - Set to true if the timer is to be used in a center-aligned counter mode
+//uPrescaler     - Set to the calculated value for the timer's prescaler register
+//uPeriod        - Set to the calculated value for the timer's auto-reload (period) register
+//Returns QA_OK if successful, or QA_Fail if the target frequency cannot be achieved with the requested resolution
+QA_Result QAD_TimerMgr::imp_calcFrequency(QAD_Timer_Periph eTimer, uint32_t uFrequency, uint32_t uResolution, bool bCenterAligned,
+		                                      uint32_t& uPrescaler, uint32_t& uPeriod) {
+
+	if ((eTimer >= QAD_TimerNone) || (!uFrequency))
+		return QA_Fail;
+
+	if (uResolution < 2)
+		uResolution = 2;
+
+	//Number of timer input clocks per counter clock tick for the target frequency
+	//In center-aligned mode one period takes two counter ticks per count
+	uint64_t uClock     = m_sTimers[eTimer].uClockSpeed;
+	uint64_t uTarget    = (uint64_t)uFrequency * (bCenterAligned ? 2 : 1);
+	uint64_t uTotal     = (uClock + (uTarget / 2)) / uTarget;
+	uint64_t uMaxCounts = (m_sTimers[eTimer].eType == QAD_Timer_32bit) ? 0x100000000ULL : 0x10000ULL;
+	if (bCenterAligned)
+		uMaxCounts--;
+
+	//Determine range of prescalers to be searched
+	uint64_t uPSCMin = (uTotal + uMaxCounts - 1) / uMaxCounts;
+	uint64_t uPSCMax = uTotal / uResolution;
+	if (uPSCMin < 1)
+		uPSCMin = 1;
+	if (uPSCMax > 0x10000)
+		uPSCMax = 0x10000;
+	if (uPSCMin > uPSCMax)
+		return QA_Fail;
+
+	//Search for prescaler/period combination with the lowest error
+	//As prescaler * counts is always close to uTotal, the error in clocks is directly comparable between prescalers
+	uint64_t uBestError = 0xFFFFFFFFFFFFFFFFULL;
+	uint32_t uBestPSC   = 0;
+	uint64_t uBestCount = 0;
+
+	for (uint64_t uPSC = uPSCMin; uPSC <= uPSCMax; uPSC++) {
+		uint64_t uDiv   = uTarget * uPSC;
+		uint64_t uCount = (uClock + (uDiv / 2)) / uDiv;
+		if ((uCount < uResolution) || (uCount > uMaxCounts))
+			continue;
+
+		uint64_t uActual = uDiv * uCount;
+		uint64_t uError  = (uActual > uClock) ? (uActual - uClock) : (uClock - uActual);
+		if (uError < uBestError) {
+			uBestError = uError;
+			uBestPSC   = uPSC;
+			uBestCount = uCount;
+			if (!uError)
+				break;
+		}
+	}
+
+	if (!uBestPSC)
+		return QA_Fail;
+
+	//Set register values
+	uPrescaler = uBestPSC - 1;
+	uPeriod    = (uint32_t)(bCenterAligned ? uBestCount : (uBestCount - 1));
+	return QA_OK;
+}
+
+
   //---------------------------
   //---------------------------
   //QAD_TimerMgr Status Methods
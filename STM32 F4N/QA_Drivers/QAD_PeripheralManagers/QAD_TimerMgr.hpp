@@ -61,7 +61,8 @@ enum QAD_Timer_State : uint8_t {
 	QAD_Timer_InUse_IRQ,
 	QAD_Timer_InUse_Encoder,
 	QAD_Timer_InUse_PWM,
-	QAD_Timer_InUse_ADC
+	QAD_Timer_InUse_ADC,
+	QAD_Timer_InUse_ServoSeq
 };
 
 
@@ -93,10 +94,12 @@ typedef struct {
 
 	bool              bEncoder;      //Stores whether the Timer peripheral has support for rotary encoder mode
 	bool              bADC;          //Stores whether the Timer peripheral has support for triggering ADC conversions
+	bool              bAdvanced;     //Stores whether the Timer peripheral is an advanced-control timer (complementary outputs, dead-time and break input)
 
 	TIM_TypeDef*      pInstance;     //Stores the TIM_TypeDef for the Timer peripheral (defined in stm32f411xe.h)
 
 	IRQn_Type         eIRQ_Update;   //Stores the IRQ Handler enum for the Timer peripheral (defined in stm32f411xe.h)
+	IRQn_Type         eIRQ_CC;       //Stores the Capture/Compare IRQ Handler enum for the Timer peripheral (defined in stm32f411xe.h)
 
 } QAD_Timer_Data;
 
@@ -185,6 +188,14 @@ public:
 		return get().m_sTimers[eTimer].bADC;
 	}
 
+	//Used to retrieve whether a particular Timer peripheral is an advanced-control timer
+	//Advanced-control timers support complementary outputs, dead-time insertion, break input and main output enable
+	//eTimer - The Timer peripheral to retrieve the advanced-control support for. Member of QAD_Timer_Periph
+	//Returns true if the timer is an advanced-control timer, or false if not
+	static bool getAdvanced(QAD_Timer_Periph eTimer) {
+		return get().m_sTimers[eTimer].bAdvanced;
+	}
+
 	//Used to retrieve an instance for a Timer peripheral
 	//eTimer - The Timer peripheral to retrieve the instance for. Member of QAD_Timer_Periph
 	//Returns TIM_TypeDef, as defined in stm32f411xe.h
@@ -199,6 +210,14 @@ public:
 		return get().m_sTimers[eTimer].eIRQ_Update;
 	}
 
+	//Used to retrieve a Capture/Compare IRQ enum for a Timer peripheral
+	//For all timers except TIM1 this is the same as the Update IRQ
+	//eTimer - The Timer peripheral to retrieve the IRQ enum for. Member of QAD_Timer_Periph
+	//Returns member of IRQn_Type enum, as defined in stm32f411xe.h
+	static IRQn_Type getCCIRQ(QAD_Timer_Periph eTimer) {
+		return get().m_sTimers[eTimer].eIRQ_CC;
+	}
+
 
 	//------------------
 	//Management Methods
@@ -253,6 +272,25 @@ public:
 	}
 
 
+	//-------------------
+	//Calculation Methods
+
+	//Used to calculate the prescaler and period register values that give the closest achievable counter frequency to a
+	//target frequency, while providing at least a minimum number of counts per period
+	//eTimer         - The Timer peripheral to calculate the values for. Member of QAD_Timer_Periph
+	//uFrequency     - The target frequency in Hz
+	//uResolution    - The minimum number of counts per period (e.g. the number of steps required for a PWM duty cycle)
+	//bCenterAligned - Set to true if the timer is to be used in a center-aligned counter mode, where the counter counts
+	//                 both up and down each period
+	//uPrescaler     - Set to the calculated value for the timer's prescaler register
+	//uPeriod        - Set to the calculated value for the timer's auto-reload (period) register
+	//Returns QA_OK if successful, or QA_Fail if the target frequency cannot be achieved with the requested resolution
+	static QA_Result calcFrequency(QAD_Timer_Periph eTimer, uint32_t uFrequency, uint32_t uResolution, bool bCenterAligned,
+			                           uint32_t& uPrescaler, uint32_t& uPeriod) {
+		return get().imp_calcFrequency(eTimer, uFrequency, uResolution, bCenterAligned, uPrescaler, uPeriod);
+	}
+
+
 	//--------------
 	//Status Methods
 
@@ -289,6 +327,13 @@ private:
   void imp_disableClock(QAD_Timer_Periph eTimer);
 
 
+  //-------------------
+  //Calculation Methods
+
+  QA_Result imp_calcFrequency(QAD_Timer_Periph eTimer, uint32_t uFrequency, uint32_t uResolution, bool bCenterAligned,
+  		                        uint32_t& uPrescaler, uint32_t& uPeriod);
+
+
   //--------------
   //Status Methods
 
@@ -24,6 +24,36 @@
 	//------------------------------------------
 
 
+//---------------
+//QAD_RGB_Gamma
+//
+//Gamma correction table (gamma 2.2), stored in flash and shared between all QAD_RGB instances
+//Converts an 8bit color value to a Q16 level, where 0xFFFF is fully on
+static const uint16_t QAD_RGB_Gamma[256] = {
+	0x0000, 0x0000, 0x0002, 0x0004, 0x0007, 0x000B, 0x0011, 0x0018, 0x0020, 0x002A, 0x0035, 0x0041, 0x004F, 0x005E, 0x006F, 0x0081,
+	0x0094, 0x00A9, 0x00C0, 0x00D8, 0x00F2, 0x010E, 0x012B, 0x014A, 0x016A, 0x018C, 0x01B0, 0x01D5, 0x01FC, 0x0225, 0x024F, 0x027B,
+	0x02A9, 0x02D9, 0x030B, 0x033E, 0x0373, 0x03AA, 0x03E3, 0x041D, 0x0459, 0x0497, 0x04D7, 0x0519, 0x055D, 0x05A3, 0x05EA, 0x0633,
+	0x067F, 0x06CC, 0x071B, 0x076C, 0x07BF, 0x0814, 0x086B, 0x08C3, 0x091E, 0x097B, 0x09D9, 0x0A3A, 0x0A9D, 0x0B01, 0x0B68, 0x0BD0,
+	0x0C3B, 0x0CA8, 0x0D16, 0x0D87, 0x0DFA, 0x0E6E, 0x0EE5, 0x0F5E, 0x0FD9, 0x1056, 0x10D5, 0x1156, 0x11DA, 0x125F, 0x12E6, 0x1370,
+	0x13FB, 0x1489, 0x1519, 0x15AB, 0x163F, 0x16D5, 0x176E, 0x1808, 0x18A5, 0x1944, 0x19E5, 0x1A88, 0x1B2D, 0x1BD4, 0x1C7E, 0x1D2A,
+	0x1DD8, 0x1E88, 0x1F3A, 0x1FEF, 0x20A6, 0x215F, 0x221A, 0x22D7, 0x2397, 0x2459, 0x251D, 0x25E3, 0x26AC, 0x2776, 0x2843, 0x2913,
+	0x29E4, 0x2AB8, 0x2B8E, 0x2C66, 0x2D41, 0x2E1E, 0x2EFD, 0x2FDE, 0x30C2, 0x31A8, 0x3290, 0x337B, 0x3468, 0x3557, 0x3648, 0x373C,
+	0x3832, 0x392B, 0x3A25, 0x3B22, 0x3C22, 0x3D24, 0x3E28, 0x3F2E, 0x4037, 0x4142, 0x424F, 0x435F, 0x4471, 0x4586, 0x469D, 0x47B6,
+	0x48D2, 0x49F0, 0x4B10, 0x4C33, 0x4D58, 0x4E7F, 0x4FA9, 0x50D6, 0x5204, 0x5335, 0x5469, 0x559F, 0x56D7, 0x5812, 0x594F, 0x5A8E,
+	0x5BD0, 0x5D15, 0x5E5C, 0x5FA5, 0x60F1, 0x623F, 0x638F, 0x64E2, 0x6638, 0x6790, 0x68EA, 0x6A47, 0x6BA6, 0x6D08, 0x6E6C, 0x6FD3,
+	0x713C, 0x72A7, 0x7415, 0x7586, 0x76F9, 0x786E, 0x79E6, 0x7B61, 0x7CDE, 0x7E5D, 0x7FDF, 0x8164, 0x82EA, 0x8474, 0x8600, 0x878E,
+	0x891F, 0x8AB3, 0x8C49, 0x8DE1, 0x8F7C, 0x911A, 0x92BA, 0x945D, 0x9602, 0x97A9, 0x9954, 0x9B00, 0x9CB0, 0x9E62, 0xA016, 0xA1CD,
+	0xA386, 0xA542, 0xA701, 0xA8C2, 0xAA86, 0xAC4C, 0xAE15, 0xAFE1, 0xB1AF, 0xB37F, 0xB552, 0xB728, 0xB900, 0xBADB, 0xBCB9, 0xBE99,
+	0xC07B, 0xC261, 0xC449, 0xC633, 0xC820, 0xCA10, 0xCC02, 0xCDF7, 0xCFEE, 0xD1E8, 0xD3E5, 0xD5E4, 0xD7E6, 0xD9EB, 0xDBF2, 0xDDFC,
+	0xE008, 0xE217, 0xE429, 0xE63D, 0xE854, 0xEA6E, 0xEC8A, 0xEEA9, 0xF0CA, 0xF2EE, 0xF515, 0xF73F, 0xF96B, 0xFB9A, 0xFDCB, 0xFFFF
+};
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
   //------------------------------
   //------------------------------
   //QAD_RGB Initialization Methods
@@ -32,7 +62,8 @@
 //QAD_RGB Initialization Method
 QA_Result QAD_RGB::init(void) {
 
-	//Set Color
+	//Calculate scale and set color
+	calcScale();
 	setColor();
 
 	//Set Driver States
@@ -99,7 +130,7 @@ bool QAD_RGB::getInvert(void) {
 void QAD_RGB::setRed(uint8_t uRed) {
 
 	m_uRed = uRed;
-	setColor();
+	m_cPWM->setPWMVal(m_eRedChannel, calcValue(m_uRed));
 }
 
 
@@ -108,7 +139,7 @@ void QAD_RGB::setRed(uint8_t uRed) {
 void QAD_RGB::setGreen(uint8_t uGreen) {
 
 	m_uGreen = uGreen;
-	setColor();
+	m_cPWM->setPWMVal(m_eGreenChannel, calcValue(m_uGreen));
 }
 
 
@@ -117,12 +148,13 @@ void QAD_RGB::setGreen(uint8_t uGreen) {
 void QAD_RGB::setBlue(uint8_t uBlue) {
 
 	m_uBlue = uBlue;
-	setColor();
+	m_cPWM->setPWMVal(m_eBlueChannel, calcValue(m_uBlue));
 }
 
 
 //QAD_RGB::setRGB
 //QAD_RGB Control Method
+//All three channels are written while update events are held, so the new color takes effect within a single PWM period
 void QAD_RGB::setRGB(uint8_t uRed, uint8_t uGreen, uint8_t uBlue) {
 
 	m_uRed   = uRed;
@@ -134,6 +166,7 @@ void QAD_RGB::setRGB(uint8_t uRed, uint8_t uGreen, uint8_t uBlue) {
 
 //QAD_RGB::setRGB
 //QAD_RGB Control Method
+//All three channels are written while update events are held, so the new color takes effect within a single PWM period
 void QAD_RGB::setRGB(uint32_t uRGB) {
 
 	m_uRed   = (uRGB & 0x00FF0000) >> 16;
@@ -148,6 +181,7 @@ void QAD_RGB::setRGB(uint32_t uRGB) {
 void QAD_RGB::setBrightness(uint8_t uBrightness) {
 
 	m_uBrightness = uBrightness;
+	calcScale();
 	setColor();
 }
 
@@ -161,27 +195,55 @@ void QAD_RGB::setInvert(bool bInvert) {
 }
 
 
+//QAD_RGB::setGamma
+//QAD_RGB Control Method
+void QAD_RGB::setGamma(bool bGamma) {
+
+	m_bGamma = bGamma;
+	setColor();
+}
+
+
 	//------------------------------
 	//------------------------------
 	//QAD_RGB Private Control Method
 
 //QAD_RGB::setColor
 //QAD_RGB Private Control Method
+//
+//Writes all three channels, holding update events so that the three compare values are transferred together
 void QAD_RGB::setColor(void) {
 
-	uint16_t uPeriod = m_cPWM->getPeriod();
-
-	float fInc = uPeriod / 255.0f;
+	m_cPWM->holdUpdate();
+	m_cPWM->setPWMVal(m_eRedChannel, calcValue(m_uRed));
+	m_cPWM->setPWMVal(m_eGreenChannel, calcValue(m_uGreen));
+	m_cPWM->setPWMVal(m_eBlueChannel, calcValue(m_uBlue));
+	m_cPWM->releaseUpdate();
+}
 
-	float fBrightness = (m_uBrightness / 255.0f) * fInc;
 
-	float fRed   = m_uRed * fBrightness;
-	float fGreen = m_uGreen * fBrightness;
-	float fBlue  = m_uBlue * fBrightness;
+//QAD_RGB::calcScale
+//QAD_RGB Private Control Method
+//
+//Calculates the Q16 scale used by calcValue() to convert a Q16 color level into a compare value
+//Only needs to be recalculated when the brightness or PWM period changes
+//scale = (period * brightness * 65536) / (255 * 65535)
+void QAD_RGB::calcScale(void) {
+
+	m_uPeriod = m_cPWM->getPeriod();
+	m_uScale  = (((uint64_t)m_uPeriod * m_uBrightness) << 16) / (255ULL * 65535ULL);
+}
 
-	m_cPWM->setPWMVal(m_eRedChannel, m_bInvert ? uPeriod - fRed : fRed);
-	m_cPWM->setPWMVal(m_eGreenChannel, m_bInvert ? uPeriod - fGreen : fGreen);
-	m_cPWM->setPWMVal(m_eBlueChannel, m_bInvert ? uPeriod - fBlue : fBlue);
 
+//QAD_RGB::calcValue
+//QAD_RGB Private Control Method
+//
+//Converts an 8bit color value into a compare value, applying gamma correction, brightness and inversion
+//64bit intermediates are used as the period of a 32bit timer may be well beyond 16 bits
+uint32_t QAD_RGB::calcValue(uint8_t uColor) {
+
+	uint32_t uLevel = m_bGamma ? QAD_RGB_Gamma[uColor] : (uColor * 257);
+	uint32_t uVal   = (uint32_t)(((uLevel * m_uScale) + 0x8000) >> 16);
+	return m_bInvert ? (m_uPeriod - uVal) : uVal;
 }
 
@@ -45,6 +45,7 @@ typedef struct {
 
 	uint8_t             uBrightness;
 	bool                bInvert;      //Non-inverted = common Anode, Inverted = common Cathode
+	bool                bGamma;       //Set to true to apply gamma correction (gamma 2.2) to color values
 
 } QAD_RGB_InitStruct;
 
@@ -73,6 +74,10 @@ private:
 
 	uint8_t              m_uBrightness;
 	bool                 m_bInvert;
+	bool                 m_bGamma;
+
+	uint32_t             m_uPeriod;      //PWM period, cached from m_cPWM
+	uint64_t             m_uScale;       //Q16 scale used to convert a Q16 color level to a compare value, including brightness
 
 public:
 
@@ -92,7 +97,10 @@ public:
 		m_uGreen(sInit.uGreen),
 		m_uBlue(sInit.uBlue),
 		m_uBrightness(sInit.uBrightness),
-		m_bInvert(sInit.bInvert) {}
+		m_bInvert(sInit.bInvert),
+		m_bGamma(sInit.bGamma),
+		m_uPeriod(0),
+		m_uScale(0) {}
 
 
 	//----------------------
@@ -121,6 +129,7 @@ public:
 
 	void setBrightness(uint8_t uBrightness);
 	void setInvert(bool bInvert);
+	void setGamma(bool bGamma);
 
 private:
 
@@ -128,6 +137,8 @@ private:
 	//Control Method
 
 	void setColor(void);
+	void calcScale(void);
+	uint32_t calcValue(uint8_t uColor);
 
 };
 
@@ -18,6 +18,8 @@
 //Includes
 #include "QAD_SPI.hpp"
 
+#include <string.h>
+
 
 	//------------------------------------------
 	//------------------------------------------
@@ -95,6 +97,49 @@ QA_ActiveState QAD_SPI::getState(void) {
 }
 
 
+//QAD_SPI::reconfigure
+//QAD_SPI Control Method
+//
+//Changes clock polarity, clock phase, baud rate prescaler, data size and bit order without reinitializing the driver
+//CR1 is only written if one of these settings differs from the current configuration, in which case the peripheral is briefly
+//disabled once any frame in progress has completed. Must not be called while an asynchronous transfer is in progress
+//As this may be called with interrupts disabled or from a DMA interrupt, the wait for a frame in progress is limited to m_uTimeout
+//polls, and the configuration is left unchanged if the peripheral stays busy
+//Returns QA_OK if successful, or QA_Fail if the peripheral did not become idle
+QA_Result QAD_SPI::reconfigure(QAD_SPI_ClkPolarity eClkPolarity, QAD_SPI_ClkPhase eClkPhase, QAD_SPI_BaudPrescaler ePrescaler,
+		                           QAD_SPI_DataSize eDataSize, QAD_SPI_FirstBit eFirstBit) {
+	const uint32_t uMask = (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_BR | SPI_CR1_DFF | SPI_CR1_LSBFIRST);
+	uint32_t uConfig = (eClkPolarity | eClkPhase | ePrescaler | eDataSize | eFirstBit);
+
+	SPI_TypeDef* pSPI = m_sHandle.Instance;
+	uint32_t uCR1 = pSPI->CR1;
+	if ((uCR1 & uMask) != uConfig) {
+
+		//Wait for any frame in progress, then disable peripheral while changing settings
+		if (uCR1 & SPI_CR1_SPE) {
+			uint16_t uIdle = 0;
+			while ((pSPI->SR & SPI_SR_BSY) && (++uIdle < m_uTimeout)) {}
+			if (pSPI->SR & SPI_SR_BSY)
+				return QA_Fail;
+			pSPI->CR1 = uCR1 & ~SPI_CR1_SPE;
+		}
+		pSPI->CR1 = (uCR1 & ~uMask) | uConfig;
+	}
+
+	m_eSPIClkPolarity                = eClkPolarity;
+	m_eSPIClkPhase                   = eClkPhase;
+	m_eSPIPrescaler                  = ePrescaler;
+	m_eSPIDataSize                   = eDataSize;
+	m_eSPIFirstBit                   = eFirstBit;
+	m_sHandle.Init.CLKPolarity       = eClkPolarity;
+	m_sHandle.Init.CLKPhase          = eClkPhase;
+	m_sHandle.Init.BaudRatePrescaler = ePrescaler;
+	m_sHandle.Init.DataSize          = eDataSize;
+	m_sHandle.Init.FirstBit          = eFirstBit;
+	return QA_OK;
+}
+
+
 	//--------------------------
 	//--------------------------
 	//QAD_SPI Transceive Methods
@@ -102,6 +147,9 @@ QA_ActiveState QAD_SPI::getState(void) {
 //QAD_SPI::transmit
 //QAD_SPI Transceive Method
 QA_Result QAD_SPI::transmit(uint8_t* pTXData, uint16_t uSize) {
+	if (m_eAsyncState == QAD_SPI_Async_Busy)
+		return QA_Error_PeriphBusy;
+
 	if (m_bCS_Soft)
 		HAL_GPIO_WritePin(m_pCS_GPIO, m_uCS_Pin, GPIO_PIN_RESET);
 
@@ -120,6 +168,9 @@ QA_Result QAD_SPI::transmit(uint8_t* pTXData, uint16_t uSize) {
 //QAD_SPI::receive
 //QAD_SPI Transceive Method
 QA_Result QAD_SPI::receive(uint8_t* pRXData, uint16_t uSize) {
+	if (m_eAsyncState == QAD_SPI_Async_Busy)
+		return QA_Error_PeriphBusy;
+
 	if (m_bCS_Soft)
 		HAL_GPIO_WritePin(m_pCS_GPIO, m_uCS_Pin, GPIO_PIN_RESET);
 
@@ -138,12 +189,15 @@ QA_Result QAD_SPI::receive(uint8_t* pRXData, uint16_t uSize) {
 //QAD_SPI::transceive
 //QAD_SPI Transceive Method
 QA_Result QAD_SPI::transceive(uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize) {
+	if (m_eAsyncState == QAD_SPI_Async_Busy)
+		return QA_Error_PeriphBusy;
+
 	if (m_bCS_Soft)
 		HAL_GPIO_WritePin(m_pCS_GPIO, m_uCS_Pin, GPIO_PIN_RESET);
 
 	QA_Result eRes = QA_OK;
 	if (HAL_SPI_TransmitReceive(&m_sHandle, pTXData, pRXData, uSize, m_uTimeout) != HAL_OK) {
-		return QA_Fail;
+		eRes = QA_Fail;
 	}
 
 	if (m_bCS_Soft)
@@ -153,6 +207,570 @@ QA_Result QAD_SPI::transceive(uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize
 }
 
 
+	//---------------------------------------
+	//---------------------------------------
+	//QAD_SPI Asynchronous Transceive Methods
+
+//QAD_SPI::transmitAsync
+//QAD_SPI Asynchronous Transceive Method
+//
+//Starts transmitting uSize frames from pTXData using DMA, discarding received data
+//pTXData must remain valid until the transfer completes
+QA_Result QAD_SPI::transmitAsync(uint8_t* pTXData, uint16_t uSize) {
+	return transceiveAsync(pTXData, NULL, uSize);
+}
+
+
+//QAD_SPI::receiveAsync
+//QAD_SPI Asynchronous Transceive Method
+//
+//Starts receiving uSize frames into pRXData using DMA, transmitting 0xFF dummy frames
+//pRXData must remain valid until the transfer completes
+QA_Result QAD_SPI::receiveAsync(uint8_t* pRXData, uint16_t uSize) {
+	return transceiveAsync(NULL, pRXData, uSize);
+}
+
+
+//QAD_SPI::transceiveAsync
+//QAD_SPI Asynchronous Transceive Method
+//
+//Starts a full duplex transfer of uSize frames using DMA. Either pTXData or pRXData may be NULL
+//Buffers must remain valid until the transfer completes
+QA_Result QAD_SPI::transceiveAsync(uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize) {
+	if (m_eAsyncState == QAD_SPI_Async_Busy)
+		return QA_Error_PeriphBusy;
+
+	m_sAsyncSegment.pTXData = pTXData;
+	m_sAsyncSegment.pRXData = pRXData;
+	m_sAsyncSegment.uSize   = uSize;
+	return transferAsync(&m_sAsyncSegment, 1);
+}
+
+
+//QAD_SPI::transferAsync
+//QAD_SPI Asynchronous Transceive Method
+//
+//Starts a scatter-gather transfer of a list of segments using DMA. In soft CS mode CS is lowered before the first segment and
+//raised after the last, so the segments appear as a single transaction to the device. Each segment is started from the DMA interrupt
+//of the one before it, so the segment list and all buffers must remain valid until the transfer completes
+//Completion can be detected by polling getAsyncState(), or with a callback set by setAsyncCallback()
+//pSegments - Array of segments to be transferred
+//uCount    - Number of segments in array
+//Returns QA_OK if the transfer was started, QA_Error_PeriphBusy if a transfer is already in progress or the DMA streams are in use
+//or claimed by another SPI driver, QA_Error_PeriphNotSupported if the driver is not in 2 line mode, or QA_Fail if the driver is not initialized or a segment is empty
+QA_Result QAD_SPI::transferAsync(const QAD_SPI_Segment* pSegments, uint8_t uCount) {
+	if ((!m_eInitState) || (!pSegments) || (!uCount))
+		return QA_Fail;
+
+	if (m_sHandle.Init.Direction != SPI_DIRECTION_2LINES)
+		return QA_Error_PeriphNotSupported;
+
+	for (uint8_t i=0; i<uCount; i++) {
+		if (!pSegments[i].uSize)
+			return QA_Fail;
+	}
+
+	if ((!m_bDMA) || (m_bSlave) || (m_eAsyncState == QAD_SPI_Async_Busy) ||
+			(m_pDMARX->pStream->CR & DMA_SxCR_EN) || (m_pDMATX->pStream->CR & DMA_SxCR_EN))
+		return QA_Error_PeriphBusy;
+
+	m_pAsyncSegments = pSegments;
+	m_uAsyncCount    = uCount;
+	m_uAsyncIdx      = 0;
+	m_eAsyncState    = QAD_SPI_Async_Busy;
+
+	//Clear any pending overrun by reading the data and status registers
+	__HAL_SPI_CLEAR_OVRFLAG(&m_sHandle);
+
+	if (m_bCS_Soft)
+		HAL_GPIO_WritePin(m_pCS_GPIO, m_uCS_Pin, GPIO_PIN_RESET);
+
+	__HAL_SPI_ENABLE(&m_sHandle);
+	if (startSegment() != QA_OK)
+		finishAsync(QAD_SPI_Async_Error);
+
+	return QA_OK;
+}
+
+
+//QAD_SPI::abortAsync
+//QAD_SPI Asynchronous Transceive Method
+//
+//Aborts the current asynchronous transfer, if any. The async state is set to QAD_SPI_Async_Error, but the callback is not called
+void QAD_SPI::abortAsync(void) {
+	if (m_eAsyncState != QAD_SPI_Async_Busy)
+		return;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	stopDMA();
+	if (m_bCS_Soft)
+		HAL_GPIO_WritePin(m_pCS_GPIO, m_uCS_Pin, GPIO_PIN_SET);
+	m_eAsyncState = QAD_SPI_Async_Error;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+	//--------------------------
+	//--------------------------
+	//QAD_SPI Slave Mode Methods
+
+//QAD_SPI::slaveStart
+//QAD_SPI Slave Mode Method
+//
+//Starts slave mode. A frame is all the data clocked while NSS is low. Data is received continuously into a circular buffer using DMA,
+//and on each NSS rising edge the bytes received since the previous edge are published as a frame, to be read with slaveRead().
+//Responses are transmitted from the front of two response buffers, which is armed (and swapped with the back buffer if a new response
+//was set with slaveSetResponse()) on each NSS rising edge, so the master always clocks out complete, pre-loaded responses.
+//The driver must be initialized in 2 line slave mode with 8bit data size and hard input CS, with the NSS pin provided as the CS pin
+//The master must leave NSS high for long enough for handlerNSS() to complete (around 2us) before starting the next frame
+//uRXSize - Size in bytes of circular RX buffer. Must be large enough to hold all frames received before they are read. Frames of
+//          this size or larger are dropped
+//uTXSize - Size in bytes of each response buffer. Responses are padded with 0xFF to this size
+//Returns QA_OK if slave mode was started, QA_Error_PeriphBusy if slave mode or an asynchronous transfer is already running
+//or the DMA streams are in use or claimed by another SPI driver, QA_Error_PeriphNotSupported if the driver is not configured as above, or QA_Fail if a size is invalid
+QA_Result QAD_SPI::slaveStart(uint16_t uRXSize, uint16_t uTXSize) {
+	if ((!m_eInitState) || (uRXSize < 2) || (!uTXSize))
+		return QA_Fail;
+
+	if ((m_eSPIMode != QAD_SPI_Mode_Slave) || (m_sHandle.Init.Direction != SPI_DIRECTION_2LINES) ||
+			(m_eSPICS != QAD_SPI_CS_Hard_Input) || (!m_pCS_GPIO) || (m_sHandle.Instance->CR1 & SPI_CR1_DFF))
+		return QA_Error_PeriphNotSupported;
+
+	if ((!m_bDMA) || (m_bSlave) || (m_eAsyncState == QAD_SPI_Async_Busy) ||
+			(m_pDMARX->pStream->CR & DMA_SxCR_EN) || (m_pDMATX->pStream->CR & DMA_SxCR_EN))
+		return QA_Error_PeriphBusy;
+
+	//Allocate buffers. Existing buffers are reused if they are the required size
+	if (uRXSize != m_uSlaveRXSize) {
+		m_pSlaveRX     = std::make_unique<uint8_t[]>(uRXSize);
+		m_uSlaveRXSize = uRXSize;
+	}
+	if (uTXSize != m_uSlaveTXSize) {
+		m_pSlaveTX[0]  = std::make_unique<uint8_t[]>(uTXSize);
+		m_pSlaveTX[1]  = std::make_unique<uint8_t[]>(uTXSize);
+		m_uSlaveTXSize = uTXSize;
+	}
+	memset(m_pSlaveTX[0].get(), 0xFF, uTXSize);
+	memset(m_pSlaveTX[1].get(), 0xFF, uTXSize);
+
+	m_uSlaveRXHead    = 0;
+	m_uSlaveRXLaps    = 0;
+	m_uSlaveTXFront   = 0;
+	m_bSlaveTXPending = false;
+	m_uSlaveFrameHead = 0;
+	m_uSlaveFrameTail = 0;
+	m_uSlaveDropped   = 0;
+
+	SPI_TypeDef* pSPI = m_sHandle.Instance;
+	pSPI->CR1 &= ~SPI_CR1_SPE;
+	pSPI->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+
+	//Start RX stream in circular mode, with the transfer complete interrupt used to count wraps of the buffer
+	DMA_Stream_TypeDef* pStream = m_pDMARX->pStream;
+	clearDMAFlags(m_pDMARX);
+	pStream->PAR  = (uint32_t)&pSPI->DR;
+	pStream->M0AR = (uint32_t)m_pSlaveRX.get();
+	pStream->NDTR = uRXSize;
+	pStream->FCR  = 0;
+	pStream->CR   = m_pDMARX->uChannel | DMA_SxCR_PL | DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_TCIE;
+	pStream->CR  |= DMA_SxCR_EN;
+	pSPI->CR2    |= SPI_CR2_RXDMAEN;
+
+	//Start TX stream, which preloads the first response byte
+	slaveStartTX();
+	m_bSlave = true;
+	pSPI->CR1 |= SPI_CR1_SPE;
+
+	//Setup rising edge interrupt on NSS pin. This is done directly through EXTI and SYSCFG, as QAD_EXTI would reconfigure the pin as a
+	//GPIO input, whereas it needs to remain in alternate function mode to drive the SPI peripheral's NSS input
+	uint8_t uPinIdx = POSITION_VAL(m_uCS_Pin);
+	uint32_t uPort  = GPIO_GET_INDEX(m_pCS_GPIO);
+	__HAL_RCC_SYSCFG_CLK_ENABLE();
+	SYSCFG->EXTICR[uPinIdx >> 2] = (SYSCFG->EXTICR[uPinIdx >> 2] & ~(0x0FU << ((uPinIdx & 0x03) * 4))) | (uPort << ((uPinIdx & 0x03) * 4));
+	EXTI->FTSR &= ~m_uCS_Pin;
+	EXTI->RTSR |= m_uCS_Pin;
+	EXTI->PR    = m_uCS_Pin;
+	EXTI->IMR  |= m_uCS_Pin;
+	HAL_NVIC_SetPriority(slaveGetNSSIRQ(), m_uIRQPriority, 0);
+	HAL_NVIC_EnableIRQ(slaveGetNSSIRQ());
+
+	m_eState = QA_Active;
+	return QA_OK;
+}
+
+
+//QAD_SPI::slaveStop
+//QAD_SPI Slave Mode Method
+//
+//Stops slave mode. Frames that have not been read are discarded
+void QAD_SPI::slaveStop(void) {
+	if (!m_bSlave)
+		return;
+
+	//Disable NSS interrupt. The NVIC IRQ is left enabled as it may be shared with other EXTI lines
+	EXTI->IMR &= ~m_uCS_Pin;
+	EXTI->RTSR &= ~m_uCS_Pin;
+	EXTI->PR    = m_uCS_Pin;
+
+	stopDMA();
+	m_sHandle.Instance->CR1 &= ~SPI_CR1_SPE;
+
+	m_bSlave          = false;
+	m_uSlaveFrameHead = 0;
+	m_uSlaveFrameTail = 0;
+	m_eState          = QA_Inactive;
+}
+
+
+//QAD_SPI::slaveSetResponse
+//QAD_SPI Slave Mode Method
+//
+//Sets the response to be transmitted in the next frame after the next NSS rising edge. The data is copied into the back response buffer,
+//which is swapped in at the NSS rising edge. If called more than once between edges, only the last response is used
+//pData - Response data
+//uSize - Size of response in bytes. Data beyond the response buffer size is ignored, and unused bytes are transmitted as 0xFF
+//Returns QA_OK, or QA_Fail if slave mode is not running
+QA_Result QAD_SPI::slaveSetResponse(const uint8_t* pData, uint16_t uSize) {
+	if (!m_bSlave)
+		return QA_Fail;
+
+	if (uSize > m_uSlaveTXSize)
+		uSize = m_uSlaveTXSize;
+
+	//Clear pending flag so the back buffer cannot be swapped in while it is being written
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	m_bSlaveTXPending = false;
+	uint8_t* pBack    = m_pSlaveTX[m_uSlaveTXFront ^ 1].get();
+	__set_PRIMASK(uPRIMASK);
+
+	memcpy(pBack, pData, uSize);
+	memset(pBack + uSize, 0xFF, m_uSlaveTXSize - uSize);
+	m_bSlaveTXPending = true;
+	return QA_OK;
+}
+
+
+//QAD_SPI::slaveRead
+//QAD_SPI Slave Mode Method
+//
+//Reads the oldest received frame and removes it from the frame queue
+//pData    - Buffer for frame data
+//uMaxSize - Size of pData in bytes. Frames larger than this are truncated
+//Returns the size of the frame in bytes (before any truncation), or 0 if no frames are waiting
+uint16_t QAD_SPI::slaveRead(uint8_t* pData, uint16_t uMaxSize) {
+	if (!slaveGetFrameCount())
+		return 0;
+
+	SlaveFrame sFrame = m_sSlaveFrames[m_uSlaveFrameTail % QAD_SPI_SLAVE_FRAMES];
+	uint16_t uCopy = (sFrame.uSize < uMaxSize) ? sFrame.uSize : uMaxSize;
+
+	//Copy data from circular buffer, in two parts if the frame wraps around the end of the buffer
+	uint16_t uFirst = m_uSlaveRXSize - sFrame.uStart;
+	if (uFirst > uCopy)
+		uFirst = uCopy;
+	memcpy(pData, &m_pSlaveRX[sFrame.uStart], uFirst);
+	memcpy(pData + uFirst, &m_pSlaveRX[0], uCopy - uFirst);
+
+	m_uSlaveFrameTail++;
+	return sFrame.uSize;
+}
+
+
+	//---------------------------
+	//---------------------------
+	//QAD_SPI IRQ Handler Methods
+
+//QAD_SPI::handlerDMA
+//QAD_SPI IRQ Handler Method
+//
+//Handles RX and TX DMA stream interrupts for asynchronous transfers. Transfer errors on either stream abort the transfer.
+//As every frame transmitted produces a received frame, the RX stream completing marks the end of each segment.
+//In slave mode the RX stream completing marks a wrap of the circular RX buffer, which is counted for handlerNSS()
+void QAD_SPI::handlerDMA(void) {
+	uint32_t uRXFlags = getDMAFlags(m_pDMARX);
+	uint32_t uTXFlags = getDMAFlags(m_pDMATX);
+
+	//Count RX buffer wraps in slave mode
+	if ((m_bSlave) && (uRXFlags & DMA_FLAG_TCIF0_4)) {
+		clearDMAFlags(m_pDMARX);
+		m_uSlaveRXLaps++;
+		uRXFlags &= ~DMA_FLAG_TCIF0_4;
+	}
+
+	//Check for transfer errors
+	if ((uRXFlags | uTXFlags) & (DMA_FLAG_TEIF0_4 | DMA_FLAG_DMEIF0_4)) {
+		if (m_eAsyncState == QAD_SPI_Async_Busy)
+			finishAsync(QAD_SPI_Async_Error); else
+			stopDMA();
+		return;
+	}
+
+	//Check for end of segment
+	if (uRXFlags & DMA_FLAG_TCIF0_4) {
+		clearDMAFlags(m_pDMARX);
+		if (m_eAsyncState != QAD_SPI_Async_Busy)
+			return;
+
+		m_uAsyncIdx++;
+		if (m_uAsyncIdx < m_uAsyncCount) {
+			if (startSegment() != QA_OK)
+				finishAsync(QAD_SPI_Async_Error);
+		} else {
+			finishAsync(QAD_SPI_Async_Complete);
+		}
+	}
+}
+
+
+//QAD_SPI::handlerDMACallback
+//QAD_SPI IRQ Handler Method
+//
+//Registered with QAD_SPIMgr when the DMA streams are claimed, and called from the DMA stream IRQ handlers through
+//QAD_SPIMgr::handlerDMA()
+//pData - Pointer to the driver
+void QAD_SPI::handlerDMACallback(void* pData) {
+	((QAD_SPI*)pData)->handlerDMA();
+}
+
+
+//QAD_SPI::handlerNSS
+//QAD_SPI IRQ Handler Method
+//
+//Handles the NSS rising edge interrupt in slave mode, which marks the end of a frame. The data received since the previous edge is
+//published as a frame, and the SPI peripheral is reset to discard the response byte already preloaded into its TX buffer, before the
+//TX stream is rearmed from the start of the (possibly swapped) front response buffer
+void QAD_SPI::handlerNSS(void) {
+	if (!(EXTI->PR & m_uCS_Pin))
+		return;
+	EXTI->PR = m_uCS_Pin;
+
+	if (!m_bSlave)
+		return;
+
+	//Stop TX stream
+	DMA_Stream_TypeDef* pStream = m_pDMATX->pStream;
+	pStream->CR &= ~DMA_SxCR_EN;
+	while (pStream->CR & DMA_SxCR_EN) {}
+
+	//Count any RX buffer wrap not yet seen by handlerDMA(). No data arrives while NSS is high, so the count and position are stable
+	if (getDMAFlags(m_pDMARX) & DMA_FLAG_TCIF0_4) {
+		clearDMAFlags(m_pDMARX);
+		m_uSlaveRXLaps++;
+	}
+
+	//Publish frame. The position only gives the frame size modulo the buffer size, so the number of wraps is used to detect frames
+	//that filled the buffer, whose start has already been overwritten. A frame that fits passes the end of the buffer at most once,
+	//and only when the position is now before the frame's start
+	uint16_t uPos   = m_uSlaveRXSize - (uint16_t)m_pDMARX->pStream->NDTR;
+	uint16_t uSize  = (uPos >= m_uSlaveRXHead) ? (uPos - m_uSlaveRXHead) : (uPos + m_uSlaveRXSize - m_uSlaveRXHead);
+	uint16_t uWraps = (uPos < m_uSlaveRXHead) ? 1 : 0;
+	bool     bFrame = false;
+	if (m_uSlaveRXLaps > uWraps) {
+		m_uSlaveDropped++;
+		m_uSlaveRXHead = uPos;
+	} else if (uSize) {
+		if (slaveGetFrameCount() < QAD_SPI_SLAVE_FRAMES) {
+			SlaveFrame& sFrame = m_sSlaveFrames[m_uSlaveFrameHead % QAD_SPI_SLAVE_FRAMES];
+			sFrame.uStart = m_uSlaveRXHead;
+			sFrame.uSize  = uSize;
+			m_uSlaveFrameHead++;
+			bFrame = true;
+		} else {
+			m_uSlaveDropped++;
+		}
+		m_uSlaveRXHead = uPos;
+	}
+	m_uSlaveRXLaps = 0;
+
+	//Reset SPI peripheral, restoring its configuration. The RX stream continues running throughout
+	SPI_TypeDef* pSPI = m_sHandle.Instance;
+	uint32_t uCR1   = pSPI->CR1 & ~SPI_CR1_SPE;
+	uint32_t uCR2   = pSPI->CR2 & ~SPI_CR2_TXDMAEN;
+	uint32_t uCRCPR = pSPI->CRCPR;
+	QAD_SPIMgr::resetPeriph(m_eSPI);
+	pSPI->CRCPR = uCRCPR;
+	pSPI->CR2   = uCR2;
+	pSPI->CR1   = uCR1;
+
+	//Swap response buffers if a new response is ready, and rearm TX stream
+	if (m_bSlaveTXPending) {
+		m_uSlaveTXFront  ^= 1;
+		m_bSlaveTXPending = false;
+	}
+	slaveStartTX();
+	pSPI->CR1 |= SPI_CR1_SPE;
+
+	if ((bFrame) && (m_pSlaveCallback))
+		m_pSlaveCallback(m_pSlaveCallbackData);
+}
+
+
+	//-----------------------------------------------
+	//-----------------------------------------------
+	//QAD_SPI Private Asynchronous Transceive Methods
+
+//QAD_SPI::startSegment
+//QAD_SPI Private Asynchronous Transceive Method
+//
+//Configures and starts the RX and TX DMA streams for the current segment. The RX stream and RX DMA request are enabled first,
+//as recommended by the reference manual, so no received frames are missed
+//As this is called from the DMA interrupt, the wait for the previous segment's TX stream is limited to m_uTimeout polls
+//Returns QA_OK if the segment was started, or QA_Fail if the TX stream did not stop
+QA_Result QAD_SPI::startSegment(void) {
+	const QAD_SPI_Segment& sSeg = m_pAsyncSegments[m_uAsyncIdx];
+	SPI_TypeDef* pSPI = m_sHandle.Instance;
+
+	//Disable DMA requests from previous segment, and wait for TX stream to finish
+	pSPI->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+	uint16_t uIdle = 0;
+	while ((m_pDMATX->pStream->CR & DMA_SxCR_EN) && (++uIdle < m_uTimeout)) {}
+	if (m_pDMATX->pStream->CR & DMA_SxCR_EN)
+		return QA_Fail;
+
+	uint32_t uSize = (pSPI->CR1 & SPI_CR1_DFF) ? (DMA_SxCR_PSIZE_0 | DMA_SxCR_MSIZE_0) : 0;
+
+	//RX Stream
+	DMA_Stream_TypeDef* pStream = m_pDMARX->pStream;
+	clearDMAFlags(m_pDMARX);
+	pStream->PAR  = (uint32_t)&pSPI->DR;
+	pStream->M0AR = sSeg.pRXData ? (uint32_t)sSeg.pRXData : (uint32_t)&m_uDummyRX;
+	pStream->NDTR = sSeg.uSize;
+	pStream->FCR  = 0;
+	pStream->CR   = m_pDMARX->uChannel | uSize | DMA_SxCR_PL_1 | (sSeg.pRXData ? DMA_SxCR_MINC : 0) |
+			            DMA_SxCR_TCIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE;
+	pStream->CR  |= DMA_SxCR_EN;
+	pSPI->CR2    |= SPI_CR2_RXDMAEN;
+
+	//TX Stream
+	pStream = m_pDMATX->pStream;
+	clearDMAFlags(m_pDMATX);
+	pStream->PAR  = (uint32_t)&pSPI->DR;
+	pStream->M0AR = sSeg.pTXData ? (uint32_t)sSeg.pTXData : (uint32_t)&m_uDummyTX;
+	pStream->NDTR = sSeg.uSize;
+	pStream->FCR  = 0;
+	pStream->CR   = m_pDMATX->uChannel | uSize | DMA_SxCR_DIR_0 | (sSeg.pTXData ? DMA_SxCR_MINC : 0) |
+			            DMA_SxCR_TEIE | DMA_SxCR_DMEIE;
+	pStream->CR  |= DMA_SxCR_EN;
+	pSPI->CR2    |= SPI_CR2_TXDMAEN;
+	return QA_OK;
+}
+
+
+//QAD_SPI::stopDMA
+//QAD_SPI Private Asynchronous Transceive Method
+//
+//Disables DMA requests and both DMA streams, and clears their flags
+//The wait for the streams to stop is limited to m_uTimeout polls, as this is called from the DMA interrupt
+//Returns QA_OK if both streams stopped, or QA_Fail if either stream is still enabled
+QA_Result QAD_SPI::stopDMA(void) {
+	m_sHandle.Instance->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+
+	m_pDMATX->pStream->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE);
+	m_pDMARX->pStream->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE);
+	uint16_t uIdle = 0;
+	while (((m_pDMATX->pStream->CR & DMA_SxCR_EN) || (m_pDMARX->pStream->CR & DMA_SxCR_EN)) && (++uIdle < m_uTimeout)) {}
+
+	clearDMAFlags(m_pDMATX);
+	clearDMAFlags(m_pDMARX);
+
+	if ((m_pDMATX->pStream->CR & DMA_SxCR_EN) || (m_pDMARX->pStream->CR & DMA_SxCR_EN))
+		return QA_Fail;
+	return QA_OK;
+}
+
+
+//QAD_SPI::finishAsync
+//QAD_SPI Private Asynchronous Transceive Method
+//
+//Ends the current asynchronous transfer once the last frame has been clocked out, raising CS in soft CS mode, and calls the callback if set
+//The waits for the DMA streams to stop and for the last frame are limited to m_uTimeout polls each, as this is called from the DMA
+//interrupt. If either times out the transfer is ended as QAD_SPI_Async_Error
+void QAD_SPI::finishAsync(QAD_SPI_AsyncState eState) {
+	if (stopDMA() != QA_OK)
+		eState = QAD_SPI_Async_Error;
+
+	uint16_t uIdle = 0;
+	while ((m_sHandle.Instance->SR & SPI_SR_BSY) && (++uIdle < m_uTimeout)) {}
+	if (m_sHandle.Instance->SR & SPI_SR_BSY)
+		eState = QAD_SPI_Async_Error;
+
+	if (m_bCS_Soft)
+		HAL_GPIO_WritePin(m_pCS_GPIO, m_uCS_Pin, GPIO_PIN_SET);
+
+	m_eAsyncState = eState;
+
+	if (m_pAsyncCallback)
+		m_pAsyncCallback(m_pAsyncCallbackData);
+}
+
+
+//QAD_SPI::getDMAFlags
+//QAD_SPI Private Asynchronous Transceive Method
+//
+//Returns the flags of a DMA stream, shifted to match the stream 0/4 flag definitions (DMA_FLAG_xxx0_4)
+uint32_t QAD_SPI::getDMAFlags(const QAD_SPI_DMAStream* pDMA) {
+	uint32_t uISR = pDMA->bFlagHigh ? pDMA->pDMA->HISR : pDMA->pDMA->LISR;
+	return (uISR >> pDMA->uFlagShift) & 0x3D;
+}
+
+
+//QAD_SPI::clearDMAFlags
+//QAD_SPI Private Asynchronous Transceive Method
+//
+//Clears all flags of a DMA stream
+void QAD_SPI::clearDMAFlags(const QAD_SPI_DMAStream* pDMA) {
+	if (pDMA->bFlagHigh)
+		pDMA->pDMA->HIFCR = (0x3D << pDMA->uFlagShift); else
+		pDMA->pDMA->LIFCR = (0x3D << pDMA->uFlagShift);
+}
+
+
+	//----------------------------------
+	//----------------------------------
+	//QAD_SPI Private Slave Mode Methods
+
+//QAD_SPI::slaveStartTX
+//QAD_SPI Private Slave Mode Method
+//
+//Starts the TX stream from the start of the front response buffer, and enables the TX DMA request
+void QAD_SPI::slaveStartTX(void) {
+	DMA_Stream_TypeDef* pStream = m_pDMATX->pStream;
+	clearDMAFlags(m_pDMATX);
+	pStream->PAR  = (uint32_t)&m_sHandle.Instance->DR;
+	pStream->M0AR = (uint32_t)m_pSlaveTX[m_uSlaveTXFront].get();
+	pStream->NDTR = m_uSlaveTXSize;
+	pStream->FCR  = 0;
+	pStream->CR   = m_pDMATX->uChannel | DMA_SxCR_PL | DMA_SxCR_DIR_0 | DMA_SxCR_MINC;
+	pStream->CR  |= DMA_SxCR_EN;
+	m_sHandle.Instance->CR2 |= SPI_CR2_TXDMAEN;
+}
+
+
+//QAD_SPI::slaveGetNSSIRQ
+//QAD_SPI Private Slave Mode Method
+//
+//Returns the EXTI IRQ for the NSS pin
+IRQn_Type QAD_SPI::slaveGetNSSIRQ(void) {
+	switch (m_uCS_Pin) {
+		case (GPIO_PIN_0):
+			return EXTI0_IRQn;
+		case (GPIO_PIN_1):
+			return EXTI1_IRQn;
+		case (GPIO_PIN_2):
+			return EXTI2_IRQn;
+		case (GPIO_PIN_3):
+			return EXTI3_IRQn;
+		case (GPIO_PIN_4):
+			return EXTI4_IRQn;
+	}
+	if (m_uCS_Pin <= GPIO_PIN_9)
+		return EXTI9_5_IRQn;
+	return EXTI15_10_IRQn;
+}
+
+
 	//--------------------------------------
 	//--------------------------------------
 	//QAD_SPI Private Initialization Methods
@@ -254,6 +872,24 @@ QA_Result QAD_SPI::periphInit(void) {
 	HAL_NVIC_EnableIRQ(QAD_SPIMgr::getIRQ(m_eSPI));
 
 
+	//Claim and setup DMA streams used for asynchronous transfers. If the streams are held by another SPI driver then only blocking
+	//transfers are available. The DMA clocks are left enabled on deinit as they are shared with other drivers
+	m_pDMARX = QAD_SPIMgr::getDMARX(m_eSPI);
+	m_pDMATX = QAD_SPIMgr::getDMATX(m_eSPI);
+	m_bDMA   = (QAD_SPIMgr::registerDMA(m_eSPI, handlerDMACallback, this) == QA_OK);
+	if (m_bDMA) {
+		if (m_pDMARX->pDMA == DMA1)
+			__HAL_RCC_DMA1_CLK_ENABLE(); else
+			__HAL_RCC_DMA2_CLK_ENABLE();
+
+		HAL_NVIC_SetPriority(m_pDMARX->eIRQ, m_uIRQPriority, 0);
+		HAL_NVIC_EnableIRQ(m_pDMARX->eIRQ);
+		HAL_NVIC_SetPriority(m_pDMATX->eIRQ, m_uIRQPriority, 0);
+		HAL_NVIC_EnableIRQ(m_pDMATX->eIRQ);
+	}
+	m_eAsyncState = QAD_SPI_Async_Idle;
+
+
 	//Set Driver States
 	m_eInitState = QA_Initialized;
 	m_eState     = QA_Inactive;
@@ -269,6 +905,15 @@ QA_Result QAD_SPI::periphInit(void) {
 void QAD_SPI::periphDeinit(DeinitMode eDeinitMode) {
 
 	if (eDeinitMode) {
+		slaveStop();
+		abortAsync();
+		if (m_bDMA) {
+			HAL_NVIC_DisableIRQ(m_pDMARX->eIRQ);
+			HAL_NVIC_DisableIRQ(m_pDMATX->eIRQ);
+			QAD_SPIMgr::deregisterDMA(m_eSPI);
+			m_bDMA = false;
+		}
+
 		stop();
 		HAL_NVIC_DisableIRQ(QAD_SPIMgr::getIRQ(m_eSPI));
 
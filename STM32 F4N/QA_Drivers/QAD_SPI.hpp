@@ -24,6 +24,8 @@
 
 #include "QAD_SPIMgr.hpp"
 
+#include <memory>
+
 
 	//------------------------------------------
 	//------------------------------------------
@@ -126,6 +128,39 @@ enum QAD_SPI_CRC : uint32_t {
 };
 
 
+//--------------------
+//QAD_SPI_SLAVE_FRAMES
+//
+//Number of received frames that can be waiting to be read in slave mode. Must be a power of two no greater than 128
+#define QAD_SPI_SLAVE_FRAMES   8
+
+
+//------------------
+//QAD_SPI_AsyncState
+//
+//State of asynchronous DMA transfers, as returned by QAD_SPI::getAsyncState()
+enum QAD_SPI_AsyncState : uint8_t {
+	QAD_SPI_Async_Idle = 0,    //No asynchronous transfer has been started
+	QAD_SPI_Async_Busy,        //An asynchronous transfer is in progress
+	QAD_SPI_Async_Complete,    //The last asynchronous transfer completed successfully
+	QAD_SPI_Async_Error        //The last asynchronous transfer failed due to a DMA error, or was aborted
+};
+
+
+//---------------
+//QAD_SPI_Segment
+//
+//Describes one segment of a scatter-gather transfer started with QAD_SPI::transferAsync()
+//In 16bit data size mode buffers must be halfword aligned, and uSize is the number of 16bit frames
+typedef struct {
+
+	uint8_t*  pTXData;  //Data to transmit, or NULL to transmit 0xFF dummy frames
+	uint8_t*  pRXData;  //Buffer for received data, or NULL to discard received data
+	uint16_t  uSize;    //Number of frames in segment. Must be non-zero
+
+} QAD_SPI_Segment;
+
+
 //------------------------------------------
 //------------------------------------------
 //------------------------------------------
@@ -175,6 +210,17 @@ typedef struct {
 
 //-------
 //QAD_SPI
+//
+//Asynchronous transfers use the DMA streams listed in QAD_SPIMgr.hpp, which are claimed from QAD_SPIMgr when the driver is initialized.
+//The DMA stream IRQ handlers in Core/handlers.cpp pass their interrupts to handlerDMA() through QAD_SPIMgr::handlerDMA(). If the
+//streams are already claimed by another SPI driver (SPI4 and SPI5 share their streams) the driver still initializes for blocking
+//transfers, but asynchronous transfers and slave mode return QA_Error_PeriphBusy
+//
+//Slave mode (see slaveStart()) receives continuously into a circular DMA buffer, and uses a rising edge interrupt on the NSS pin to
+//mark the end of each frame. handlerNSS() must be called from the EXTI IRQ handler for the NSS pin (e.g. EXTI4_IRQHandler for pin A4).
+//For NSS on pins 10 to 15, EXTI15_10_IRQHandler in Core/handlers.cpp (which also handles the user button on PC13) must chain to
+//handlerNSS(), which only clears and processes its own pin's pending flag. Frames of the RX buffer size or larger have been partly
+//overwritten by the time NSS rises, so these are discarded and counted as dropped
 class QAD_SPI {
 private:
 	enum DeinitMode : uint8_t {DeinitPartial = 0, DeinitFull};
@@ -220,6 +266,45 @@ private:
 	IRQn_Type             m_eIRQ;
 	SPI_HandleTypeDef     m_sHandle;
 
+	const QAD_SPI_DMAStream* m_pDMARX;         //RX DMA stream used for asynchronous transfers
+	const QAD_SPI_DMAStream* m_pDMATX;         //TX DMA stream used for asynchronous transfers
+	bool                     m_bDMA;           //Set to true if the DMA streams were claimed from QAD_SPIMgr by init()
+
+	volatile QAD_SPI_AsyncState m_eAsyncState; //State of current/last asynchronous transfer
+	const QAD_SPI_Segment*   m_pAsyncSegments; //Segment list of current asynchronous transfer
+	uint8_t                  m_uAsyncCount;    //Number of segments in current asynchronous transfer
+	volatile uint8_t         m_uAsyncIdx;      //Index of segment currently being transferred
+	QAD_SPI_Segment          m_sAsyncSegment;  //Segment used by single buffer asynchronous transfer methods
+
+	QAD_IRQHandler_CallbackFunction m_pAsyncCallback;     //Function to be called when an asynchronous transfer completes or fails, or NULL
+	void*                           m_pAsyncCallbackData; //Data pointer passed to m_pAsyncCallback
+
+	uint16_t                 m_uDummyTX;       //Source of dummy frames transmitted for segments with no TX data
+	uint16_t                 m_uDummyRX;       //Destination of received frames for segments with no RX buffer
+
+	//Slave mode received frame data
+	typedef struct {
+		uint16_t uStart;                         //Offset of frame within RX buffer
+		uint16_t uSize;                          //Size of frame in bytes
+	} SlaveFrame;
+
+	bool                       m_bSlave;                             //Set to true while slave mode is running
+	std::unique_ptr<uint8_t[]> m_pSlaveRX;                           //Circular RX buffer
+	uint16_t                   m_uSlaveRXSize;                       //Size of RX buffer in bytes
+	uint16_t                   m_uSlaveRXHead;                       //Offset in RX buffer of the start of the next frame
+	volatile uint16_t          m_uSlaveRXLaps;                       //Number of times the RX stream has wrapped since the previous NSS edge
+	std::unique_ptr<uint8_t[]> m_pSlaveTX[2];                        //Double buffered response buffers
+	uint16_t                   m_uSlaveTXSize;                       //Size of each response buffer in bytes
+	volatile uint8_t           m_uSlaveTXFront;                      //Index of response buffer currently being transmitted
+	volatile bool              m_bSlaveTXPending;                    //Set to true when the back response buffer is ready to be swapped in
+	SlaveFrame                 m_sSlaveFrames[QAD_SPI_SLAVE_FRAMES]; //Queue of received frames
+	volatile uint8_t           m_uSlaveFrameHead;                    //Count of frames published (queue index is modulo QAD_SPI_SLAVE_FRAMES)
+	volatile uint8_t           m_uSlaveFrameTail;                    //Count of frames read (queue index is modulo QAD_SPI_SLAVE_FRAMES)
+	volatile uint32_t          m_uSlaveDropped;                      //Number of frames dropped due to a full frame queue or not fitting the RX buffer
+
+	QAD_IRQHandler_CallbackFunction m_pSlaveCallback;     //Function to be called when a frame is received in slave mode, or NULL
+	void*                           m_pSlaveCallbackData; //Data pointer passed to m_pSlaveCallback
+
 public:
 
 		//-------------------------
@@ -258,7 +343,31 @@ public:
 		m_uCS_AF(sInit.uCS_AF),
 		m_bCS_Soft(false),
 		m_eIRQ(SPI1_IRQn),
-		m_sHandle({0}) {}
+		m_sHandle({0}),
+		m_pDMARX(NULL),
+		m_pDMATX(NULL),
+		m_bDMA(false),
+		m_eAsyncState(QAD_SPI_Async_Idle),
+		m_pAsyncSegments(NULL),
+		m_uAsyncCount(0),
+		m_uAsyncIdx(0),
+		m_sAsyncSegment({NULL, NULL, 0}),
+		m_pAsyncCallback(NULL),
+		m_pAsyncCallbackData(NULL),
+		m_uDummyTX(0xFFFF),
+		m_uDummyRX(0),
+		m_bSlave(false),
+		m_uSlaveRXSize(0),
+		m_uSlaveRXHead(0),
+		m_uSlaveRXLaps(0),
+		m_uSlaveTXSize(0),
+		m_uSlaveTXFront(0),
+		m_bSlaveTXPending(false),
+		m_uSlaveFrameHead(0),
+		m_uSlaveFrameTail(0),
+		m_uSlaveDropped(0),
+		m_pSlaveCallback(NULL),
+		m_pSlaveCallbackData(NULL) {}
 
 
 	~QAD_SPI() {
@@ -290,6 +399,9 @@ public:
 	void stop(void);
 	QA_ActiveState getState(void);
 
+	QA_Result reconfigure(QAD_SPI_ClkPolarity eClkPolarity, QAD_SPI_ClkPhase eClkPhase, QAD_SPI_BaudPrescaler ePrescaler,
+			                  QAD_SPI_DataSize eDataSize, QAD_SPI_FirstBit eFirstBit);
+
 
 		//------------------
 		//Transceive Methods
@@ -298,6 +410,140 @@ public:
 	QA_Result receive(uint8_t* pRXData, uint16_t uSize);
 	QA_Result transceive(uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize);
 
+	//Register level full duplex transfer for short transfers (such as sensor register accesses), avoiding the overhead of HAL's
+	//state machine and timeouts. The next frame is written as soon as the TX buffer is empty, so with two frames in flight the shift
+	//register never idles, while the limit of two frames prevents receive overruns. Only to be used in master mode with 8bit data size
+	//If an overrun occurs anyway (such as when the transfer is held up by a long interrupt), or no progress is made for m_uTimeout
+	//polls of the status register, the overrun flag is cleared, CS is raised and the transfer is abandoned
+	//pTXData - Data to transmit, or NULL to transmit 0xFF dummy bytes
+	//pRXData - Buffer for received data, or NULL to discard received data
+	//uSize   - Number of bytes to transfer
+	//Returns QA_OK, QA_Fail on overrun or timeout, QA_Error_PeriphBusy if an asynchronous transfer is in progress, or
+	//QA_Error_PeriphNotSupported in 16bit data size mode
+	inline QA_Result transceiveFast(const uint8_t* pTXData, uint8_t* pRXData, uint8_t uSize) {
+		if (m_eAsyncState == QAD_SPI_Async_Busy)
+			return QA_Error_PeriphBusy;
+
+		SPI_TypeDef* pSPI = m_sHandle.Instance;
+		if (pSPI->CR1 & SPI_CR1_DFF)
+			return QA_Error_PeriphNotSupported;
+		if (!uSize)
+			return QA_OK;
+
+		volatile uint8_t* pDR = (volatile uint8_t*)&pSPI->DR;
+
+		if (m_bCS_Soft)
+			m_pCS_GPIO->BSRR = ((uint32_t)m_uCS_Pin << 16);
+		pSPI->CR1 |= SPI_CR1_SPE;
+
+		//Discard any stale received data, which also clears any overrun left from a previous transfer
+		(void)*pDR;
+		(void)pSPI->SR;
+
+		QA_Result eRes  = QA_OK;
+		uint8_t   uTX   = 0;
+		uint8_t   uRX   = 0;
+		uint16_t  uIdle = 0;
+		while (uRX < uSize) {
+			uint32_t uSR = pSPI->SR;
+
+			//Abandon transfer on overrun, clearing the flag by reading the data register followed by the status register
+			if (uSR & SPI_SR_OVR) {
+				(void)*pDR;
+				(void)pSPI->SR;
+				eRes = QA_Fail;
+				break;
+			}
+
+			bool bProgress = false;
+			if ((uSR & SPI_SR_TXE) && (uTX < uSize) && ((uint8_t)(uTX - uRX) < 2)) {
+				*pDR = pTXData ? pTXData[uTX] : 0xFF;
+				uTX++;
+				bProgress = true;
+			}
+			if (uSR & SPI_SR_RXNE) {
+				uint8_t uData = *pDR;
+				if (pRXData)
+					pRXData[uRX] = uData;
+				uRX++;
+				bProgress = true;
+			}
+
+			//Abandon transfer if the peripheral has stopped responding
+			if (bProgress) {
+				uIdle = 0;
+			} else if (++uIdle >= m_uTimeout) {
+				eRes = QA_Fail;
+				break;
+			}
+		}
+
+		uIdle = 0;
+		while ((pSPI->SR & SPI_SR_BSY) && (++uIdle < m_uTimeout)) {}
+		if (m_bCS_Soft)
+			m_pCS_GPIO->BSRR = m_uCS_Pin;
+		return eRes;
+	}
+
+
+		//-------------------------------
+		//Asynchronous Transceive Methods
+
+	QA_Result transmitAsync(uint8_t* pTXData, uint16_t uSize);
+	QA_Result receiveAsync(uint8_t* pRXData, uint16_t uSize);
+	QA_Result transceiveAsync(uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize);
+	QA_Result transferAsync(const QAD_SPI_Segment* pSegments, uint8_t uCount);
+	void abortAsync(void);
+
+	//Returns the state of the current or last asynchronous transfer
+	QAD_SPI_AsyncState getAsyncState(void) {
+		return m_eAsyncState;
+	}
+
+	//Returns true while an asynchronous transfer is in progress
+	bool isAsyncBusy(void) {
+		return (m_eAsyncState == QAD_SPI_Async_Busy);
+	}
+
+	//Sets a function to be called from the DMA interrupt when an asynchronous transfer completes or fails
+	//getAsyncState() can be used within the callback to determine the outcome. Set pCallback to NULL to disable
+	void setAsyncCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+		m_pAsyncCallback     = pCallback;
+		m_pAsyncCallbackData = pData;
+	}
+
+
+		//------------------
+		//Slave Mode Methods
+
+	QA_Result slaveStart(uint16_t uRXSize, uint16_t uTXSize);
+	void slaveStop(void);
+	QA_Result slaveSetResponse(const uint8_t* pData, uint16_t uSize);
+	uint16_t slaveRead(uint8_t* pData, uint16_t uMaxSize);
+
+	//Returns the number of received frames waiting to be read
+	uint8_t slaveGetFrameCount(void) {
+		return (uint8_t)(m_uSlaveFrameHead - m_uSlaveFrameTail);
+	}
+
+	//Returns the number of frames dropped because the frame queue was full, or because they were too large for the RX buffer
+	uint32_t slaveGetDropped(void) {
+		return m_uSlaveDropped;
+	}
+
+	//Sets a function to be called from the NSS interrupt each time a frame is received in slave mode. Set pCallback to NULL to disable
+	void setSlaveCallback(QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+		m_pSlaveCallback     = pCallback;
+		m_pSlaveCallbackData = pData;
+	}
+
+
+		//-------------------
+		//IRQ Handler Methods
+
+	void handlerDMA(void);
+	void handlerNSS(void);
+
 
 private:
 
@@ -308,6 +554,26 @@ private:
 	void periphDeinit(DeinitMode eDeinitMode);
 
 
+	//--------------------------------------
+	//Private Asynchronous Transceive Methods
+	QA_Result startSegment(void);
+	QA_Result stopDMA(void);
+	void finishAsync(QAD_SPI_AsyncState eState);
+	uint32_t getDMAFlags(const QAD_SPI_DMAStream* pDMA);
+	void clearDMAFlags(const QAD_SPI_DMAStream* pDMA);
+
+
+	//---------------------------
+	//Private IRQ Handler Methods
+	static void handlerDMACallback(void* pData);
+
+
+	//--------------------------
+	//Private Slave Mode Methods
+	void slaveStartTX(void);
+	IRQn_Type slaveGetNSSIRQ(void);
+
+
 };
 
 
@@ -0,0 +1,602 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Drivers                                                       */
+/*   Role: Servo Sequencer Driver                                          */
+/*   Filename: QAD_ServoSeq.cpp                                            */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAD_ServoSeq.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //-----------------------------------
+  //-----------------------------------
+  //QAD_ServoSeq Initialization Methods
+
+//QAD_ServoSeq::init
+//QAD_ServoSeq Initialization Method
+//
+//Used to initialize the servo sequencer driver
+//In DMA mode DMA2 Stream1 and Stream3 are registered with QAD_DMAMgr, and QA_Error_PeriphBusy is returned if either is already in use
+//Returns QA_OK if initialization successful, or an error if not successful (a member of QA_Result as defined in setup.hpp)
+QA_Result QAD_ServoSeq::init(void) {
+
+	//Check if selected Timer peripheral is currently available
+	if (QAD_TimerMgr::getState(m_eTimer))
+		return QA_Error_PeriphBusy;
+
+	//Register Timer peripheral as now being in use
+	QAD_TimerMgr::registerTimer(m_eTimer, QAD_Timer_InUse_ServoSeq);
+
+	//Register DMA streams as now being in use
+	QA_Result eRes = registerDMA();
+	if (eRes) {
+		QAD_TimerMgr::deregisterTimer(m_eTimer);
+		return eRes;
+	}
+
+	//Initialize the Timer peripheral
+	eRes = periphInit();
+
+	//If initialization failed then deregister the DMA streams and Timer peripheral
+	if (eRes) {
+		deregisterDMA();
+		QAD_TimerMgr::deregisterTimer(m_eTimer);
+	}
+
+	//Return initialization result
+	return eRes;
+}
+
+
+//QAD_ServoSeq::deinit
+//QAD_ServoSeq Initialization Method
+//
+//Used to deinitialize the servo sequencer driver
+void QAD_ServoSeq::deinit(void) {
+
+	//Return if driver is not currently initialized
+	if (!m_eInitState)
+		return;
+
+	//Deinitialize driver
+	periphDeinit(DeinitFull);
+
+	//Deregister DMA streams and Timer peripheral
+	deregisterDMA();
+	QAD_TimerMgr::deregisterTimer(m_eTimer);
+}
+
+
+  //--------------------------------
+  //--------------------------------
+  //QAD_ServoSeq IRQ Handler Methods
+
+//QAD_ServoSeq::handler
+//QAD_ServoSeq IRQ Handler Method
+//
+//To be called from the timer peripheral's IRQ handler(s) in IRQ mode
+//Compare events end the pulses of the current slot. Update events move to the next slot, starting its pulses and setting
+//the compare values for each channel. Compare events are handled first so that they always refer to the slot they belong to.
+void QAD_ServoSeq::handler(void) {
+	TIM_TypeDef* pTIM = m_sHandle.Instance;
+	uint32_t     uSR  = pTIM->SR & pTIM->DIER;
+
+	//Compare events - end pulses for current slot
+	for (uint8_t i=0; i<m_uChannels; i++) {
+		uint32_t uFlag = (TIM_SR_CC1IF << i);
+		if (uSR & uFlag) {
+			pTIM->SR = ~uFlag;
+			Slot& sSlot = m_sSlots[i][m_uSlot];
+			if (sSlot.pGPIO)
+				sSlot.pGPIO->BSRR = ((uint32_t)sSlot.uPin << 16);
+		}
+	}
+
+	//Update event - start pulses for next slot
+	if (uSR & TIM_SR_UIF) {
+		pTIM->SR = ~TIM_SR_UIF;
+		m_uSlot  = (m_uSlot + 1) & (QAD_SERVOSEQ_SLOTS - 1);
+
+		volatile uint32_t* pCCR = &pTIM->CCR1;
+		for (uint8_t i=0; i<m_uChannels; i++) {
+			Slot& sSlot = m_sSlots[i][m_uSlot];
+			if (sSlot.pGPIO) {
+				pCCR[i] = sSlot.uPulse;
+				sSlot.pGPIO->BSRR = sSlot.uPin;
+			}
+		}
+	}
+}
+
+
+//QAD_ServoSeq::handlerDMA
+//QAD_ServoSeq IRQ Handler Method
+//
+//To be called from DMA2_Stream1_IRQHandler in DMA mode
+//The transfer complete interrupt occurs once per frame, when the BSRR stream switches to the other edge table buffer.
+//The buffer that has just completed is then rebuilt from the current pulse widths, to be used for the frame after next
+void QAD_ServoSeq::handlerDMA(void) {
+	uint32_t uFlags = DMA2->LISR & (DMA_LISR_TCIF1 | DMA_LISR_HTIF1 | DMA_LISR_TEIF1 | DMA_LISR_DMEIF1 | DMA_LISR_FEIF1);
+	DMA2->LIFCR = uFlags;
+
+	if (uFlags & DMA_LISR_TCIF1)
+		buildEdges((DMA2_Stream1->CR & DMA_SxCR_CT) ? 0 : 1);
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAD_ServoSeq Control Methods
+
+//QAD_ServoSeq::start
+//QAD_ServoSeq Control Method
+//
+//Starts the servo sequencer. In IRQ mode the first frame starts at the end of the current slot period
+//In DMA mode the first frame starts immediately. At least one servo must have been added, as this sets the GPIO port to be used
+void QAD_ServoSeq::start(void) {
+
+	if ((!m_eInitState) || (m_eState))
+		return;
+
+	TIM_TypeDef* pTIM = m_sHandle.Instance;
+
+	if (m_bDMA) {
+		if (!m_pDMAGPIO)
+			return;
+
+		//Build both edge table buffers
+		buildEdges(0);
+		buildEdges(1);
+
+		//Start BSRR and compare retargeting streams, then set compare value for first edge
+		startDMA(DMA2_Stream1, &m_pDMAGPIO->BSRR, m_uEdgeBSRR[0], m_uEdgeBSRR[1], true);
+		startDMA(DMA2_Stream3, &pTIM->CCR1, m_uEdgeCCR[0], m_uEdgeCCR[1], false);
+		pTIM->CCR1 = m_uEdgeCCR[1][QAD_SERVOSEQ_EDGES-1];
+		pTIM->CNT  = 0;
+		pTIM->SR   = 0;
+
+		//Enable channel 1 compare DMA requests and Timer peripheral
+		pTIM->DIER |= TIM_DIER_CC1DE;
+		__HAL_TIM_ENABLE(&m_sHandle);
+
+		m_eState = QA_Active;
+		return;
+	}
+
+	//Set compare values beyond the timer period so no compare events occur before the first slot
+	volatile uint32_t* pCCR = &pTIM->CCR1;
+	for (uint8_t i=0; i<m_uChannels; i++)
+		pCCR[i] = 0xFFFF;
+
+	//Set slot so that first update event moves to slot 0
+	m_uSlot   = QAD_SERVOSEQ_SLOTS - 1;
+	pTIM->CNT = 0;
+	pTIM->SR  = 0;
+
+	//Enable update and compare interrupts
+	uint32_t uDIER = TIM_DIER_UIE;
+	for (uint8_t i=0; i<m_uChannels; i++)
+		uDIER |= (TIM_DIER_CC1IE << i);
+	pTIM->DIER |= uDIER;
+
+	//Enable Timer peripheral
+	__HAL_TIM_ENABLE(&m_sHandle);
+
+	//Set driver state to active
+	m_eState = QA_Active;
+}
+
+
+//QAD_ServoSeq::stop
+//QAD_ServoSeq Control Method
+//
+//Stops the servo sequencer, making sure all servo outputs are left low
+void QAD_ServoSeq::stop(void) {
+
+	if ((!m_eInitState) || (!m_eState))
+		return;
+
+	//Disable Timer peripheral, interrupts and DMA requests
+	__HAL_TIM_DISABLE(&m_sHandle);
+	m_sHandle.Instance->DIER = 0;
+
+	//Stop DMA streams
+	if (m_bDMA) {
+		stopDMA(DMA2_Stream1);
+		stopDMA(DMA2_Stream3);
+	}
+
+	//Set all outputs low
+	for (uint8_t i=0; i<m_uChannels; i++) {
+		for (uint8_t j=0; j<QAD_SERVOSEQ_SLOTS; j++) {
+			if (m_sSlots[i][j].pGPIO)
+				m_sSlots[i][j].pGPIO->BSRR = ((uint32_t)m_sSlots[i][j].uPin << 16);
+		}
+	}
+
+	//Set driver state to inactive
+	m_eState = QA_Inactive;
+}
+
+
+//QAD_ServoSeq::addServo
+//QAD_ServoSeq Control Method
+//
+//Assigns a servo to a channel and slot, and initializes its GPIO pin as an output. The driver must already be initialized
+//uChannel - Timer channel index (0 to 3). Must be less than the number of channels supported by the timer peripheral
+//uSlot    - Slot index (0 to 7)
+//pGPIO    - GPIO port to be used by the servo. In DMA mode all servos must use the same GPIO port
+//uPin     - GPIO pin to be used by the servo
+//uPulse   - Initial pulse width in microseconds
+//Returns QA_OK if successful, or QA_Fail if the channel or slot is invalid, the slot is already in use, or in DMA mode
+//the GPIO port differs from that of servos already added
+QA_Result QAD_ServoSeq::addServo(uint8_t uChannel, uint8_t uSlot, GPIO_TypeDef* pGPIO, uint16_t uPin, uint16_t uPulse) {
+
+	if ((uChannel >= m_uChannels) || (uSlot >= QAD_SERVOSEQ_SLOTS) || (!pGPIO))
+		return QA_Fail;
+
+	if (m_sSlots[uChannel][uSlot].pGPIO)
+		return QA_Fail;
+
+	if (m_bDMA) {
+		if ((m_pDMAGPIO) && (m_pDMAGPIO != pGPIO))
+			return QA_Fail;
+		m_pDMAGPIO = pGPIO;
+	}
+
+	//Init GPIO, making sure output is low before the pin is switched to output mode
+	HAL_GPIO_WritePin(pGPIO, uPin, GPIO_PIN_RESET);
+	GPIO_InitTypeDef GPIO_Init = {0};
+	GPIO_Init.Pin   = uPin;
+	GPIO_Init.Mode  = GPIO_MODE_OUTPUT_PP;
+	GPIO_Init.Pull  = GPIO_NOPULL;
+	GPIO_Init.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(pGPIO, &GPIO_Init);
+
+	//Set slot data. GPIO port is set last, as handler() uses it to determine if the slot is in use
+	setPulse(uChannel, uSlot, uPulse);
+	m_sSlots[uChannel][uSlot].uPin  = uPin;
+	__DMB();
+	m_sSlots[uChannel][uSlot].pGPIO = pGPIO;
+
+	return QA_OK;
+}
+
+
+//QAD_ServoSeq::removeServo
+//QAD_ServoSeq Control Method
+//
+//Removes a servo from a channel and slot, and deinitializes its GPIO pin
+//uChannel - Timer channel index (0 to 3)
+//uSlot    - Slot index (0 to 7)
+void QAD_ServoSeq::removeServo(uint8_t uChannel, uint8_t uSlot) {
+
+	if ((uChannel >= QAD_SERVOSEQ_CHANNELS) || (uSlot >= QAD_SERVOSEQ_SLOTS))
+		return;
+
+	Slot& sSlot = m_sSlots[uChannel][uSlot];
+	if (!sSlot.pGPIO)
+		return;
+
+	//Slot is cleared with interrupts disabled so a pulse cannot be left high
+	GPIO_TypeDef* pGPIO = sSlot.pGPIO;
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	sSlot.pGPIO  = NULL;
+	pGPIO->BSRR  = ((uint32_t)sSlot.uPin << 16);
+	__set_PRIMASK(uPRIMASK);
+
+	HAL_GPIO_DeInit(pGPIO, sSlot.uPin);
+
+	//In DMA mode, allow a different GPIO port to be used once all servos have been removed while the driver is stopped
+	if ((m_bDMA) && (!m_eState)) {
+		bool bUsed = false;
+		for (uint8_t i=0; i<QAD_SERVOSEQ_CHANNELS; i++) {
+			for (uint8_t j=0; j<QAD_SERVOSEQ_SLOTS; j++) {
+				if (m_sSlots[i][j].pGPIO)
+					bUsed = true;
+			}
+		}
+		if (!bUsed)
+			m_pDMAGPIO = NULL;
+	}
+}
+
+
+//QAD_ServoSeq::getPulse
+//QAD_ServoSeq Control Method
+//
+//Returns the pulse width in microseconds for a servo
+//uChannel - Timer channel index (0 to 3)
+//uSlot    - Slot index (0 to 7)
+uint16_t QAD_ServoSeq::getPulse(uint8_t uChannel, uint8_t uSlot) {
+
+	if ((uChannel >= QAD_SERVOSEQ_CHANNELS) || (uSlot >= QAD_SERVOSEQ_SLOTS))
+		return 0;
+
+	return m_sSlots[uChannel][uSlot].uPulse;
+}
+
+
+  //-------------------------------------------
+  //-------------------------------------------
+  //QAD_ServoSeq Private Initialization Methods
+
+//QAD_ServoSeq::periphInit
+//QAD_ServoSeq Private Initialization Method
+//
+//Used to initialize the timer peripheral clock, the timer peripheral itself with a 1MHz count, and the output compare channels,
+//as well as setting interrupt priorities and enabling interrupts
+//In IRQ mode the timer period is one 2.5ms slot. In DMA mode the timer period is a whole 20ms frame, only channel 1 is used
+//to generate edges, and the DMA2 clock is enabled
+//Returns QA_OK if successful, or QA_Fail if initialization fails
+QA_Result QAD_ServoSeq::periphInit(void) {
+
+	m_uChannels = QAD_TimerMgr::getChannels(m_eTimer);
+	if (m_uChannels > QAD_SERVOSEQ_CHANNELS)
+		m_uChannels = QAD_SERVOSEQ_CHANNELS;
+
+	//Enable DMA Clock
+	if (m_bDMA)
+		__HAL_RCC_DMA2_CLK_ENABLE();
+
+	//Enable Timer Clock
+	QAD_TimerMgr::enableClock(m_eTimer);
+
+	//Initialize Timer Peripheral
+	m_sHandle.Instance               = QAD_TimerMgr::getInstance(m_eTimer);               //Set instance for required Timer peripheral
+	m_sHandle.Init.Prescaler         = (QAD_TimerMgr::getClockSpeed(m_eTimer) / 1000000) - 1; //Set timer prescaler for 1MHz count
+	m_sHandle.Init.CounterMode       = TIM_COUNTERMODE_UP;                                 //Set timer counter mode to count up
+	m_sHandle.Init.Period            = (m_bDMA ? (QAD_SERVOSEQ_SLOTPERIOD * QAD_SERVOSEQ_SLOTS) : QAD_SERVOSEQ_SLOTPERIOD) - 1; //Set timer counter period to length of one frame or slot
+	m_sHandle.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;                             //Unused
+	m_sHandle.Init.RepetitionCounter = 0x0;                                                //
+	m_sHandle.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;                      //Enable preload of the timer's auto-reload register
+
+	//Initialize Timer, performing a partial deinitialization if the initialization fails
+	if (HAL_TIM_OC_Init(&m_sHandle) != HAL_OK) {
+		periphDeinit(DeinitPartial);
+		return QA_Fail;
+	}
+
+	//Init Output Compare Channels
+	//Timing mode is used so the channels only generate compare events, and compare preload is left disabled so new compare
+	//values take effect immediately when written from handler(), or by the compare retargeting DMA stream in DMA mode
+	const uint32_t uChannelSelect[QAD_SERVOSEQ_CHANNELS] = {TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4};
+	TIM_OC_InitTypeDef TIM_OC_Init = {0};
+	TIM_OC_Init.OCMode     = TIM_OCMODE_TIMING;
+	TIM_OC_Init.Pulse      = 0xFFFF;
+	TIM_OC_Init.OCPolarity = TIM_OCPOLARITY_HIGH;
+	TIM_OC_Init.OCFastMode = TIM_OCFAST_DISABLE;
+	for (uint8_t i=0; i<(m_bDMA ? 1 : m_uChannels); i++) {
+		if (HAL_TIM_OC_ConfigChannel(&m_sHandle, &TIM_OC_Init, uChannelSelect[i]) != HAL_OK) {
+			periphDeinit(DeinitFull);
+			return QA_Fail;
+		}
+	}
+
+	//Set DMA IRQ priority and enable IRQ
+	if (m_bDMA) {
+		HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, m_uIRQPriority, 0);
+		HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+
+		m_eInitState = QA_Initialized;
+		m_eState     = QA_Inactive;
+		return QA_OK;
+	}
+
+	//Set Timer IRQ priorities and enable IRQs
+	HAL_NVIC_SetPriority(QAD_TimerMgr::getUpdateIRQ(m_eTimer), m_uIRQPriority, 0);
+	HAL_NVIC_EnableIRQ(QAD_TimerMgr::getUpdateIRQ(m_eTimer));
+	if (QAD_TimerMgr::getCCIRQ(m_eTimer) != QAD_TimerMgr::getUpdateIRQ(m_eTimer)) {
+		HAL_NVIC_SetPriority(QAD_TimerMgr::getCCIRQ(m_eTimer), m_uIRQPriority, 0);
+		HAL_NVIC_EnableIRQ(QAD_TimerMgr::getCCIRQ(m_eTimer));
+	}
+
+	//Set driver states
+	m_eInitState = QA_Initialized;
+	m_eState     = QA_Inactive;
+
+	//Return
+	return QA_OK;
+}
+
+
+//QAD_ServoSeq::periphDeinit
+//QAD_ServoSeq Private Initialization Method
+//
+//Used to deinitialize the timer peripheral clock and the peripheral itself, as well as disabling interrupts and servo GPIOs
+//eDeinitMode - Set to DeinitPartial to perform a partial deinitialization (only to be used by periphInit() method
+//              in a case where peripheral initialization has failed
+//            - Set to DeinitFull to perform a full deinitialization in a case where the driver is fully initialized
+void QAD_ServoSeq::periphDeinit(QAD_ServoSeq::DeinitMode eDeinitMode) {
+
+	//Check if full deinitialization is required
+	if (eDeinitMode) {
+
+		//Disable timer or DMA IRQs
+		if (m_bDMA) {
+			HAL_NVIC_DisableIRQ(DMA2_Stream1_IRQn);
+		} else {
+			HAL_NVIC_DisableIRQ(QAD_TimerMgr::getUpdateIRQ(m_eTimer));
+			HAL_NVIC_DisableIRQ(QAD_TimerMgr::getCCIRQ(m_eTimer));
+		}
+
+		//Deinitialize Timer peripheral
+		HAL_TIM_OC_DeInit(&m_sHandle);
+
+		//Deinitialize servo GPIOs
+		for (uint8_t i=0; i<QAD_SERVOSEQ_CHANNELS; i++) {
+			for (uint8_t j=0; j<QAD_SERVOSEQ_SLOTS; j++)
+				removeServo(i, j);
+		}
+	}
+
+	//Disable Timer Clock
+	QAD_TimerMgr::disableClock(m_eTimer);
+
+	//Set driver states
+	m_eState     = QA_Inactive;
+	m_eInitState = QA_NotInitialized;
+}
+
+
+  //--------------------------
+  //--------------------------
+  //QAD_ServoSeq Tools Methods
+
+//QAD_ServoSeq::buildEdges
+//QAD_ServoSeq Tools Method
+//
+//Builds one buffer of the DMA mode edge tables from the current pulse widths
+//Each slot has a fixed number of edges: a rising edge for all of the slot's servos at the start of the slot, followed by the
+//falling edges in time order. Falling edges closer together than QAD_SERVOSEQ_EDGEGAP are combined, and unused edges are filled
+//with edges that write nothing, placed after the longest possible pulse. As each compare event writes the compare value of the
+//following edge, the compare table is offset by one edge from the BSRR table, with its final entry being the first edge of the next frame
+//uBuf - Index of buffer to be built (0 or 1)
+void QAD_ServoSeq::buildEdges(uint8_t uBuf) {
+	uint32_t uTime[QAD_SERVOSEQ_EDGES];
+	uint8_t  uEdge = 0;
+
+	for (uint8_t i=0; i<QAD_SERVOSEQ_SLOTS; i++) {
+		uint32_t uStart = (i * QAD_SERVOSEQ_SLOTPERIOD) + QAD_SERVOSEQ_EDGEGAP;
+
+		//Collect slot's servos, sorted by pulse width
+		uint32_t uRise  = 0;
+		uint16_t uPulse[QAD_SERVOSEQ_CHANNELS];
+		uint16_t uPin[QAD_SERVOSEQ_CHANNELS];
+		uint8_t  uCount = 0;
+		for (uint8_t j=0; j<m_uChannels; j++) {
+			Slot& sSlot = m_sSlots[j][i];
+			if (!sSlot.pGPIO)
+				continue;
+
+			uint16_t uSlotPulse = sSlot.uPulse;
+			uint8_t  k = uCount++;
+			while ((k) && (uPulse[k-1] > uSlotPulse)) {
+				uPulse[k] = uPulse[k-1];
+				uPin[k]   = uPin[k-1];
+				k--;
+			}
+			uPulse[k] = uSlotPulse;
+			uPin[k]   = sSlot.uPin;
+			uRise    |= sSlot.uPin;
+		}
+
+		//Rising edge
+		uTime[uEdge]               = uStart;
+		m_uEdgeBSRR[uBuf][uEdge++] = uRise;
+
+		//Falling edges
+		uint32_t uLast = uStart;
+		for (uint8_t j=0; j<uCount; j++) {
+			uint32_t uFall = uStart + uPulse[j];
+			if (uFall < (uLast + QAD_SERVOSEQ_EDGEGAP)) {
+				m_uEdgeBSRR[uBuf][uEdge-1] |= ((uint32_t)uPin[j] << 16);
+			} else {
+				uTime[uEdge]               = uFall;
+				m_uEdgeBSRR[uBuf][uEdge++] = ((uint32_t)uPin[j] << 16);
+				uLast                      = uFall;
+			}
+		}
+
+		//Unused edges
+		uint32_t uPad = uStart + QAD_SERVOSEQ_MAXPULSE;
+		while (uEdge < ((i + 1) * (QAD_SERVOSEQ_CHANNELS + 1))) {
+			uPad                      += QAD_SERVOSEQ_EDGEGAP;
+			uTime[uEdge]               = uPad;
+			m_uEdgeBSRR[uBuf][uEdge++] = 0;
+		}
+	}
+
+	//Compare values of following edges
+	for (uint8_t i=0; i<QAD_SERVOSEQ_EDGES; i++)
+		m_uEdgeCCR[uBuf][i] = uTime[(i + 1) % QAD_SERVOSEQ_EDGES];
+}
+
+
+//QAD_ServoSeq::registerDMA
+//QAD_ServoSeq Tools Method
+//
+//In DMA mode, registers DMA2 Stream1 and Stream3 with QAD_DMAMgr so that no other driver can use them (e.g. asynchronous
+//SPI4/SPI5 transfers use DMA2 Stream3). Does nothing in IRQ mode
+//Returns QA_OK if successful, or QA_Error_PeriphBusy if either stream is already in use
+QA_Result QAD_ServoSeq::registerDMA(void) {
+	if (!m_bDMA)
+		return QA_OK;
+
+	QA_Result eRes = QAD_DMAMgr::registerStream(DMA2_Stream1, QAD_DMA_InUse_ServoSeq);
+	if (eRes)
+		return eRes;
+
+	eRes = QAD_DMAMgr::registerStream(DMA2_Stream3, QAD_DMA_InUse_ServoSeq);
+	if (eRes)
+		QAD_DMAMgr::deregisterStream(DMA2_Stream1, QAD_DMA_InUse_ServoSeq);
+	return eRes;
+}
+
+
+//QAD_ServoSeq::deregisterDMA
+//QAD_ServoSeq Tools Method
+//
+//In DMA mode, releases DMA2 Stream1 and Stream3 registered by registerDMA()
+void QAD_ServoSeq::deregisterDMA(void) {
+	if (!m_bDMA)
+		return;
+
+	QAD_DMAMgr::deregisterStream(DMA2_Stream1, QAD_DMA_InUse_ServoSeq);
+	QAD_DMAMgr::deregisterStream(DMA2_Stream3, QAD_DMA_InUse_ServoSeq);
+}
+
+
+//QAD_ServoSeq::startDMA
+//QAD_ServoSeq Tools Method
+//
+//Starts a DMA2 stream in double buffer mode, transferring one word of an edge table per TIM1 channel 1 compare event
+//pStream - DMA2 stream to be started (stream 1 or 3, both of which carry TIM1_CH1 requests on channel 6)
+//pDest   - Register to be written
+//pBuf0   - First edge table buffer
+//pBuf1   - Second edge table buffer
+//bIRQ    - Set to true to enable the transfer complete interrupt
+void QAD_ServoSeq::startDMA(DMA_Stream_TypeDef* pStream, volatile uint32_t* pDest, uint32_t* pBuf0, uint32_t* pBuf1, bool bIRQ) {
+	stopDMA(pStream);
+
+	pStream->PAR  = (uint32_t)pDest;
+	pStream->M0AR = (uint32_t)pBuf0;
+	pStream->M1AR = (uint32_t)pBuf1;
+	pStream->NDTR = QAD_SERVOSEQ_EDGES;
+	pStream->FCR  = 0;
+	pStream->CR   = DMA_CHANNEL_6 | DMA_SxCR_PL | DMA_SxCR_DBM | DMA_SxCR_CIRC | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 |
+			            DMA_SxCR_MINC | DMA_SxCR_DIR_0 | (bIRQ ? DMA_SxCR_TCIE : 0);
+	pStream->CR  |= DMA_SxCR_EN;
+}
+
+
+//QAD_ServoSeq::stopDMA
+//QAD_ServoSeq Tools Method
+//
+//Disables a DMA2 stream, waits for it to stop, and clears its flags
+//pStream - DMA2 stream to be stopped (stream 1 or 3)
+void QAD_ServoSeq::stopDMA(DMA_Stream_TypeDef* pStream) {
+	pStream->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE);
+	while (pStream->CR & DMA_SxCR_EN) {}
+
+	if (pStream == DMA2_Stream1)
+		DMA2->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1; else
+		DMA2->LIFCR = DMA_LIFCR_CTCIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTEIF3 | DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CFEIF3;
+}
@@ -0,0 +1,252 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Drivers                                                       */
+/*   Role: Servo Sequencer Driver                                          */
+/*   Filename: QAD_ServoSeq.hpp                                            */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAD_SERVOSEQ_HPP_
+#define __QAD_SERVOSEQ_HPP_
+
+//Includes
+#include "setup.hpp"
+
+#include "QAD_TimerMgr.hpp"
+#include "QAD_DMAMgr.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//NOTE: The servo sequencer divides each 20ms servo frame into eight 2.5ms slots. At the start of each slot the pin of the servo
+//assigned to that slot on each timer channel is raised, and it is lowered once the servo's pulse width has elapsed.
+//The sequencer has two modes, selected by the timer peripheral being used:
+//
+//DMA mode (TIM1) - Pulse edges are hardware timed. A table of edge times and GPIO BSRR values is precomputed for a whole frame.
+//                  Each compare event on TIM1 channel 1 triggers two DMA2 streams: stream 1 writes the edge's value to the GPIO
+//                  port's BSRR register, and stream 3 retargets the channel 1 compare register to the time of the next edge.
+//                  The tables are double buffered, and the buffer not in use is rebuilt from the current pulse widths by the
+//                  DMA transfer complete interrupt once per frame, so pulse widths are unaffected by interrupt latency.
+//                  As a DMA stream has a single destination, all servos must be on the same GPIO port, and as only DMA2 can
+//                  access the GPIO ports and TIM1 is the only timer on this device with DMA2 requests, this mode requires TIM1.
+//                  The channel index is used only to group servos. DMA2 streams 1 and 3 are registered with QAD_DMAMgr by
+//                  init(), which returns QA_Error_PeriphBusy if either is already in use (e.g. by asynchronous SPI4/SPI5
+//                  transfers, which use DMA2 stream 3).
+//
+//IRQ mode (other timers) - Each timer channel drives eight servos, so a four channel timer can drive 32 servos on any GPIO pins.
+//                  The update interrupt raises the pins of the next slot and sets each channel's compare value to the servo's
+//                  pulse width, and the compare interrupts lower the pins, so pulse widths include interrupt latency jitter.
+
+
+//--------------------------
+//QAD_SERVOSEQ_CHANNELS
+//
+//Maximum number of timer channels used by the servo sequencer
+#define QAD_SERVOSEQ_CHANNELS     4
+
+//--------------------------
+//QAD_SERVOSEQ_SLOTS
+//
+//Number of servo slots per timer channel within each frame
+#define QAD_SERVOSEQ_SLOTS        8
+
+//--------------------------
+//QAD_SERVOSEQ_SLOTPERIOD
+//
+//Length of each slot in microseconds (8 slots of 2.5ms gives a 20ms/50Hz frame)
+#define QAD_SERVOSEQ_SLOTPERIOD   2500
+
+//--------------------------
+//QAD_SERVOSEQ_MINPULSE / QAD_SERVOSEQ_MAXPULSE
+//
+//Limits in microseconds for servo pulse widths. The maximum leaves time within each slot for interrupt latency
+#define QAD_SERVOSEQ_MINPULSE     400
+#define QAD_SERVOSEQ_MAXPULSE     2400
+
+//--------------------------
+//QAD_SERVOSEQ_EDGES
+//
+//Number of entries in each DMA mode edge table. Each slot has one rising edge and up to one falling edge per channel
+#define QAD_SERVOSEQ_EDGES        (QAD_SERVOSEQ_SLOTS * (QAD_SERVOSEQ_CHANNELS + 1))
+
+//--------------------------
+//QAD_SERVOSEQ_EDGEGAP
+//
+//Minimum time in microseconds between DMA mode edges, allowing both DMA streams to complete before the next compare event
+//Falling edges closer together than this are combined into a single edge
+#define QAD_SERVOSEQ_EDGEGAP      2
+
+
+//-----------------------
+//QAD_ServoSeq_InitStruct
+//
+//This structure is used to be able to create the QAD_ServoSeq driver class
+typedef struct {
+
+	QAD_Timer_Periph eTimer;        //Timer peripheral to be used. Member of QAD_Timer_Periph as defined in QAD_TimerMgr.hpp
+
+	uint8_t          uIRQPriority;  //IRQ Priority for update and compare interrupts (a value between 0 and 15)
+	                                //In IRQ mode this should be a high priority, as interrupt latency directly affects pulse accuracy
+	                                //In DMA mode this is used for the once per frame DMA interrupt, which is not timing critical
+
+} QAD_ServoSeq_InitStruct;
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//------------
+//QAD_ServoSeq
+//
+//Driver class used to drive up to eight servos per timer channel from a single timer peripheral
+//In DMA mode (TIM1), handlerDMA() must be called from DMA2_Stream1_IRQHandler
+//In IRQ mode (other timers), handler() must be called from the timer's IRQ handler
+class QAD_ServoSeq {
+private:
+
+	//Deinitialization mode to be used by periphDeinit() method
+	enum DeinitMode : uint8_t {
+		DeinitPartial = 0,        //Only to be used for partial deinitialization upon initialization failure in periphInit() method
+		DeinitFull                //Used for full driver deinitialization when driver is in a fully initialized state
+	};
+
+	//Servo slot data
+	typedef struct {
+		GPIO_TypeDef*     pGPIO;    //GPIO port used by servo, or NULL if slot is unused
+		uint16_t          uPin;     //GPIO pin used by servo
+		volatile uint16_t uPulse;   //Pulse width in microseconds
+	} Slot;
+
+	QA_InitState      m_eInitState;    //Stores whether the driver is currently initialized. Member of QA_InitState enum defined in setup.hpp
+	QA_ActiveState    m_eState;        //Stores whether the driver is currently active. Member of QA_ActiveState enum defined in setup.hpp
+
+	QAD_Timer_Periph  m_eTimer;        //Stores the particular timer peripheral to be used by the driver
+	TIM_HandleTypeDef m_sHandle;       //Handle used by HAL functions to access Timer peripheral (defined in stm32f4xx_hal_tim.h)
+	uint8_t           m_uIRQPriority;  //IRQ Priority for update and compare interrupts
+	uint8_t           m_uChannels;     //Number of channels supported by the selected timer peripheral
+
+	Slot              m_sSlots[QAD_SERVOSEQ_CHANNELS][QAD_SERVOSEQ_SLOTS];  //Servo data for each channel and slot
+	uint8_t           m_uSlot;         //Current slot (IRQ mode)
+
+	bool              m_bDMA;          //Set to true if the driver is using DMA mode (see note above)
+	GPIO_TypeDef*     m_pDMAGPIO;      //GPIO port shared by all servos in DMA mode, or NULL if no servos have been added
+	uint32_t          m_uEdgeBSRR[2][QAD_SERVOSEQ_EDGES];  //DMA mode edge tables - values written to GPIO BSRR register at each edge
+	uint32_t          m_uEdgeCCR[2][QAD_SERVOSEQ_EDGES];   //DMA mode edge tables - compare value of the following edge
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAD_ServoSeq() = delete;                        //Delete the default class constructor, as we need an initialization structure to be provided on class creation
+
+	QAD_ServoSeq(QAD_ServoSeq_InitStruct& sInit) :  //The class constructor to be used, which has a reference to an initialization structure passed to it
+		m_eInitState(QA_NotInitialized),
+		m_eState(QA_Inactive),
+		m_eTimer(sInit.eTimer),
+		m_sHandle({0}),
+		m_uIRQPriority(sInit.uIRQPriority),
+		m_uChannels(0),
+		m_uSlot(0),
+		m_bDMA(sInit.eTimer == QAD_Timer1),
+		m_pDMAGPIO(NULL) {
+
+		for (uint8_t i=0; i<QAD_SERVOSEQ_CHANNELS; i++) {
+			for (uint8_t j=0; j<QAD_SERVOSEQ_SLOTS; j++) {
+				m_sSlots[i][j].pGPIO  = NULL;
+				m_sSlots[i][j].uPin   = 0;
+				m_sSlots[i][j].uPulse = (QAD_SERVOSEQ_MINPULSE + QAD_SERVOSEQ_MAXPULSE) / 2;
+			}
+		}
+	}
+
+	~QAD_ServoSeq() {     //Destructor to make sure peripheral is made inactive and deinitialized upon class destruction
+
+		//Stop driver if currently active
+		if (m_eState)
+			stop();
+
+		//Deinitialize driver if currently initialized
+		if (m_eInitState)
+			deinit();
+	}
+
+
+	//NOTE: See QAD_ServoSeq.cpp for details of the following functions
+
+	//----------------------
+	//Initialization Methods
+
+	QA_Result init(void);
+	void deinit(void);
+
+
+	//-------------------
+	//IRQ Handler Methods
+
+	void handler(void);
+	void handlerDMA(void);
+
+
+	//---------------
+	//Control Methods
+
+	void start(void);
+	void stop(void);
+
+	QA_Result addServo(uint8_t uChannel, uint8_t uSlot, GPIO_TypeDef* pGPIO, uint16_t uPin, uint16_t uPulse);
+	void removeServo(uint8_t uChannel, uint8_t uSlot);
+
+	//Sets the pulse width for a servo. Takes effect from the servo's next slot in IRQ mode, or within two frames in DMA mode
+	//uChannel - Timer channel index (0 to 3)
+	//uSlot    - Slot index (0 to 7)
+	//uPulse   - Pulse width in microseconds. Will be clamped between QAD_SERVOSEQ_MINPULSE and QAD_SERVOSEQ_MAXPULSE
+	void setPulse(uint8_t uChannel, uint8_t uSlot, uint16_t uPulse) {
+		if ((uChannel >= QAD_SERVOSEQ_CHANNELS) || (uSlot >= QAD_SERVOSEQ_SLOTS))
+			return;
+		if (uPulse < QAD_SERVOSEQ_MINPULSE)
+			uPulse = QAD_SERVOSEQ_MINPULSE;
+		if (uPulse > QAD_SERVOSEQ_MAXPULSE)
+			uPulse = QAD_SERVOSEQ_MAXPULSE;
+		m_sSlots[uChannel][uSlot].uPulse = uPulse;
+	}
+
+	uint16_t getPulse(uint8_t uChannel, uint8_t uSlot);
+
+private:
+
+	//------------------------------
+	//Private Initialization Methods
+
+	QA_Result periphInit(void);
+	void periphDeinit(DeinitMode eDeinitMode);
+
+
+	//-------------
+	//Tools Methods
+
+	void buildEdges(uint8_t uBuf);
+	QA_Result registerDMA(void);
+	void deregisterDMA(void);
+	void startDMA(DMA_Stream_TypeDef* pStream, volatile uint32_t* pDest, uint32_t* pBuf0, uint32_t* pBuf1, bool bIRQ);
+	void stopDMA(DMA_Stream_TypeDef* pStream);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAD_SERVOSEQ_HPP_ */
@@ -0,0 +1,639 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Display                                                       */
+/*   Role: SPI TFT Display Driver                                          */
+/*   Filename: QAS_Display_TFT.cpp                                         */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAS_Display_TFT.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//ST7735 / ILI9341 Commands
+#define TFT_CMD_SWRESET     0x01
+#define TFT_CMD_SLPOUT      0x11
+#define TFT_CMD_NORON       0x13
+#define TFT_CMD_INVOFF      0x20
+#define TFT_CMD_DISPON      0x29
+#define TFT_CMD_CASET       0x2A
+#define TFT_CMD_RASET       0x2B
+#define TFT_CMD_RAMWR       0x2C
+#define TFT_CMD_MADCTL      0x36
+#define TFT_CMD_COLMOD      0x3A
+
+//COLMOD Setting for 16bit RGB565 Pixels
+#define TFT_COLMOD_RGB565   0x05
+
+//MADCTL BGR Subpixel Order Flag
+#define TFT_MADCTL_BGR      0x08
+
+//MADCTL Row/Column Exchange and Mirror Settings for each Rotation
+static const uint8_t TFT_MADCTL_ST7735[4]  = {0xC0, 0xA0, 0x00, 0x60};
+static const uint8_t TFT_MADCTL_ILI9341[4] = {0x40, 0x20, 0x80, 0xE0};
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //------------------------------------------
+  //------------------------------------------
+  //QAS_Display_TFT Constructors / Destructors
+
+//QAS_Display_TFT::QAS_Display_TFT
+//QAS_Display_TFT Constructor
+//
+//Stores the initialization settings and prepares the command and strip transactions. The display is not accessed until init() is called
+//pBus    - SPI bus the display is attached to
+//uDevice - Device index returned by QAS_SPI_Bus::addDevice()
+//sInit   - Initialization structure
+QAS_Display_TFT::QAS_Display_TFT(QAS_SPI_Bus* pBus, uint8_t uDevice, QAS_Display_TFT_InitStruct& sInit) :
+	m_pBus(pBus),
+	m_uDevice(uDevice),
+	m_eController(sInit.eController),
+	m_uPanelWidth(sInit.uWidth),
+	m_uPanelHeight(sInit.uHeight),
+	m_uColOffset(sInit.uColOffset),
+	m_uRowOffset(sInit.uRowOffset),
+	m_uRotation(sInit.uRotation & 0x03),
+	m_bBGR(sInit.bBGR),
+	m_pDC_GPIO(sInit.pDC_GPIO),
+	m_uDC_Pin(sInit.uDC_Pin),
+	m_pReset_GPIO(sInit.pReset_GPIO),
+	m_uReset_Pin(sInit.uReset_Pin),
+	m_eInitState(QA_NotInitialized),
+	m_uStripIdx(0),
+	m_uDirtyCount(0),
+	m_pRender(NULL),
+	m_pRenderData(NULL) {
+
+	//Landscape rotations exchange width and height
+	if (m_uRotation & 0x01) {
+		m_uWidth  = m_uPanelHeight;
+		m_uHeight = m_uPanelWidth;
+	} else {
+		m_uWidth  = m_uPanelWidth;
+		m_uHeight = m_uPanelHeight;
+	}
+
+	//Prepare command transactions
+	for (uint8_t i=0; i<5; i++) {
+		m_sCmdSegs[i].pTXData = m_uCmdData[i];
+		m_sCmdSegs[i].pRXData = NULL;
+		m_sCmdSegs[i].uSize   = 0;
+
+		m_sCmdTrans[i].uDevice        = uDevice;
+		m_sCmdTrans[i].uPriority      = 0;
+		m_sCmdTrans[i].pSegments      = &m_sCmdSegs[i];
+		m_sCmdTrans[i].uCount         = 1;
+		m_sCmdTrans[i].pStartCallback = handlerCommand;
+		m_sCmdTrans[i].pCallback      = NULL;
+		m_sCmdTrans[i].pCallbackData  = this;
+		m_sCmdTrans[i].eState         = QAS_SPI_Bus_Trans_Idle;
+		m_sCmdTrans[i].pNext          = NULL;
+	}
+
+	//Prepare strip transactions
+	for (uint8_t i=0; i<2; i++) {
+		m_sStripSegs[i].pTXData = (uint8_t*)m_uStrip[i];
+		m_sStripSegs[i].pRXData = NULL;
+		m_sStripSegs[i].uSize   = 0;
+
+		m_sStripTrans[i].uDevice        = uDevice;
+		m_sStripTrans[i].uPriority      = 0;
+		m_sStripTrans[i].pSegments      = &m_sStripSegs[i];
+		m_sStripTrans[i].uCount         = 1;
+		m_sStripTrans[i].pStartCallback = handlerData;
+		m_sStripTrans[i].pCallback      = NULL;
+		m_sStripTrans[i].pCallbackData  = this;
+		m_sStripTrans[i].eState         = QAS_SPI_Bus_Trans_Idle;
+		m_sStripTrans[i].pNext          = NULL;
+	}
+}
+
+
+  //--------------------------------------
+  //--------------------------------------
+  //QAS_Display_TFT Initialization Methods
+
+//QAS_Display_TFT::init
+//QAS_Display_TFT Initialization Method
+//
+//Initializes the data/command and reset pins, resets the display controller and configures it for RGB565 pixels in the selected rotation
+//Returns QA_OK if successful, or QA_Fail if a command could not be sent
+QA_Result QAS_Display_TFT::init(void) {
+	GPIO_InitTypeDef GPIO_Init = {0};
+	GPIO_Init.Mode  = GPIO_MODE_OUTPUT_PP;
+	GPIO_Init.Pull  = GPIO_NOPULL;
+	GPIO_Init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+
+	//Init DC GPIO Pin
+	HAL_GPIO_WritePin(m_pDC_GPIO, m_uDC_Pin, GPIO_PIN_SET);
+	GPIO_Init.Pin = m_uDC_Pin;
+	HAL_GPIO_Init(m_pDC_GPIO, &GPIO_Init);
+
+	//Init Reset GPIO Pin and perform hardware reset
+	if (m_pReset_GPIO) {
+		HAL_GPIO_WritePin(m_pReset_GPIO, m_uReset_Pin, GPIO_PIN_SET);
+		GPIO_Init.Pin   = m_uReset_Pin;
+		GPIO_Init.Speed = GPIO_SPEED_FREQ_LOW;
+		HAL_GPIO_Init(m_pReset_GPIO, &GPIO_Init);
+
+		HAL_Delay(5);
+		HAL_GPIO_WritePin(m_pReset_GPIO, m_uReset_Pin, GPIO_PIN_RESET);
+		HAL_Delay(10);
+		HAL_GPIO_WritePin(m_pReset_GPIO, m_uReset_Pin, GPIO_PIN_SET);
+		HAL_Delay(120);
+	}
+
+	//Software reset
+	if (sendCommand(TFT_CMD_SWRESET, NULL, 0) != QA_OK)
+		return QA_Fail;
+	HAL_Delay(150);
+
+	//Exit sleep mode
+	if (sendCommand(TFT_CMD_SLPOUT, NULL, 0) != QA_OK)
+		return QA_Fail;
+	HAL_Delay(120);
+
+	//Set 16bit RGB565 pixel format
+	uint8_t uParam = TFT_COLMOD_RGB565;
+	if (sendCommand(TFT_CMD_COLMOD, &uParam, 1) != QA_OK)
+		return QA_Fail;
+
+	//Set rotation and subpixel order
+	uParam = (m_eController == QAS_Display_TFT_ILI9341) ? TFT_MADCTL_ILI9341[m_uRotation] : TFT_MADCTL_ST7735[m_uRotation];
+	if (m_bBGR)
+		uParam |= TFT_MADCTL_BGR;
+	if (sendCommand(TFT_CMD_MADCTL, &uParam, 1) != QA_OK)
+		return QA_Fail;
+
+	//Normal display mode, with display on
+	if (sendCommand(TFT_CMD_INVOFF, NULL, 0) != QA_OK)
+		return QA_Fail;
+	if (sendCommand(TFT_CMD_NORON, NULL, 0) != QA_OK)
+		return QA_Fail;
+	HAL_Delay(10);
+	if (sendCommand(TFT_CMD_DISPON, NULL, 0) != QA_OK)
+		return QA_Fail;
+	HAL_Delay(100);
+
+	m_eInitState = QA_Initialized;
+	return QA_OK;
+}
+
+
+  //----------------------------------
+  //----------------------------------
+  //QAS_Display_TFT Addressing Methods
+
+//QAS_Display_TFT::setWindow
+//QAS_Display_TFT Addressing Method
+//
+//Queues the commands to set the display's address window and start a memory write. Pixel data sent after this call
+//(using writePixels(), or internally by fill() and update()) fills the window left to right, top to bottom
+//uX, uY          - Top left corner of window
+//uWidth, uHeight - Size of window in pixels
+//Returns QA_OK if successful, or QA_Fail if the window is empty, lies outside of the display, or a command could not be queued
+QA_Result QAS_Display_TFT::setWindow(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight) {
+	if ((!uWidth) || (!uHeight) || (((uint32_t)uX + uWidth) > m_uWidth) || (((uint32_t)uY + uHeight) > m_uHeight))
+		return QA_Fail;
+
+	//Panel offsets apply to the controller's column and row axes, which are exchanged in landscape rotations
+	uint16_t uX0 = uX + ((m_uRotation & 0x01) ? m_uRowOffset : m_uColOffset);
+	uint16_t uY0 = uY + ((m_uRotation & 0x01) ? m_uColOffset : m_uRowOffset);
+	uint16_t uX1 = uX0 + uWidth - 1;
+	uint16_t uY1 = uY0 + uHeight - 1;
+
+	//Wait for previous use of command transactions to complete
+	for (uint8_t i=0; i<5; i++)
+		waitTrans(m_sCmdTrans[i]);
+
+	//Column address set
+	m_uCmdData[0][0] = TFT_CMD_CASET;
+	m_uCmdData[1][0] = (uint8_t)(uX0 >> 8);
+	m_uCmdData[1][1] = (uint8_t)uX0;
+	m_uCmdData[1][2] = (uint8_t)(uX1 >> 8);
+	m_uCmdData[1][3] = (uint8_t)uX1;
+
+	//Row address set
+	m_uCmdData[2][0] = TFT_CMD_RASET;
+	m_uCmdData[3][0] = (uint8_t)(uY0 >> 8);
+	m_uCmdData[3][1] = (uint8_t)uY0;
+	m_uCmdData[3][2] = (uint8_t)(uY1 >> 8);
+	m_uCmdData[3][3] = (uint8_t)uY1;
+
+	//Memory write
+	m_uCmdData[4][0] = TFT_CMD_RAMWR;
+
+	if ((submitCommand(0, false, 1) != QA_OK) || (submitCommand(1, true, 4) != QA_OK) ||
+			(submitCommand(2, false, 1) != QA_OK) || (submitCommand(3, true, 4) != QA_OK) ||
+			(submitCommand(4, false, 1) != QA_OK))
+		return QA_Fail;
+
+	return QA_OK;
+}
+
+
+//QAS_Display_TFT::writePixels
+//QAS_Display_TFT Addressing Method
+//
+//Sends pixels to the window set by the last call to setWindow(). Pixels are copied through the strip buffers, so the source
+//data does not need to remain valid once this method returns, and the final strip may still be transferring when it does
+//pPixels - RGB565 pixel values
+//uCount  - Number of pixels to send
+//Returns QA_OK if successful, or QA_Fail if a strip could not be queued
+QA_Result QAS_Display_TFT::writePixels(const uint16_t* pPixels, uint32_t uCount) {
+	while (uCount) {
+		uint16_t uPixels = (uCount > QAS_DISPLAY_TFT_STRIPPIXELS) ? QAS_DISPLAY_TFT_STRIPPIXELS : uCount;
+		uint8_t uIdx = nextStrip();
+
+		for (uint16_t i=0; i<uPixels; i++)
+			m_uStrip[uIdx][i] = __REV16(pPixels[i]);
+
+		if (submitStrip(uIdx, uPixels) != QA_OK)
+			return QA_Fail;
+
+		pPixels += uPixels;
+		uCount  -= uPixels;
+	}
+
+	return QA_OK;
+}
+
+
+//QAS_Display_TFT::waitIdle
+//QAS_Display_TFT Addressing Method
+//
+//Waits until all of the display's queued command and strip transactions have completed
+void QAS_Display_TFT::waitIdle(void) {
+	for (uint8_t i=0; i<5; i++)
+		waitTrans(m_sCmdTrans[i]);
+	for (uint8_t i=0; i<2; i++)
+		waitTrans(m_sStripTrans[i]);
+}
+
+
+  //-------------------------------
+  //-------------------------------
+  //QAS_Display_TFT Drawing Methods
+
+//QAS_Display_TFT::fill
+//QAS_Display_TFT Drawing Method
+//
+//Fills a region of the display with a single color. Both strip buffers are filled once, and then sent repeatedly until the region is covered
+//The region is clipped to the display. The final strip may still be transferring when this method returns
+//uX, uY          - Top left corner of region
+//uWidth, uHeight - Size of region in pixels
+//uColor          - RGB565 color value
+//Returns QA_OK if successful, or QA_Fail if the region is empty or a transaction could not be queued
+QA_Result QAS_Display_TFT::fill(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight, uint16_t uColor) {
+	Rect sRect = {uX, uY, uWidth, uHeight};
+	clipRect(sRect);
+	if ((!sRect.uWidth) || (!sRect.uHeight))
+		return QA_Fail;
+
+	if (setWindow(sRect.uX, sRect.uY, sRect.uWidth, sRect.uHeight) != QA_OK)
+		return QA_Fail;
+
+	//Fill both strip buffers with color in display byte order
+	uint32_t uCount = (uint32_t)sRect.uWidth * sRect.uHeight;
+	uint16_t uFill  = (uCount > QAS_DISPLAY_TFT_STRIPPIXELS) ? QAS_DISPLAY_TFT_STRIPPIXELS : uCount;
+	uint16_t uValue = __REV16(uColor);
+	for (uint8_t i=0; i<2; i++) {
+		waitTrans(m_sStripTrans[i]);
+		for (uint16_t j=0; j<uFill; j++)
+			m_uStrip[i][j] = uValue;
+	}
+
+	//Send strips until region is covered
+	while (uCount) {
+		uint16_t uPixels = (uCount > uFill) ? uFill : uCount;
+		if (submitStrip(nextStrip(), uPixels) != QA_OK)
+			return QA_Fail;
+		uCount -= uPixels;
+	}
+
+	return QA_OK;
+}
+
+
+  //----------------------------------
+  //----------------------------------
+  //QAS_Display_TFT Dirty Rect Methods
+
+//QAS_Display_TFT::invalidate
+//QAS_Display_TFT Dirty Rect Method
+//
+//Marks a region of the display as needing to be redrawn by the next call to update(). The region is clipped to the display.
+//A region overlapping an existing dirty rectangle is merged with it, so overlapping areas are only sent once. When all dirty
+//rectangles are in use the region is merged with the rectangle whose bounding box grows the least. As a merged rectangle can
+//grow to overlap others, merging is repeated until no dirty rectangles overlap
+//uX, uY          - Top left corner of region
+//uWidth, uHeight - Size of region in pixels
+void QAS_Display_TFT::invalidate(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight) {
+	Rect sRect = {uX, uY, uWidth, uHeight};
+	clipRect(sRect);
+	if ((!sRect.uWidth) || (!sRect.uHeight))
+		return;
+
+	uint32_t uX1 = sRect.uX + sRect.uWidth;
+	uint32_t uY1 = sRect.uY + sRect.uHeight;
+
+	//Find existing rectangle to merge with. Overlapping rectangles are always merged, otherwise the rectangle whose
+	//bounding box grows the least is only used when no free rectangles remain
+	int8_t   iMerge = -1;
+	uint32_t uBestGrowth = 0xFFFFFFFF;
+	for (uint8_t i=0; i<m_uDirtyCount; i++) {
+		Rect& sDirty = m_sDirty[i];
+		if (overlapRect(sRect, sDirty)) {
+			iMerge = i;
+			break;
+		}
+
+		uint32_t uDX1 = sDirty.uX + sDirty.uWidth;
+		uint32_t uDY1 = sDirty.uY + sDirty.uHeight;
+		uint32_t uBX0 = (sRect.uX < sDirty.uX) ? sRect.uX : sDirty.uX;
+		uint32_t uBY0 = (sRect.uY < sDirty.uY) ? sRect.uY : sDirty.uY;
+		uint32_t uBX1 = (uX1 > uDX1) ? uX1 : uDX1;
+		uint32_t uBY1 = (uY1 > uDY1) ? uY1 : uDY1;
+		uint32_t uGrowth = ((uBX1 - uBX0) * (uBY1 - uBY0)) - ((uint32_t)sDirty.uWidth * sDirty.uHeight);
+		if ((m_uDirtyCount == QAS_DISPLAY_TFT_DIRTYRECTS) && (uGrowth < uBestGrowth)) {
+			uBestGrowth = uGrowth;
+			iMerge      = i;
+		}
+	}
+
+	//Add as new rectangle
+	if (iMerge < 0) {
+		m_sDirty[m_uDirtyCount++] = sRect;
+		return;
+	}
+
+	//Merge into existing rectangle, then fold any rectangles the grown rectangle now overlaps into it. Each fold grows the
+	//rectangle again, so scanning restarts until a full pass finds no overlaps
+	mergeRect(m_sDirty[iMerge], sRect);
+	uint8_t i = 0;
+	while (i < m_uDirtyCount) {
+		if ((i != iMerge) && overlapRect(m_sDirty[iMerge], m_sDirty[i])) {
+			mergeRect(m_sDirty[iMerge], m_sDirty[i]);
+
+			//Remove folded rectangle by moving the last rectangle into its place
+			m_uDirtyCount--;
+			if (iMerge == m_uDirtyCount)
+				iMerge = i;
+			m_sDirty[i] = m_sDirty[m_uDirtyCount];
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+}
+
+
+//QAS_Display_TFT::invalidateAll
+//QAS_Display_TFT Dirty Rect Method
+//
+//Marks the whole display as needing to be redrawn by the next call to update()
+void QAS_Display_TFT::invalidateAll(void) {
+	m_sDirty[0].uX      = 0;
+	m_sDirty[0].uY      = 0;
+	m_sDirty[0].uWidth  = m_uWidth;
+	m_sDirty[0].uHeight = m_uHeight;
+	m_uDirtyCount       = 1;
+}
+
+
+//QAS_Display_TFT::update
+//QAS_Display_TFT Dirty Rect Method
+//
+//Renders each dirty rectangle using the render function and sends it to the display. Rectangles that are sent are cleared, while
+//any that fail remain dirty
+//Each strip is rendered while the previous strip is transferred. The final strip may still be transferring when this method returns
+//Returns QA_OK if successful, or QA_Fail if no render function is set, the display is not initialized, or a transaction could not be queued
+QA_Result QAS_Display_TFT::update(void) {
+	if ((!m_pRender) || (m_eInitState != QA_Initialized))
+		return QA_Fail;
+
+	//Rectangles that fail to render are kept, compacted to the start of the array, so they are retried by the next update()
+	QA_Result eRes = QA_OK;
+	uint8_t uKept  = 0;
+	for (uint8_t i=0; i<m_uDirtyCount; i++) {
+		if (renderRect(m_sDirty[i]) != QA_OK) {
+			m_sDirty[uKept++] = m_sDirty[i];
+			eRes = QA_Fail;
+		}
+	}
+
+	m_uDirtyCount = uKept;
+	return eRes;
+}
+
+
+  //-------------------------------
+  //-------------------------------
+  //QAS_Display_TFT Handler Methods
+
+//QAS_Display_TFT::handlerCommand
+//QAS_Display_TFT Handler Method
+//
+//Start callback of command transactions, called by QAS_SPI_Bus before CS is lowered. Sets the data/command pin low
+//pData - Pointer to QAS_Display_TFT class
+void QAS_Display_TFT::handlerCommand(void* pData) {
+	QAS_Display_TFT* pDisplay = (QAS_Display_TFT*)pData;
+	pDisplay->m_pDC_GPIO->BSRR = (uint32_t)pDisplay->m_uDC_Pin << 16;
+}
+
+
+//QAS_Display_TFT::handlerData
+//QAS_Display_TFT Handler Method
+//
+//Start callback of parameter and pixel data transactions, called by QAS_SPI_Bus before CS is lowered. Sets the data/command pin high
+//pData - Pointer to QAS_Display_TFT class
+void QAS_Display_TFT::handlerData(void* pData) {
+	QAS_Display_TFT* pDisplay = (QAS_Display_TFT*)pData;
+	pDisplay->m_pDC_GPIO->BSRR = pDisplay->m_uDC_Pin;
+}
+
+
+  //-----------------------------
+  //-----------------------------
+  //QAS_Display_TFT Tools Methods
+
+//QAS_Display_TFT::sendCommand
+//QAS_Display_TFT Tools Method
+//
+//Sends a command with up to 4 parameter bytes, and waits for it to complete
+//uCmd    - Command byte
+//pParams - Parameter bytes, or NULL if uCount is 0
+//uCount  - Number of parameter bytes
+//Returns QA_OK if successful, or QA_Fail if a transaction failed
+QA_Result QAS_Display_TFT::sendCommand(uint8_t uCmd, const uint8_t* pParams, uint8_t uCount) {
+	if (uCount > 4)
+		return QA_Fail;
+
+	waitTrans(m_sCmdTrans[0]);
+	waitTrans(m_sCmdTrans[1]);
+
+	m_uCmdData[0][0] = uCmd;
+	if (submitCommand(0, false, 1) != QA_OK)
+		return QA_Fail;
+
+	if (uCount) {
+		for (uint8_t i=0; i<uCount; i++)
+			m_uCmdData[1][i] = pParams[i];
+		if (submitCommand(1, true, uCount) != QA_OK)
+			return QA_Fail;
+	}
+
+	waitTrans(m_sCmdTrans[0]);
+	waitTrans(m_sCmdTrans[1]);
+	if ((m_sCmdTrans[0].eState == QAS_SPI_Bus_Trans_Error) || (m_sCmdTrans[1].eState == QAS_SPI_Bus_Trans_Error))
+		return QA_Fail;
+
+	return QA_OK;
+}
+
+
+//QAS_Display_TFT::submitCommand
+//QAS_Display_TFT Tools Method
+//
+//Queues one of the command transactions. The transaction must not already be queued or active
+//uIdx  - Index of command transaction, whose data is held in m_uCmdData[uIdx]
+//bData - Set to true to send as data (data/command pin high), or false to send as a command (data/command pin low)
+//uSize - Number of bytes to send
+//Returns the result of QAS_SPI_Bus::submit()
+QA_Result QAS_Display_TFT::submitCommand(uint8_t uIdx, bool bData, uint8_t uSize) {
+	m_sCmdSegs[uIdx].uSize           = uSize;
+	m_sCmdTrans[uIdx].pStartCallback = bData ? handlerData : handlerCommand;
+	return m_pBus->submit(m_sCmdTrans[uIdx]);
+}
+
+
+//QAS_Display_TFT::submitStrip
+//QAS_Display_TFT Tools Method
+//
+//Queues one of the strip transactions to send pixel data. The strip buffer must already be in display byte order
+//uIdx    - Index of strip buffer
+//uPixels - Number of pixels to send
+//Returns the result of QAS_SPI_Bus::submit()
+QA_Result QAS_Display_TFT::submitStrip(uint8_t uIdx, uint16_t uPixels) {
+	m_sStripSegs[uIdx].uSize = uPixels * 2;
+	return m_pBus->submit(m_sStripTrans[uIdx]);
+}
+
+
+//QAS_Display_TFT::nextStrip
+//QAS_Display_TFT Tools Method
+//
+//Waits for the next strip buffer to finish transferring, and returns its index
+uint8_t QAS_Display_TFT::nextStrip(void) {
+	uint8_t uIdx = m_uStripIdx;
+	waitTrans(m_sStripTrans[uIdx]);
+	m_uStripIdx ^= 1;
+	return uIdx;
+}
+
+
+//QAS_Display_TFT::waitTrans
+//QAS_Display_TFT Tools Method
+//
+//Waits until a transaction is no longer queued or active
+void QAS_Display_TFT::waitTrans(QAS_SPI_Bus_Transaction& sTrans) {
+	while ((sTrans.eState == QAS_SPI_Bus_Trans_Queued) || (sTrans.eState == QAS_SPI_Bus_Trans_Active)) {}
+}
+
+
+//QAS_Display_TFT::renderRect
+//QAS_Display_TFT Tools Method
+//
+//Renders a region as strips of whole rows and sends them to the display. The render function fills one strip buffer while the
+//other is transferred, then the strip is converted to display byte order, two pixels at a time
+//sRect - Region to render. Must lie within the display
+//Returns QA_OK if successful, or QA_Fail if a transaction could not be queued
+QA_Result QAS_Display_TFT::renderRect(Rect& sRect) {
+	if (setWindow(sRect.uX, sRect.uY, sRect.uWidth, sRect.uHeight) != QA_OK)
+		return QA_Fail;
+
+	uint16_t uRows = QAS_DISPLAY_TFT_STRIPPIXELS / sRect.uWidth;
+	uint16_t uY1   = sRect.uY + sRect.uHeight;
+
+	for (uint16_t uY=sRect.uY; uY<uY1; uY+=uRows) {
+		uint16_t uHeight = ((uY1 - uY) < uRows) ? (uY1 - uY) : uRows;
+		uint16_t uPixels = sRect.uWidth * uHeight;
+		uint8_t  uIdx    = nextStrip();
+
+		m_pRender(sRect.uX, uY, sRect.uWidth, uHeight, m_uStrip[uIdx], m_pRenderData);
+
+		//Convert to display byte order
+		uint32_t* pWords = (uint32_t*)m_uStrip[uIdx];
+		for (uint16_t i=0; i<((uPixels + 1) >> 1); i++)
+			pWords[i] = __REV16(pWords[i]);
+
+		if (submitStrip(uIdx, uPixels) != QA_OK)
+			return QA_Fail;
+	}
+
+	return QA_OK;
+}
+
+
+//QAS_Display_TFT::clipRect
+//QAS_Display_TFT Tools Method
+//
+//Clips a rectangle to the display. Rectangles entirely outside of the display are returned with a width and height of 0
+void QAS_Display_TFT::clipRect(Rect& sRect) {
+	if ((sRect.uX >= m_uWidth) || (sRect.uY >= m_uHeight)) {
+		sRect.uWidth  = 0;
+		sRect.uHeight = 0;
+		return;
+	}
+
+	if (((uint32_t)sRect.uX + sRect.uWidth) > m_uWidth)
+		sRect.uWidth = m_uWidth - sRect.uX;
+	if (((uint32_t)sRect.uY + sRect.uHeight) > m_uHeight)
+		sRect.uHeight = m_uHeight - sRect.uY;
+}
+
+
+//QAS_Display_TFT::overlapRect
+//QAS_Display_TFT Tools Method
+//
+//Returns true if two rectangles share at least one pixel
+bool QAS_Display_TFT::overlapRect(const Rect& sA, const Rect& sB) {
+	return (sA.uX < (uint32_t)(sB.uX + sB.uWidth)) && (sB.uX < (uint32_t)(sA.uX + sA.uWidth)) &&
+	       (sA.uY < (uint32_t)(sB.uY + sB.uHeight)) && (sB.uY < (uint32_t)(sA.uY + sA.uHeight));
+}
+
+
+//QAS_Display_TFT::mergeRect
+//QAS_Display_TFT Tools Method
+//
+//Grows a rectangle to the bounding box of itself and a second rectangle
+void QAS_Display_TFT::mergeRect(Rect& sDst, const Rect& sSrc) {
+	uint32_t uX1 = sDst.uX + sDst.uWidth;
+	uint32_t uY1 = sDst.uY + sDst.uHeight;
+	uint32_t uSX1 = sSrc.uX + sSrc.uWidth;
+	uint32_t uSY1 = sSrc.uY + sSrc.uHeight;
+	if (sSrc.uX < sDst.uX)
+		sDst.uX = sSrc.uX;
+	if (sSrc.uY < sDst.uY)
+		sDst.uY = sSrc.uY;
+	sDst.uWidth  = ((uSX1 > uX1) ? uSX1 : uX1) - sDst.uX;
+	sDst.uHeight = ((uSY1 > uY1) ? uSY1 : uY1) - sDst.uY;
+}
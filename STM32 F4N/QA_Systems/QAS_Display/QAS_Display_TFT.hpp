@@ -0,0 +1,242 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Display                                                       */
+/*   Role: SPI TFT Display Driver                                          */
+/*   Filename: QAS_Display_TFT.hpp                                         */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAS_DISPLAY_TFT_HPP_
+#define __QAS_DISPLAY_TFT_HPP_
+
+//Includes
+#include "setup.hpp"
+
+#include "QAS_SPI_Bus.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//---------------------------
+//QAS_DISPLAY_TFT_STRIPPIXELS
+//
+//Number of pixels in each of the two strip buffers. Each buffer uses twice this many bytes of RAM
+//Regions are rendered and transferred as strips of as many whole rows as fit in a buffer
+#define QAS_DISPLAY_TFT_STRIPPIXELS   2560
+
+
+//--------------------------
+//QAS_DISPLAY_TFT_DIRTYRECTS
+//
+//Maximum number of separate dirty rectangles tracked. When all are in use, a new rectangle is merged with the
+//existing rectangle whose bounding box grows the least
+#define QAS_DISPLAY_TFT_DIRTYRECTS    8
+
+
+//----------------------
+//QAS_DISPLAY_TFT_RGB565
+//
+//Converts 8bit red, green and blue levels to an RGB565 color value
+#define QAS_DISPLAY_TFT_RGB565(r, g, b)  ((uint16_t)((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+
+
+//--------------------------
+//QAS_Display_TFT_Controller
+enum QAS_Display_TFT_Controller : uint8_t {
+	QAS_Display_TFT_ST7735 = 0,
+	QAS_Display_TFT_ILI9341
+};
+
+
+//--------------------------
+//QAS_Display_TFT_InitStruct
+//
+//This structure is used to be able to create the QAS_Display_TFT system class
+typedef struct {
+
+	QAS_Display_TFT_Controller eController;  //Display controller
+
+	uint16_t                   uWidth;       //Panel width in pixels in portrait orientation (e.g. 128 for ST7735, 240 for ILI9341)
+	uint16_t                   uHeight;      //Panel height in pixels in portrait orientation (e.g. 160 for ST7735, 320 for ILI9341)
+	uint8_t                    uColOffset;   //Column offset of panel within controller memory (required by some ST7735 panels)
+	uint8_t                    uRowOffset;   //Row offset of panel within controller memory (required by some ST7735 panels)
+	uint8_t                    uRotation;    //Rotation in 90 degree steps (0 to 3). Rotations 1 and 3 are landscape
+	bool                       bBGR;         //Set to true for panels with BGR subpixel order
+
+	GPIO_TypeDef*              pDC_GPIO;     //GPIO port of data/command pin
+	uint16_t                   uDC_Pin;      //GPIO pin of data/command pin
+	GPIO_TypeDef*              pReset_GPIO;  //GPIO port of reset pin, or NULL if reset pin is not connected
+	uint16_t                   uReset_Pin;   //GPIO pin of reset pin
+
+} QAS_Display_TFT_InitStruct;
+
+
+//------------------------------
+//QAS_Display_TFT_RenderFunction
+//
+//Function used to render a region of the display into a strip buffer. Pixels are RGB565 values (see QAS_DISPLAY_TFT_RGB565),
+//in rows of uWidth pixels. The system converts them to the display's byte order after rendering
+typedef void (*QAS_Display_TFT_RenderFunction)(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight, uint16_t* pPixels, void* pData);
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//---------------
+//QAS_Display_TFT
+//
+//System class for ST7735 and ILI9341 SPI TFT displays, attached to a QAS_SPI_Bus
+//As a full frame buffer does not fit in RAM, the display is drawn by a render function which fills strips of the region being
+//updated. Two strip buffers are used, so the next strip is rendered while the previous one is transferred by DMA.
+//Regions that have changed are marked with invalidate(), and update() then renders and transfers only those regions.
+//The display's data/command pin is set by each bus transaction's start callback, so the display can share its bus with other devices
+class QAS_Display_TFT {
+private:
+
+	//Rectangle
+	typedef struct {
+		uint16_t uX;
+		uint16_t uY;
+		uint16_t uWidth;
+		uint16_t uHeight;
+	} Rect;
+
+	QAS_SPI_Bus*                   m_pBus;          //SPI bus used by display
+	uint8_t                        m_uDevice;       //Device index on bus
+
+	QAS_Display_TFT_Controller     m_eController;
+	uint16_t                       m_uPanelWidth;
+	uint16_t                       m_uPanelHeight;
+	uint8_t                        m_uColOffset;
+	uint8_t                        m_uRowOffset;
+	uint8_t                        m_uRotation;
+	bool                           m_bBGR;
+	GPIO_TypeDef*                  m_pDC_GPIO;
+	uint16_t                       m_uDC_Pin;
+	GPIO_TypeDef*                  m_pReset_GPIO;
+	uint16_t                       m_uReset_Pin;
+
+	QA_InitState                   m_eInitState;
+	uint16_t                       m_uWidth;        //Width in current rotation
+	uint16_t                       m_uHeight;       //Height in current rotation
+
+	QAS_SPI_Bus_Transaction        m_sCmdTrans[5];  //Transactions used to send commands and command parameters
+	QAD_SPI_Segment                m_sCmdSegs[5];   //Segments used by command transactions
+	uint8_t                        m_uCmdData[5][4];//Command and parameter data
+
+	QAS_SPI_Bus_Transaction        m_sStripTrans[2];                           //Transactions used to send strip buffers
+	QAD_SPI_Segment                m_sStripSegs[2];                            //Segments used by strip transactions
+	alignas(4) uint16_t            m_uStrip[2][QAS_DISPLAY_TFT_STRIPPIXELS];   //Strip buffers. Word aligned for byte order conversion
+	uint8_t                        m_uStripIdx;                                //Next strip buffer to be used
+
+	Rect                           m_sDirty[QAS_DISPLAY_TFT_DIRTYRECTS];       //Dirty rectangles
+	uint8_t                        m_uDirtyCount;                              //Number of dirty rectangles
+
+	QAS_Display_TFT_RenderFunction m_pRender;       //Render function, or NULL
+	void*                          m_pRenderData;   //Data to be passed to m_pRender
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAS_Display_TFT() = delete;      //Delete the default class constructor, as an initialization structure is required
+
+	//pBus    - SPI bus the display is attached to
+	//uDevice - Device index returned by QAS_SPI_Bus::addDevice(). The device should use clock mode 0, MSB first and 8bit data size
+	//sInit   - Initialization structure
+	QAS_Display_TFT(QAS_SPI_Bus* pBus, uint8_t uDevice, QAS_Display_TFT_InitStruct& sInit);
+
+
+	//NOTE: See QAS_Display_TFT.cpp for details of the following methods
+
+	//----------------------
+	//Initialization Methods
+
+	QA_Result init(void);
+
+	//Returns the display width in pixels in the current rotation
+	uint16_t getWidth(void) {
+		return m_uWidth;
+	}
+
+	//Returns the display height in pixels in the current rotation
+	uint16_t getHeight(void) {
+		return m_uHeight;
+	}
+
+
+	//------------------
+	//Addressing Methods
+
+	QA_Result setWindow(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight);
+	QA_Result writePixels(const uint16_t* pPixels, uint32_t uCount);
+	void waitIdle(void);
+
+
+	//---------------
+	//Drawing Methods
+
+	//Sets the function used to render regions of the display
+	void setRenderer(QAS_Display_TFT_RenderFunction pRender, void* pData) {
+		m_pRender     = pRender;
+		m_pRenderData = pData;
+	}
+
+	QA_Result fill(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight, uint16_t uColor);
+
+
+	//-------------------
+	//Dirty Rect Methods
+
+	void invalidate(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight);
+	void invalidateAll(void);
+
+	//Returns true if any regions are waiting to be updated
+	bool isDirty(void) {
+		return (m_uDirtyCount != 0);
+	}
+
+	QA_Result update(void);
+
+
+	//----------------
+	//Handler Methods
+
+	static void handlerCommand(void* pData);
+	static void handlerData(void* pData);
+
+private:
+
+	//-------------
+	//Tools Methods
+
+	QA_Result sendCommand(uint8_t uCmd, const uint8_t* pParams, uint8_t uCount);
+	QA_Result submitCommand(uint8_t uIdx, bool bData, uint8_t uSize);
+	QA_Result submitStrip(uint8_t uIdx, uint16_t uPixels);
+	uint8_t nextStrip(void);
+	void waitTrans(QAS_SPI_Bus_Transaction& sTrans);
+	QA_Result renderRect(Rect& sRect);
+	void clipRect(Rect& sRect);
+	static bool overlapRect(const Rect& sA, const Rect& sB);
+	static void mergeRect(Rect& sDst, const Rect& sSrc);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAS_DISPLAY_TFT_HPP_ */
@@ -0,0 +1,620 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Flash                                                         */
+/*   Role: W25Qxx SPI NOR Flash Driver                                     */
+/*   Filename: QAS_Flash_W25Q.cpp                                          */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAS_Flash_W25Q.hpp"
+
+#include <string.h>
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//W25Qxx Commands
+#define W25Q_CMD_WRITEENABLE   0x06
+#define W25Q_CMD_READSTATUS1   0x05
+#define W25Q_CMD_FASTREAD      0x0B
+#define W25Q_CMD_PAGEPROGRAM   0x02
+#define W25Q_CMD_SECTORERASE   0x20
+#define W25Q_CMD_BLOCKERASE    0xD8
+#define W25Q_CMD_JEDECID       0x9F
+#define W25Q_CMD_RELEASEPD     0xAB
+
+//W25Qxx Status Register 1 Busy and Write Enable Latch Flags
+#define W25Q_STATUS_BUSY       0x01
+#define W25Q_STATUS_WEL        0x02
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //-------------------------------------
+  //-------------------------------------
+  //QAS_Flash_W25Q Initialization Methods
+
+//QAS_Flash_W25Q::init
+//QAS_Flash_W25Q Initialization Method
+//
+//Wakes the device from power down, reads its JEDEC ID to determine its size, and waits up to QAS_FLASH_W25Q_INITTIMEOUT milliseconds
+//for any operation in progress to complete
+//Returns QA_OK if successful, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if no supported device
+//responded or the device remained busy
+QA_Result QAS_Flash_W25Q::init(void) {
+	if (m_eOp != OpNone)
+		return QA_Error_PeriphBusy;
+
+	m_eInitState = QA_NotInitialized;
+	m_uSize      = 0;
+
+	//Timestamps are used to space status polls
+	QAT_Timestamp::init();
+
+	//Release from power down. The device requires 3us before accepting further commands
+	uint8_t uTX[4] = {W25Q_CMD_RELEASEPD, 0xFF, 0xFF, 0xFF};
+	if (transact(uTX, NULL, 1) != QA_OK)
+		return QA_Fail;
+	HAL_Delay(1);
+
+	//Read JEDEC ID
+	uint8_t uRX[4];
+	uTX[0] = W25Q_CMD_JEDECID;
+	if (transact(uTX, uRX, 4) != QA_OK)
+		return QA_Fail;
+	m_uJEDEC[0] = uRX[1];
+	m_uJEDEC[1] = uRX[2];
+	m_uJEDEC[2] = uRX[3];
+
+	//Check for a valid manufacturer ID, and a capacity of between 64KB and 16MB (the limit of 3 byte addressing)
+	if ((m_uJEDEC[0] == 0x00) || (m_uJEDEC[0] == 0xFF) || (m_uJEDEC[2] < 0x10) || (m_uJEDEC[2] > 0x18))
+		return QA_Fail;
+
+	//Wait for any operation in progress
+	uint32_t uTimeout = (uint32_t)(((uint64_t)QAS_FLASH_W25Q_INITTIMEOUT * QAT_Timestamp::getFrequency()) / 1000);
+	uint32_t uStart   = QAT_Timestamp::get();
+	uTX[0] = W25Q_CMD_READSTATUS1;
+	while (true) {
+		if (transact(uTX, uRX, 2) != QA_OK)
+			return QA_Fail;
+		if (!(uRX[1] & W25Q_STATUS_BUSY))
+			break;
+		if ((QAT_Timestamp::get() - uStart) >= uTimeout)
+			return QA_Fail;
+	}
+
+	invalidateCache();
+	m_uSize      = (1UL << m_uJEDEC[2]);
+	m_eInitState = QA_Initialized;
+	return QA_OK;
+}
+
+
+  //---------------------------
+  //---------------------------
+  //QAS_Flash_W25Q Read Methods
+
+//QAS_Flash_W25Q::read
+//QAS_Flash_W25Q Read Method
+//
+//Reads data using the fast read command, waiting for the read to complete. The data is transferred by DMA
+//uAddr - Flash address to read from
+//pData - Buffer for read data
+//uSize - Number of bytes to read
+//Returns QA_OK if successful, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if the read failed or is out of range
+QA_Result QAS_Flash_W25Q::read(uint32_t uAddr, uint8_t* pData, uint32_t uSize) {
+	QA_Result eRes = readAsync(uAddr, pData, uSize);
+	if (eRes)
+		return eRes;
+	return wait();
+}
+
+
+//QAS_Flash_W25Q::readAsync
+//QAS_Flash_W25Q Read Method
+//
+//Starts reading data using the fast read command. Reads larger than QAS_FLASH_W25Q_READCHUNK are split into multiple bus transactions
+//uAddr         - Flash address to read from
+//pData         - Buffer for read data. Must remain valid until the read completes
+//uSize         - Number of bytes to read
+//pCallback     - Function to be called from the DMA interrupt when the read completes or fails, or NULL
+//pCallbackData - Data to be passed to pCallback
+//Returns QA_OK if the read was started, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if out of range
+QA_Result QAS_Flash_W25Q::readAsync(uint32_t uAddr, uint8_t* pData, uint32_t uSize, QAD_IRQHandler_CallbackFunction pCallback, void* pCallbackData) {
+	QA_Result eRes = startOp(OpRead, uAddr, uSize, pCallback, pCallbackData);
+	if (eRes)
+		return eRes;
+
+	m_pReadData = pData;
+	m_uAddr     = uAddr;
+	m_uRemain   = uSize;
+	m_eStep     = StepCommand;
+	submitReadChunk();
+	return QA_OK;
+}
+
+
+//QAS_Flash_W25Q::readCached
+//QAS_Flash_W25Q Read Method
+//
+//Reads data through the sector read cache. Sectors not in the cache are read in full into the least recently used cache line
+//This suits repeated small reads from the same few sectors, such as file system metadata. Large sequential reads should use read()
+//uAddr - Flash address to read from
+//pData - Buffer for read data
+//uSize - Number of bytes to read
+//Returns QA_OK if successful, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if the read failed or is out of range
+QA_Result QAS_Flash_W25Q::readCached(uint32_t uAddr, uint8_t* pData, uint32_t uSize) {
+	if ((!m_eInitState) || (uAddr >= m_uSize) || (uSize > (m_uSize - uAddr)))
+		return QA_Fail;
+
+	while (uSize) {
+		uint32_t uSector = uAddr / QAS_FLASH_W25Q_SECTORSIZE;
+		uint32_t uOffset = uAddr % QAS_FLASH_W25Q_SECTORSIZE;
+		uint32_t uCopy   = QAS_FLASH_W25Q_SECTORSIZE - uOffset;
+		if (uCopy > uSize)
+			uCopy = uSize;
+
+		//Find sector in cache
+		CacheLine* pLine = NULL;
+		for (uint8_t i=0; i<QAS_FLASH_W25Q_CACHELINES; i++) {
+			if ((m_sCache[i].bValid) && (m_sCache[i].uSector == uSector)) {
+				pLine = &m_sCache[i];
+				break;
+			}
+		}
+
+		//Load sector into an unused or the least recently used line if not found
+		if (!pLine) {
+			pLine = &m_sCache[0];
+			for (uint8_t i=0; i<QAS_FLASH_W25Q_CACHELINES; i++) {
+				if (!m_sCache[i].bValid) {
+					pLine = &m_sCache[i];
+					break;
+				}
+				if (m_sCache[i].uLastUse < pLine->uLastUse)
+					pLine = &m_sCache[i];
+			}
+
+			pLine->bValid = false;
+			QA_Result eRes = read(uSector * QAS_FLASH_W25Q_SECTORSIZE, pLine->uData, QAS_FLASH_W25Q_SECTORSIZE);
+			if (eRes)
+				return eRes;
+			pLine->uSector = uSector;
+			pLine->bValid  = true;
+		}
+
+		pLine->uLastUse = ++m_uCacheTick;
+		memcpy(pData, &pLine->uData[uOffset], uCopy);
+
+		pData += uCopy;
+		uAddr += uCopy;
+		uSize -= uCopy;
+	}
+
+	return QA_OK;
+}
+
+
+//QAS_Flash_W25Q::invalidateCache
+//QAS_Flash_W25Q Read Method
+//
+//Invalidates all lines of the read cache. Writes and erases made through this class invalidate affected lines automatically
+void QAS_Flash_W25Q::invalidateCache(void) {
+	for (uint8_t i=0; i<QAS_FLASH_W25Q_CACHELINES; i++)
+		m_sCache[i].bValid = false;
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAS_Flash_W25Q Write Methods
+
+//QAS_Flash_W25Q::write
+//QAS_Flash_W25Q Write Method
+//
+//Programs data, waiting for programming to complete. The area being written must have been erased
+//uAddr - Flash address to write to
+//pData - Data to be written
+//uSize - Number of bytes to write
+//Returns QA_OK if successful, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if the write failed or is out of range
+QA_Result QAS_Flash_W25Q::write(uint32_t uAddr, const uint8_t* pData, uint32_t uSize) {
+	QA_Result eRes = writeAsync(uAddr, pData, uSize);
+	if (eRes)
+		return eRes;
+	return wait();
+}
+
+
+//QAS_Flash_W25Q::writeAsync
+//QAS_Flash_W25Q Write Method
+//
+//Starts programming data. The data is split at page boundaries, and each page is copied into a staging buffer one page ahead of
+//programming, so only the page after the one currently programming is read from pData at any time
+//uAddr         - Flash address to write to. The area being written must have been erased
+//pData         - Data to be written. Must remain valid until the write completes
+//uSize         - Number of bytes to write
+//pCallback     - Function to be called from the DMA interrupt when the write completes or fails, or NULL
+//pCallbackData - Data to be passed to pCallback
+//Returns QA_OK if the write was started, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if out of range
+QA_Result QAS_Flash_W25Q::writeAsync(uint32_t uAddr, const uint8_t* pData, uint32_t uSize, QAD_IRQHandler_CallbackFunction pCallback, void* pCallbackData) {
+	QA_Result eRes = startOp(OpWrite, uAddr, uSize, pCallback, pCallbackData);
+	if (eRes)
+		return eRes;
+
+	invalidateRange(uAddr, uSize);
+
+	m_uPollInterval = (uint32_t)(((uint64_t)QAS_FLASH_W25Q_POLLPROGRAM * QAT_Timestamp::getFrequency()) / 1000000);
+	m_pWriteData = pData;
+	m_uAddr      = uAddr;
+	m_uRemain    = uSize;
+	m_uStageIdx  = 0;
+	stagePage(0);
+
+	m_eStep = StepReady;
+	submitPoll();
+	return QA_OK;
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAS_Flash_W25Q Erase Methods
+
+//QAS_Flash_W25Q::eraseSector
+//QAS_Flash_W25Q Erase Method
+//
+//Erases the 4KB sector containing uAddr, waiting for the erase to complete
+//Returns QA_OK if successful, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if the erase failed or is out of range
+QA_Result QAS_Flash_W25Q::eraseSector(uint32_t uAddr) {
+	QA_Result eRes = eraseAsync(uAddr, false);
+	if (eRes)
+		return eRes;
+	return wait();
+}
+
+
+//QAS_Flash_W25Q::eraseBlock
+//QAS_Flash_W25Q Erase Method
+//
+//Erases the 64KB block containing uAddr, waiting for the erase to complete
+//Returns QA_OK if successful, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if the erase failed or is out of range
+QA_Result QAS_Flash_W25Q::eraseBlock(uint32_t uAddr) {
+	QA_Result eRes = eraseAsync(uAddr, true);
+	if (eRes)
+		return eRes;
+	return wait();
+}
+
+
+//QAS_Flash_W25Q::eraseAsync
+//QAS_Flash_W25Q Erase Method
+//
+//Starts erasing a sector or block. Completion is detected by polling the status register with bus transactions issued by handler()
+//every QAS_FLASH_W25Q_POLLERASE microseconds, so other devices on the bus can continue to be used during the erase
+//uAddr         - Flash address within the sector or block to be erased
+//bBlock        - Set to true to erase the 64KB block containing uAddr, or false to erase the 4KB sector containing uAddr
+//pCallback     - Function to be called from the DMA interrupt when the erase completes or fails, or NULL
+//pCallbackData - Data to be passed to pCallback
+//Returns QA_OK if the erase was started, QA_Error_PeriphBusy if an asynchronous operation is in progress, or QA_Fail if out of range
+QA_Result QAS_Flash_W25Q::eraseAsync(uint32_t uAddr, bool bBlock, QAD_IRQHandler_CallbackFunction pCallback, void* pCallbackData) {
+	uint32_t uSize = bBlock ? QAS_FLASH_W25Q_BLOCKSIZE : QAS_FLASH_W25Q_SECTORSIZE;
+	uAddr &= ~(uSize - 1);
+
+	QA_Result eRes = startOp(OpErase, uAddr, uSize, pCallback, pCallbackData);
+	if (eRes)
+		return eRes;
+
+	invalidateRange(uAddr, uSize);
+
+	m_uPollInterval = (uint32_t)(((uint64_t)QAS_FLASH_W25Q_POLLERASE * QAT_Timestamp::getFrequency()) / 1000000);
+	m_uEraseCmd     = bBlock ? W25Q_CMD_BLOCKERASE : W25Q_CMD_SECTORERASE;
+	m_uEraseAddr    = uAddr;
+	m_eStep         = StepReady;
+	submitPoll();
+	return QA_OK;
+}
+
+
+  //-----------------------------
+  //-----------------------------
+  //QAS_Flash_W25Q Status Methods
+
+//QAS_Flash_W25Q::wait
+//QAS_Flash_W25Q Status Method
+//
+//Waits for the current asynchronous operation to complete, calling handler() to issue status polls so that no timer is required
+//Returns the result of the operation
+QA_Result QAS_Flash_W25Q::wait(void) {
+	while (m_eOp != OpNone)
+		handler(NULL);
+	return m_eResult;
+}
+
+
+  //------------------------------
+  //------------------------------
+  //QAS_Flash_W25Q Handler Methods
+
+//QAS_Flash_W25Q::handler
+//QAS_Flash_W25Q Handler Method
+//
+//To be called periodically from a QAD_Timer update interrupt (see class description). Submits the next status poll of a program or
+//erase once the poll interval has passed since the previous poll completed
+//pData - Not used
+void QAS_Flash_W25Q::handler(void* pData) {
+	if (!m_bPollWait)
+		return;
+
+	if ((QAT_Timestamp::get() - m_uPollTime) < m_uPollInterval)
+		return;
+
+	//Claim the poll, as handler() may be called from both a timer interrupt and wait()
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	bool bPoll  = m_bPollWait;
+	m_bPollWait = false;
+	__set_PRIMASK(uPRIMASK);
+
+	if (bPoll)
+		submitPoll();
+}
+
+
+//QAS_Flash_W25Q::handlerTransaction
+//QAS_Flash_W25Q Handler Method
+//
+//Transaction callback, called from the DMA interrupt at the end of each bus transaction of an asynchronous operation
+//Starts the next step of the operation
+//pData - Pointer to QAS_Flash_W25Q class
+void QAS_Flash_W25Q::handlerTransaction(void* pData) {
+	QAS_Flash_W25Q* pFlash = (QAS_Flash_W25Q*)pData;
+	if (pFlash->m_eOp == OpNone)
+		return;
+
+	if (pFlash->m_sTrans.eState != QAS_SPI_Bus_Trans_Complete) {
+		pFlash->finishOp(QA_Fail);
+		return;
+	}
+
+	switch (pFlash->m_eStep) {
+
+		//Status read before a program or erase. Write enable and program or erase commands are ignored while the device is busy, so
+		//schedule another poll if an earlier operation is still running, otherwise send write enable command
+		case (StepReady):
+			if (pFlash->m_uStatus & W25Q_STATUS_BUSY) {
+				pFlash->schedulePoll();
+			} else {
+				pFlash->m_eStep = StepWriteEnable;
+				pFlash->submitWriteEnable();
+			}
+			break;
+
+		//Write enable command sent, so read back status to check the write enable latch
+		case (StepWriteEnable):
+			pFlash->m_eStep = StepWriteCheck;
+			pFlash->submitPoll();
+			break;
+
+		//Status read. Fail if write enable latch is not set, otherwise send program or erase command
+		case (StepWriteCheck):
+			if (!(pFlash->m_uStatus & W25Q_STATUS_WEL)) {
+				pFlash->finishOp(QA_Fail);
+				break;
+			}
+			pFlash->m_eStep = StepCommand;
+			if (pFlash->m_eOp == OpWrite) {
+				uint8_t uIdx = pFlash->m_uStageIdx;
+				pFlash->submitCommand(W25Q_CMD_PAGEPROGRAM, pFlash->m_uStageAddr[uIdx], 4, pFlash->m_uStage[uIdx], NULL, pFlash->m_uStageSize[uIdx]);
+			} else {
+				pFlash->submitCommand(pFlash->m_uEraseCmd, pFlash->m_uEraseAddr, 4, NULL, NULL, 0);
+			}
+			break;
+
+		//Command sent. For reads, continue with next chunk. For programs and erases, schedule polls until complete, staging the
+		//next page to be programmed while the current page programs
+		case (StepCommand):
+			if (pFlash->m_eOp == OpRead) {
+				if (pFlash->m_uRemain)
+					pFlash->submitReadChunk(); else
+					pFlash->finishOp(QA_OK);
+				break;
+			}
+			if (pFlash->m_eOp == OpWrite)
+				pFlash->stagePage(pFlash->m_uStageIdx ^ 1);
+			pFlash->m_eStep = StepPoll;
+			pFlash->schedulePoll();
+			break;
+
+		//Status read. Schedule another poll if still busy, otherwise program the next staged page or finish
+		case (StepPoll):
+			if (pFlash->m_uStatus & W25Q_STATUS_BUSY) {
+				pFlash->schedulePoll();
+			} else if ((pFlash->m_eOp == OpWrite) && (pFlash->m_uStageSize[pFlash->m_uStageIdx ^ 1])) {
+				pFlash->m_uStageIdx ^= 1;
+				pFlash->m_eStep      = StepWriteEnable;
+				pFlash->submitWriteEnable();
+			} else {
+				pFlash->finishOp(QA_OK);
+			}
+			break;
+	}
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAS_Flash_W25Q Tools Methods
+
+//QAS_Flash_W25Q::transact
+//QAS_Flash_W25Q Tools Method
+//
+//Performs a single full duplex bus transaction, waiting for it to complete. Only used when no asynchronous operation is in progress
+QA_Result QAS_Flash_W25Q::transact(const uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize) {
+	m_sSegs[0].pTXData = (uint8_t*)pTXData;
+	m_sSegs[0].pRXData = pRXData;
+	m_sSegs[0].uSize   = uSize;
+	m_sTrans.uCount    = 1;
+
+	if (m_pBus->submit(m_sTrans) != QA_OK)
+		return QA_Fail;
+
+	while ((m_sTrans.eState == QAS_SPI_Bus_Trans_Queued) || (m_sTrans.eState == QAS_SPI_Bus_Trans_Active)) {}
+	return (m_sTrans.eState == QAS_SPI_Bus_Trans_Complete) ? QA_OK : QA_Fail;
+}
+
+
+//QAS_Flash_W25Q::startOp
+//QAS_Flash_W25Q Tools Method
+//
+//Checks that an asynchronous operation can be started on the given address range, and sets it as the current operation
+QA_Result QAS_Flash_W25Q::startOp(Op eOp, uint32_t uAddr, uint32_t uSize, QAD_IRQHandler_CallbackFunction pCallback, void* pCallbackData) {
+	if ((!m_eInitState) || (!uSize) || (uAddr >= m_uSize) || (uSize > (m_uSize - uAddr)))
+		return QA_Fail;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	if (m_eOp != OpNone) {
+		__set_PRIMASK(uPRIMASK);
+		return QA_Error_PeriphBusy;
+	}
+	m_eOp = eOp;
+	__set_PRIMASK(uPRIMASK);
+
+	m_eResult       = QA_OK;
+	m_pCallback     = pCallback;
+	m_pCallbackData = pCallbackData;
+	return QA_OK;
+}
+
+
+//QAS_Flash_W25Q::finishOp
+//QAS_Flash_W25Q Tools Method
+//
+//Ends the current asynchronous operation and calls its callback if set
+void QAS_Flash_W25Q::finishOp(QA_Result eResult) {
+	m_eResult = eResult;
+	m_eOp     = OpNone;
+
+	if (m_pCallback)
+		m_pCallback(m_pCallbackData);
+}
+
+
+//QAS_Flash_W25Q::submitCommand
+//QAS_Flash_W25Q Tools Method
+//
+//Submits a command transaction, consisting of a command segment of uCmdSize bytes (the command, 3 address bytes and a dummy byte
+//as required), optionally followed by a data segment. The operation fails if the transaction cannot be submitted
+void QAS_Flash_W25Q::submitCommand(uint8_t uCmd, uint32_t uAddr, uint8_t uCmdSize, const uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize) {
+	m_uCmd[0] = uCmd;
+	m_uCmd[1] = (uint8_t)(uAddr >> 16);
+	m_uCmd[2] = (uint8_t)(uAddr >> 8);
+	m_uCmd[3] = (uint8_t)uAddr;
+	m_uCmd[4] = 0xFF;
+
+	m_sSegs[0].pTXData = m_uCmd;
+	m_sSegs[0].pRXData = NULL;
+	m_sSegs[0].uSize   = uCmdSize;
+	m_sSegs[1].pTXData = (uint8_t*)pTXData;
+	m_sSegs[1].pRXData = pRXData;
+	m_sSegs[1].uSize   = uSize;
+	m_sTrans.uCount    = uSize ? 2 : 1;
+
+	if (m_pBus->submit(m_sTrans) != QA_OK)
+		finishOp(QA_Fail);
+}
+
+
+//QAS_Flash_W25Q::submitWriteEnable
+//QAS_Flash_W25Q Tools Method
+//
+//Submits a write enable command, which must precede each program or erase command
+void QAS_Flash_W25Q::submitWriteEnable(void) {
+	submitCommand(W25Q_CMD_WRITEENABLE, 0, 1, NULL, NULL, 0);
+}
+
+
+//QAS_Flash_W25Q::schedulePoll
+//QAS_Flash_W25Q Tools Method
+//
+//Sets a status poll to be submitted by handler() once the poll interval has passed
+void QAS_Flash_W25Q::schedulePoll(void) {
+	m_uPollTime = QAT_Timestamp::get();
+	m_bPollWait = true;
+}
+
+
+//QAS_Flash_W25Q::submitPoll
+//QAS_Flash_W25Q Tools Method
+//
+//Submits a read of status register 1 into m_uStatus
+void QAS_Flash_W25Q::submitPoll(void) {
+	submitCommand(W25Q_CMD_READSTATUS1, 0, 1, NULL, &m_uStatus, 1);
+}
+
+
+//QAS_Flash_W25Q::submitReadChunk
+//QAS_Flash_W25Q Tools Method
+//
+//Submits a fast read of the next chunk of the current read operation, and advances to the following chunk
+void QAS_Flash_W25Q::submitReadChunk(void) {
+	uint32_t uChunk = (m_uRemain > QAS_FLASH_W25Q_READCHUNK) ? QAS_FLASH_W25Q_READCHUNK : m_uRemain;
+	uint8_t* pData  = m_pReadData;
+	uint32_t uAddr  = m_uAddr;
+
+	m_pReadData += uChunk;
+	m_uAddr     += uChunk;
+	m_uRemain   -= uChunk;
+
+	submitCommand(W25Q_CMD_FASTREAD, uAddr, 5, NULL, pData, (uint16_t)uChunk);
+}
+
+
+//QAS_Flash_W25Q::stagePage
+//QAS_Flash_W25Q Tools Method
+//
+//Copies the next page (or part page, up to the next page boundary) of the current write operation into a staging buffer
+//The staging buffer's size is set to 0 if no data remains to be written
+void QAS_Flash_W25Q::stagePage(uint8_t uIdx) {
+	uint32_t uSize = QAS_FLASH_W25Q_PAGESIZE - (m_uAddr % QAS_FLASH_W25Q_PAGESIZE);
+	if (uSize > m_uRemain)
+		uSize = m_uRemain;
+
+	memcpy(m_uStage[uIdx], m_pWriteData, uSize);
+	m_uStageAddr[uIdx] = m_uAddr;
+	m_uStageSize[uIdx] = (uint16_t)uSize;
+
+	m_pWriteData += uSize;
+	m_uAddr      += uSize;
+	m_uRemain    -= uSize;
+}
+
+
+//QAS_Flash_W25Q::invalidateRange
+//QAS_Flash_W25Q Tools Method
+//
+//Invalidates any read cache lines holding sectors within the given address range
+void QAS_Flash_W25Q::invalidateRange(uint32_t uAddr, uint32_t uSize) {
+	uint32_t uFirst = uAddr / QAS_FLASH_W25Q_SECTORSIZE;
+	uint32_t uLast  = (uAddr + uSize - 1) / QAS_FLASH_W25Q_SECTORSIZE;
+
+	for (uint8_t i=0; i<QAS_FLASH_W25Q_CACHELINES; i++) {
+		if ((m_sCache[i].uSector >= uFirst) && (m_sCache[i].uSector <= uLast))
+			m_sCache[i].bValid = false;
+	}
+}
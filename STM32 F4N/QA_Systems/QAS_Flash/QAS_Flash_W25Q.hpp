@@ -0,0 +1,294 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Flash                                                         */
+/*   Role: W25Qxx SPI NOR Flash Driver                                     */
+/*   Filename: QAS_Flash_W25Q.hpp                                          */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAS_FLASH_W25Q_HPP_
+#define __QAS_FLASH_W25Q_HPP_
+
+//Includes
+#include "setup.hpp"
+
+#include "QAS_SPI_Bus.hpp"
+#include "QAT_Timestamp.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//--------------------------
+//QAS_FLASH_W25Q_PAGESIZE / QAS_FLASH_W25Q_SECTORSIZE / QAS_FLASH_W25Q_BLOCKSIZE
+//
+//Sizes in bytes of program pages, erase sectors and erase blocks
+#define QAS_FLASH_W25Q_PAGESIZE      256
+#define QAS_FLASH_W25Q_SECTORSIZE    4096
+#define QAS_FLASH_W25Q_BLOCKSIZE     65536
+
+
+//--------------------------
+//QAS_FLASH_W25Q_CACHELINES
+//
+//Number of sectors held in the read cache used by readCached(). Each cache line uses QAS_FLASH_W25Q_SECTORSIZE bytes of RAM
+#define QAS_FLASH_W25Q_CACHELINES    2
+
+
+//--------------------------
+//QAS_FLASH_W25Q_READCHUNK
+//
+//Maximum number of bytes read by a single fast read transaction. Larger reads are split into multiple transactions,
+//allowing other devices on the bus to be serviced in between
+#define QAS_FLASH_W25Q_READCHUNK     32768
+
+
+//--------------------------
+//QAS_FLASH_W25Q_POLLPROGRAM / QAS_FLASH_W25Q_POLLERASE
+//
+//Minimum interval in microseconds between status register polls while a page program or an erase is in progress
+//Page programs typically take 0.4 to 3ms and erases 45ms to 2s, so these keep the number of polls per operation low
+#define QAS_FLASH_W25Q_POLLPROGRAM   100
+#define QAS_FLASH_W25Q_POLLERASE     1000
+
+
+//--------------------------
+//QAS_FLASH_W25Q_INITTIMEOUT
+//
+//Time in milliseconds that init() waits for an operation already in progress to complete, which covers the longest block erase
+#define QAS_FLASH_W25Q_INITTIMEOUT   2000
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//--------------
+//QAS_Flash_W25Q
+//
+//Driver for Winbond W25Qxx (and compatible) SPI NOR flash devices of up to 16MB, using 3 byte addressing
+//All transfers are made as QAS_SPI_Bus transactions, so the flash can share an SPI peripheral with other devices.
+//Reads, page programs and erases run asynchronously, with each step started from the completion callback of the step before.
+//The busy status of the device is polled with status register reads spaced QAS_FLASH_W25Q_POLLPROGRAM or QAS_FLASH_W25Q_POLLERASE
+//microseconds apart. Polls are issued from handler(), which is to be called periodically from a QAD_Timer update interrupt by passing
+//this class to QAD_Timer::setHandlerClass(), at a rate of around 10kHz. Programs and erases started with the asynchronous methods
+//do not complete unless handler() is being called. The blocking methods call handler() themselves while waiting.
+//A program or erase first polls until the device is no longer busy, as an earlier operation that failed part way may still be running,
+//and the write enable latch is read back after each write enable command, failing the operation if it has not been set.
+//Page programming is pipelined: the next page is copied into a second staging buffer while the current page programs, so it
+//can be sent as soon as the device becomes ready. Blocking versions of each operation are provided, which wait for completion
+class QAS_Flash_W25Q : public QAD_IRQHandler_CallbackClass {
+private:
+
+	//Asynchronous operation
+	enum Op : uint8_t {
+		OpNone = 0,
+		OpRead,
+		OpWrite,
+		OpErase
+	};
+
+	//Step within asynchronous operation
+	enum Step : uint8_t {
+		StepReady = 0,        //Status register being polled until any earlier operation has finished
+		StepWriteEnable,      //Write enable command being sent
+		StepWriteCheck,       //Status register being read to check the write enable latch has been set
+		StepCommand,          //Read, program or erase command being sent
+		StepPoll              //Status register being polled until device is no longer busy
+	};
+
+	//Read cache line
+	typedef struct {
+		bool     bValid;                              //Set to true if line holds valid data
+		uint32_t uSector;                             //Sector number held in line
+		uint32_t uLastUse;                            //Value of m_uCacheTick when line was last used
+		uint8_t  uData[QAS_FLASH_W25Q_SECTORSIZE];    //Sector data
+	} CacheLine;
+
+	QAS_SPI_Bus*                    m_pBus;           //SPI bus used by device
+	uint8_t                         m_uDevice;        //Device index on bus
+	uint8_t                         m_uPriority;      //Priority of device's bus transactions
+
+	QA_InitState                    m_eInitState;     //Set once device has been successfully probed by init()
+	uint8_t                         m_uJEDEC[3];      //JEDEC ID (manufacturer, memory type, capacity)
+	uint32_t                        m_uSize;          //Device size in bytes
+
+	QAS_SPI_Bus_Transaction         m_sTrans;         //Transaction used by asynchronous operations
+	QAD_SPI_Segment                 m_sSegs[2];       //Segments used by asynchronous operations
+	uint8_t                         m_uCmd[5];        //Command buffer used by asynchronous operations
+	uint8_t                         m_uStatus;        //Status register read buffer
+
+	volatile Op                     m_eOp;            //Current asynchronous operation
+	Step                            m_eStep;          //Current step of asynchronous operation
+	volatile QA_Result              m_eResult;        //Result of last asynchronous operation
+	uint32_t                        m_uAddr;          //Flash address of next read chunk, or of next page to be staged
+	uint8_t*                        m_pReadData;      //Destination of next read chunk
+	const uint8_t*                  m_pWriteData;     //Source of next page to be staged
+	uint32_t                        m_uRemain;        //Bytes remaining to be read, or to be staged for programming
+	uint8_t                         m_uEraseCmd;      //Erase command of current erase operation
+	uint32_t                        m_uEraseAddr;     //Address of current erase operation
+
+	volatile bool                   m_bPollWait;      //Set to true while waiting for handler() to issue the next status poll
+	uint32_t                        m_uPollTime;      //Timestamp at which the previous status poll or command completed
+	uint32_t                        m_uPollInterval;  //Interval between status polls for the current operation, in timestamp ticks
+
+	uint8_t                         m_uStage[2][QAS_FLASH_W25Q_PAGESIZE]; //Page staging buffers
+	uint16_t                        m_uStageSize[2];  //Number of bytes in each staging buffer (0 if empty)
+	uint32_t                        m_uStageAddr[2];  //Flash address of each staging buffer
+	uint8_t                         m_uStageIdx;      //Staging buffer currently being programmed
+
+	QAD_IRQHandler_CallbackFunction m_pCallback;      //Function to be called when an asynchronous operation completes, or NULL
+	void*                           m_pCallbackData;  //Data to be passed to m_pCallback
+
+	CacheLine                       m_sCache[QAS_FLASH_W25Q_CACHELINES]; //Read cache
+	uint32_t                        m_uCacheTick;     //Incremented on each cache access, to find least recently used line
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAS_Flash_W25Q() = delete;       //Delete the default class constructor, as the bus and device are required
+
+	//pBus      - SPI bus the device is attached to
+	//uDevice   - Device index returned by QAS_SPI_Bus::addDevice(). The device should use clock mode 0 or 3, MSB first and 8bit data size
+	//uPriority - Priority of the device's bus transactions
+	QAS_Flash_W25Q(QAS_SPI_Bus* pBus, uint8_t uDevice, uint8_t uPriority = 0) :
+		m_pBus(pBus),
+		m_uDevice(uDevice),
+		m_uPriority(uPriority),
+		m_eInitState(QA_NotInitialized),
+		m_uJEDEC{0, 0, 0},
+		m_uSize(0),
+		m_uStatus(0),
+		m_eOp(OpNone),
+		m_eStep(StepReady),
+		m_eResult(QA_OK),
+		m_uAddr(0),
+		m_pReadData(NULL),
+		m_pWriteData(NULL),
+		m_uRemain(0),
+		m_uEraseCmd(0),
+		m_uEraseAddr(0),
+		m_bPollWait(false),
+		m_uPollTime(0),
+		m_uPollInterval(0),
+		m_uStageSize{0, 0},
+		m_uStageAddr{0, 0},
+		m_uStageIdx(0),
+		m_pCallback(NULL),
+		m_pCallbackData(NULL),
+		m_uCacheTick(0) {
+
+		m_sTrans.uDevice        = uDevice;
+		m_sTrans.uPriority      = uPriority;
+		m_sTrans.pSegments      = m_sSegs;
+		m_sTrans.uCount         = 1;
+		m_sTrans.pStartCallback = NULL;
+		m_sTrans.pCallback      = handlerTransaction;
+		m_sTrans.pCallbackData  = this;
+		m_sTrans.eState         = QAS_SPI_Bus_Trans_Idle;
+		m_sTrans.pNext          = NULL;
+
+		for (uint8_t i=0; i<QAS_FLASH_W25Q_CACHELINES; i++)
+			m_sCache[i].bValid = false;
+	}
+
+
+	//NOTE: See QAS_Flash_W25Q.cpp for details of the following methods
+
+	//----------------------
+	//Initialization Methods
+
+	QA_Result init(void);
+
+	//Returns the device size in bytes, or 0 if the device has not been initialized
+	uint32_t getSize(void) {
+		return m_uSize;
+	}
+
+	//Returns the three JEDEC ID bytes (manufacturer, memory type, capacity) read by init()
+	const uint8_t* getJEDEC(void) {
+		return m_uJEDEC;
+	}
+
+
+	//------------
+	//Read Methods
+
+	QA_Result read(uint32_t uAddr, uint8_t* pData, uint32_t uSize);
+	QA_Result readAsync(uint32_t uAddr, uint8_t* pData, uint32_t uSize, QAD_IRQHandler_CallbackFunction pCallback = NULL, void* pCallbackData = NULL);
+	QA_Result readCached(uint32_t uAddr, uint8_t* pData, uint32_t uSize);
+	void invalidateCache(void);
+
+
+	//-------------
+	//Write Methods
+
+	QA_Result write(uint32_t uAddr, const uint8_t* pData, uint32_t uSize);
+	QA_Result writeAsync(uint32_t uAddr, const uint8_t* pData, uint32_t uSize, QAD_IRQHandler_CallbackFunction pCallback = NULL, void* pCallbackData = NULL);
+
+
+	//-------------
+	//Erase Methods
+
+	QA_Result eraseSector(uint32_t uAddr);
+	QA_Result eraseBlock(uint32_t uAddr);
+	QA_Result eraseAsync(uint32_t uAddr, bool bBlock, QAD_IRQHandler_CallbackFunction pCallback = NULL, void* pCallbackData = NULL);
+
+
+	//--------------
+	//Status Methods
+
+	//Returns true while an asynchronous operation is in progress
+	bool isBusy(void) {
+		return (m_eOp != OpNone);
+	}
+
+	//Returns the result of the last asynchronous operation
+	QA_Result getResult(void) {
+		return m_eResult;
+	}
+
+	QA_Result wait(void);
+
+
+	//---------------
+	//Handler Methods
+
+	void handler(void* pData);
+	static void handlerTransaction(void* pData);
+
+private:
+
+	//-------------
+	//Tools Methods
+
+	QA_Result transact(const uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize);
+	QA_Result startOp(Op eOp, uint32_t uAddr, uint32_t uSize, QAD_IRQHandler_CallbackFunction pCallback, void* pCallbackData);
+	void finishOp(QA_Result eResult);
+	void submitCommand(uint8_t uCmd, uint32_t uAddr, uint8_t uCmdSize, const uint8_t* pTXData, uint8_t* pRXData, uint16_t uSize);
+	void submitWriteEnable(void);
+	void schedulePoll(void);
+	void submitPoll(void);
+	void submitReadChunk(void);
+	void stagePage(uint8_t uIdx);
+	void invalidateRange(uint32_t uAddr, uint32_t uSize);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAS_FLASH_W25Q_HPP_ */
@@ -0,0 +1,467 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Systems - RGB                                                 */
+/*   Role: RGB Animation Engine                                            */
+/*   Filename: QAS_RGB_Anim.cpp                                            */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAS_RGB_Anim.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//Mask used to wrap keyframe queue indexes
+#define QAS_RGB_ANIM_KEYFRAMEMASK  (QAS_RGB_ANIM_KEYFRAMES - 1)
+
+//Hue range used for fixed point HSV (6 sectors of 256 steps)
+#define QAS_RGB_ANIM_HUERANGE      1536
+
+
+//QAS_RGB_Anim_Div255
+//
+//Fast division by 255 for values between 0 and 65535
+static inline uint32_t QAS_RGB_Anim_Div255(uint32_t uVal) {
+	return (uVal + 1 + (uVal >> 8)) >> 8;
+}
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //-----------------------------
+  //-----------------------------
+  //QAS_RGB_Anim Handler Methods
+
+//QAS_RGB_Anim::handler
+//QAS_RGB_Anim Handler Method
+//
+//To be called from a timer update interrupt, at the update rate provided to the class constructor
+//Advances each track by one tick, starting the next queued keyframe when the current one has completed
+//pData - Unused
+void QAS_RGB_Anim::handler(void* pData) {
+
+	if (!m_bRunning)
+		return;
+
+	for (uint8_t i=0; i<QAS_RGB_ANIM_TRACKS; i++) {
+		Track& sTrack = m_sTracks[i];
+
+		if (!sTrack.pRGB)
+			continue;
+
+		//Start next keyframe if one is queued
+		if (!sTrack.bPlaying) {
+			if (sTrack.uCurrent == sTrack.uTail)
+				continue;
+			beginKeyframe(sTrack);
+		}
+
+		QAS_RGB_Anim_Keyframe& sKeyframe = sTrack.sKeyframes[sTrack.uCurrent];
+		uint8_t uColor[3];
+
+		sTrack.uTick++;
+		if (sTrack.uTick >= sKeyframe.uTicks) {
+
+			//Keyframe completed, so set target color directly to avoid any rounding error
+			uColor[0] = (sKeyframe.uColor >> 16) & 0xFF;
+			uColor[1] = (sKeyframe.uColor >> 8) & 0xFF;
+			uColor[2] = sKeyframe.uColor & 0xFF;
+
+			//Move to next keyframe. When looping, keyframes are kept in the queue and play restarts from the head of the queue
+			uint8_t uNext = (sTrack.uCurrent + 1) & QAS_RGB_ANIM_KEYFRAMEMASK;
+			if (sTrack.bLoop) {
+				sTrack.uCurrent = (uNext == sTrack.uTail) ? sTrack.uHead : uNext;
+			} else {
+				sTrack.uCurrent = uNext;
+				sTrack.uHead    = uNext;
+			}
+			sTrack.bPlaying = false;
+
+		} else {
+
+			//Calculate eased position through keyframe in Q16 format, from the Q32 position accumulated each tick
+			sTrack.uPos  += sTrack.uStep;
+			uint32_t uPos = calcEasing(sKeyframe.eEasing, sTrack.uPos >> 16);
+
+			if (sKeyframe.eSpace == QAS_RGB_Anim_HSV) {
+				int32_t iHue = sTrack.uStartHue + ((sTrack.iDeltaHue * (int32_t)uPos) >> 16);
+				if (iHue < 0)
+					iHue += QAS_RGB_ANIM_HUERANGE;
+				else if (iHue >= QAS_RGB_ANIM_HUERANGE)
+					iHue -= QAS_RGB_ANIM_HUERANGE;
+				uint8_t uSat = sTrack.uStart[1] + ((sTrack.iDelta[1] * (int32_t)uPos) >> 16);
+				uint8_t uVal = sTrack.uStart[2] + ((sTrack.iDelta[2] * (int32_t)uPos) >> 16);
+				convHSVtoRGB(iHue, uSat, uVal, uColor);
+			} else {
+				for (uint8_t j=0; j<3; j++)
+					uColor[j] = sTrack.uStart[j] + ((sTrack.iDelta[j] * (int32_t)uPos) >> 16);
+			}
+		}
+
+		//Only update driver if color has changed
+		if ((uColor[0] != sTrack.uColor[0]) || (uColor[1] != sTrack.uColor[1]) || (uColor[2] != sTrack.uColor[2])) {
+			sTrack.uColor[0] = uColor[0];
+			sTrack.uColor[1] = uColor[1];
+			sTrack.uColor[2] = uColor[2];
+			sTrack.pRGB->setRGB(uColor[0], uColor[1], uColor[2]);
+		}
+	}
+}
+
+
+  //---------------------------
+  //---------------------------
+  //QAS_RGB_Anim Track Methods
+
+//QAS_RGB_Anim::addTrack
+//QAS_RGB_Anim Track Method
+//
+//Adds an RGB driver to be animated. The driver must already be initialized
+//pRGB - Pointer to the RGB driver to be animated
+//Returns the index of the new track, or -1 if no tracks are available
+int8_t QAS_RGB_Anim::addTrack(QAD_RGB* pRGB) {
+
+	if (!pRGB)
+		return -1;
+
+	for (uint8_t i=0; i<QAS_RGB_ANIM_TRACKS; i++) {
+		Track& sTrack = m_sTracks[i];
+		if (!sTrack.pRGB) {
+			sTrack.uHead     = 0;
+			sTrack.uTail     = 0;
+			sTrack.uCurrent  = 0;
+			sTrack.bLoop     = false;
+			sTrack.bPlaying  = false;
+			sTrack.uColor[0] = pRGB->getRed();
+			sTrack.uColor[1] = pRGB->getGreen();
+			sTrack.uColor[2] = pRGB->getBlue();
+
+			//Track becomes visible to handler() once driver pointer is set
+			__DMB();
+			sTrack.pRGB      = pRGB;
+			return i;
+		}
+	}
+	return -1;
+}
+
+
+//QAS_RGB_Anim::removeTrack
+//QAS_RGB_Anim Track Method
+//
+//Removes a track, leaving the RGB driver at its current color
+//uTrack - Index of the track to be removed
+void QAS_RGB_Anim::removeTrack(uint8_t uTrack) {
+
+	if (uTrack >= QAS_RGB_ANIM_TRACKS)
+		return;
+
+	m_sTracks[uTrack].pRGB = NULL;
+}
+
+
+//QAS_RGB_Anim::addKeyframe
+//QAS_RGB_Anim Track Method
+//
+//Adds a keyframe to the end of a track's keyframe queue
+//Safe to be called while the animation is running, as only handler() modifies the head of the queue
+//uTrack    - Index of the track
+//uColor    - Target color in 0xRRGGBB format
+//uDuration - Duration of transition from the previous color in milliseconds
+//eEasing   - Easing curve to be used. Member of QAS_RGB_Anim_Easing
+//eSpace    - Color space to interpolate in. Member of QAS_RGB_Anim_Space
+//Returns QA_OK if successful, or QA_Fail if the track is invalid or its keyframe queue is full
+QA_Result QAS_RGB_Anim::addKeyframe(uint8_t uTrack, uint32_t uColor, uint16_t uDuration, QAS_RGB_Anim_Easing eEasing, QAS_RGB_Anim_Space eSpace) {
+
+	if ((uTrack >= QAS_RGB_ANIM_TRACKS) || (!m_sTracks[uTrack].pRGB))
+		return QA_Fail;
+
+	Track& sTrack = m_sTracks[uTrack];
+	uint8_t uTail = sTrack.uTail;
+	uint8_t uNext = (uTail + 1) & QAS_RGB_ANIM_KEYFRAMEMASK;
+	if (uNext == sTrack.uHead)
+		return QA_Fail;
+
+	//Convert duration to timer ticks, rounding to nearest and with a minimum of one tick
+	uint32_t uTicks = (((uint32_t)uDuration * m_uUpdateRate) + 500) / 1000;
+	if (!uTicks)
+		uTicks = 1;
+
+	sTrack.sKeyframes[uTail].uColor  = uColor & 0x00FFFFFF;
+	sTrack.sKeyframes[uTail].uTicks  = uTicks;
+	sTrack.sKeyframes[uTail].eEasing = eEasing;
+	sTrack.sKeyframes[uTail].eSpace  = eSpace;
+
+	//Make sure keyframe data is written before it is made visible to handler()
+	__DMB();
+	sTrack.uTail = uNext;
+	return QA_OK;
+}
+
+
+//QAS_RGB_Anim::clear
+//QAS_RGB_Anim Track Method
+//
+//Stops the current keyframe and removes all queued keyframes from a track, leaving the RGB driver at its current color
+//uTrack - Index of the track
+void QAS_RGB_Anim::clear(uint8_t uTrack) {
+
+	if (uTrack >= QAS_RGB_ANIM_TRACKS)
+		return;
+
+	Track& sTrack = m_sTracks[uTrack];
+
+	//Queue indexes are modified by handler(), so interrupts are disabled while the queue is emptied
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	sTrack.bPlaying = false;
+	sTrack.uHead    = sTrack.uTail;
+	sTrack.uCurrent = sTrack.uTail;
+	__set_PRIMASK(uPRIMASK);
+}
+
+
+//QAS_RGB_Anim::setLoop
+//QAS_RGB_Anim Track Method
+//
+//Sets whether a track loops through its queued keyframes
+//uTrack - Index of the track
+//bLoop  - Set to true to loop, or false to remove keyframes from the queue once played
+void QAS_RGB_Anim::setLoop(uint8_t uTrack, bool bLoop) {
+
+	if (uTrack >= QAS_RGB_ANIM_TRACKS)
+		return;
+
+	m_sTracks[uTrack].bLoop = bLoop;
+}
+
+
+//QAS_RGB_Anim::getLoop
+//QAS_RGB_Anim Track Method
+//
+//Returns true if the track is set to loop
+bool QAS_RGB_Anim::getLoop(uint8_t uTrack) {
+
+	if (uTrack >= QAS_RGB_ANIM_TRACKS)
+		return false;
+
+	return m_sTracks[uTrack].bLoop;
+}
+
+
+//QAS_RGB_Anim::isPlaying
+//QAS_RGB_Anim Track Method
+//
+//Returns true if the track is currently playing a keyframe or has keyframes queued
+bool QAS_RGB_Anim::isPlaying(uint8_t uTrack) {
+
+	if (uTrack >= QAS_RGB_ANIM_TRACKS)
+		return false;
+
+	return (m_sTracks[uTrack].bPlaying || (m_sTracks[uTrack].uHead != m_sTracks[uTrack].uTail));
+}
+
+
+//QAS_RGB_Anim::getQueued
+//QAS_RGB_Anim Track Method
+//
+//Returns the number of keyframes currently held in a track's queue, including the keyframe currently being played
+uint8_t QAS_RGB_Anim::getQueued(uint8_t uTrack) {
+
+	if (uTrack >= QAS_RGB_ANIM_TRACKS)
+		return 0;
+
+	return (m_sTracks[uTrack].uTail - m_sTracks[uTrack].uHead) & QAS_RGB_ANIM_KEYFRAMEMASK;
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAS_RGB_Anim Control Methods
+
+//QAS_RGB_Anim::start
+//QAS_RGB_Anim Control Method
+//
+//Starts (or resumes) the animation of all tracks
+void QAS_RGB_Anim::start(void) {
+	m_bRunning = true;
+}
+
+
+//QAS_RGB_Anim::stop
+//QAS_RGB_Anim Control Method
+//
+//Pauses the animation of all tracks. Tracks will hold their current colors until start() is called
+void QAS_RGB_Anim::stop(void) {
+	m_bRunning = false;
+}
+
+
+  //--------------------------
+  //--------------------------
+  //QAS_RGB_Anim Tools Methods
+
+//QAS_RGB_Anim::beginKeyframe
+//QAS_RGB_Anim Tools Method
+//
+//Calculates the start color and color difference for the next keyframe in a track's queue
+//Any divisions required for HSV conversion are performed here once per keyframe, rather than on every tick
+void QAS_RGB_Anim::beginKeyframe(Track& sTrack) {
+
+	QAS_RGB_Anim_Keyframe& sKeyframe = sTrack.sKeyframes[sTrack.uCurrent];
+	uint8_t uTarget[3] = {(uint8_t)(sKeyframe.uColor >> 16), (uint8_t)(sKeyframe.uColor >> 8), (uint8_t)sKeyframe.uColor};
+
+	if (sKeyframe.eSpace == QAS_RGB_Anim_HSV) {
+		uint16_t uHueStart, uHueTarget;
+		uint8_t  uSatTarget, uValTarget;
+		convRGBtoHSV(sTrack.uColor, uHueStart, sTrack.uStart[1], sTrack.uStart[2]);
+		convRGBtoHSV(uTarget, uHueTarget, uSatTarget, uValTarget);
+
+		//Hue is undefined for greys, so use the hue of the other color to avoid a color sweep
+		if (!sTrack.uStart[1])
+			uHueStart = uHueTarget;
+		if (!uSatTarget)
+			uHueTarget = uHueStart;
+
+		//Take the shortest path around the hue circle
+		int16_t iDeltaHue = uHueTarget - uHueStart;
+		if (iDeltaHue > (QAS_RGB_ANIM_HUERANGE / 2))
+			iDeltaHue -= QAS_RGB_ANIM_HUERANGE;
+		else if (iDeltaHue < -(QAS_RGB_ANIM_HUERANGE / 2))
+			iDeltaHue += QAS_RGB_ANIM_HUERANGE;
+
+		sTrack.uStartHue = uHueStart;
+		sTrack.iDeltaHue = iDeltaHue;
+		sTrack.iDelta[1] = uSatTarget - sTrack.uStart[1];
+		sTrack.iDelta[2] = uValTarget - sTrack.uStart[2];
+	} else {
+		for (uint8_t i=0; i<3; i++) {
+			sTrack.uStart[i] = sTrack.uColor[i];
+			sTrack.iDelta[i] = uTarget[i] - sTrack.uColor[i];
+		}
+	}
+
+	//Per tick position step, precalculated so that no division is needed while the keyframe plays
+	//Single tick keyframes complete on their first tick, so never use the step
+	sTrack.uTick    = 0;
+	sTrack.uPos     = 0;
+	sTrack.uStep    = (sKeyframe.uTicks > 1) ? (uint32_t)(0x100000000ULL / sKeyframe.uTicks) : 0;
+	sTrack.bPlaying = true;
+}
+
+
+//QAS_RGB_Anim::calcEasing
+//QAS_RGB_Anim Tools Method
+//
+//Applies an easing curve to a Q16 position
+//eEasing - Easing curve to be applied. Member of QAS_RGB_Anim_Easing
+//uPos    - Linear position through keyframe in Q16 format (0 to 0x10000)
+//Returns eased position in Q16 format
+uint32_t QAS_RGB_Anim::calcEasing(QAS_RGB_Anim_Easing eEasing, uint32_t uPos) {
+	uint32_t uInv;
+
+	switch (eEasing) {
+		case QAS_RGB_Anim_EaseIn:
+			return (uint32_t)(((uint64_t)uPos * uPos) >> 16);
+		case QAS_RGB_Anim_EaseOut:
+			uInv = 0x10000 - uPos;
+			return 0x10000 - (uint32_t)(((uint64_t)uInv * uInv) >> 16);
+		case QAS_RGB_Anim_EaseInOut:
+			//Smoothstep: 3p^2 - 2p^3
+			return (uint32_t)((((uint64_t)uPos * uPos) >> 16) * ((3 * 0x10000) - (2 * uPos)) >> 16);
+		case QAS_RGB_Anim_Step:
+			return 0;
+		default:
+			return uPos;
+	}
+}
+
+
+//QAS_RGB_Anim::convRGBtoHSV
+//QAS_RGB_Anim Tools Method
+//
+//Converts an 8bit RGB color into fixed point HSV
+//pRGB - Array of three 8bit values (red, green and blue)
+//uHue - Set to hue (0 - 1535, with 256 steps per 60 degree sector)
+//uSat - Set to saturation (0 - 255)
+//uVal - Set to value (0 - 255)
+void QAS_RGB_Anim::convRGBtoHSV(const uint8_t* pRGB, uint16_t& uHue, uint8_t& uSat, uint8_t& uVal) {
+	uint8_t uMax = pRGB[0];
+	uint8_t uMin = pRGB[0];
+	for (uint8_t i=1; i<3; i++) {
+		if (pRGB[i] > uMax)
+			uMax = pRGB[i];
+		if (pRGB[i] < uMin)
+			uMin = pRGB[i];
+	}
+
+	int32_t iDelta = uMax - uMin;
+	uVal = uMax;
+	if (!iDelta) {
+		uHue = 0;
+		uSat = 0;
+		return;
+	}
+	uSat = ((iDelta * 255) + (uMax / 2)) / uMax;
+
+	int32_t iHue;
+	if (uMax == pRGB[0])
+		iHue = (256 * (pRGB[1] - pRGB[2])) / iDelta; else
+	if (uMax == pRGB[1])
+		iHue = 512 + ((256 * (pRGB[2] - pRGB[0])) / iDelta); else
+		iHue = 1024 + ((256 * (pRGB[0] - pRGB[1])) / iDelta);
+
+	if (iHue < 0)
+		iHue += QAS_RGB_ANIM_HUERANGE;
+	if (iHue >= QAS_RGB_ANIM_HUERANGE)
+		iHue -= QAS_RGB_ANIM_HUERANGE;
+	uHue = iHue;
+}
+
+
+//QAS_RGB_Anim::convHSVtoRGB
+//QAS_RGB_Anim Tools Method
+//
+//Converts a fixed point HSV color into 8bit RGB, without the use of any divisions
+//uHue - Hue (0 - 1535, with 256 steps per 60 degree sector)
+//uSat - Saturation (0 - 255)
+//uVal - Value (0 - 255)
+//pRGB - Array of three 8bit values to be set to red, green and blue
+void QAS_RGB_Anim::convHSVtoRGB(uint16_t uHue, uint8_t uSat, uint8_t uVal, uint8_t* pRGB) {
+
+	if (!uSat) {
+		pRGB[0] = pRGB[1] = pRGB[2] = uVal;
+		return;
+	}
+
+	uint32_t uFrac = uHue & 0xFF;
+	uint8_t  uP    = QAS_RGB_Anim_Div255(uVal * (255 - uSat));
+	uint8_t  uQ    = QAS_RGB_Anim_Div255(uVal * (255 - QAS_RGB_Anim_Div255(uSat * uFrac)));
+	uint8_t  uT    = QAS_RGB_Anim_Div255(uVal * (255 - QAS_RGB_Anim_Div255(uSat * (255 - uFrac))));
+
+	switch (uHue >> 8) {
+		case 0:  pRGB[0] = uVal; pRGB[1] = uT;   pRGB[2] = uP;   break;
+		case 1:  pRGB[0] = uQ;   pRGB[1] = uVal; pRGB[2] = uP;   break;
+		case 2:  pRGB[0] = uP;   pRGB[1] = uVal; pRGB[2] = uT;   break;
+		case 3:  pRGB[0] = uP;   pRGB[1] = uQ;   pRGB[2] = uVal; break;
+		case 4:  pRGB[0] = uT;   pRGB[1] = uP;   pRGB[2] = uVal; break;
+		default: pRGB[0] = uVal; pRGB[1] = uP;   pRGB[2] = uQ;   break;
+	}
+}
+
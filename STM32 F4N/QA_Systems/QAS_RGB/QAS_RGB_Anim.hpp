@@ -0,0 +1,196 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Systems - RGB                                                 */
+/*   Role: RGB Animation Engine                                            */
+/*   Filename: QAS_RGB_Anim.hpp                                            */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAS_RGB_ANIM_HPP_
+#define __QAS_RGB_ANIM_HPP_
+
+//Includes
+#include "setup.hpp"
+
+#include "QAD_RGB.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//--------------------
+//QAS_RGB_ANIM_TRACKS
+//
+//Maximum number of RGB LEDs (tracks) that can be animated by a single QAS_RGB_Anim instance
+#define QAS_RGB_ANIM_TRACKS       8
+
+
+//-----------------------
+//QAS_RGB_ANIM_KEYFRAMES
+//
+//Size of the keyframe queue for each track. Must be a power of two
+#define QAS_RGB_ANIM_KEYFRAMES    16
+
+
+//-------------------
+//QAS_RGB_Anim_Easing
+//
+//Easing curve used when interpolating from the previous color to a keyframe's color
+enum QAS_RGB_Anim_Easing : uint8_t {
+	QAS_RGB_Anim_Linear = 0,  //Constant rate of change
+	QAS_RGB_Anim_EaseIn,      //Starts slowly and accelerates (quadratic)
+	QAS_RGB_Anim_EaseOut,     //Starts quickly and decelerates (quadratic)
+	QAS_RGB_Anim_EaseInOut,   //Starts and ends slowly (smoothstep)
+	QAS_RGB_Anim_Step         //Holds the previous color for the keyframe's duration, then jumps to the new color
+};
+
+
+//------------------
+//QAS_RGB_Anim_Space
+//
+//Color space used when interpolating from the previous color to a keyframe's color
+enum QAS_RGB_Anim_Space : uint8_t {
+	QAS_RGB_Anim_RGB = 0,     //Interpolate red, green and blue components independently
+	QAS_RGB_Anim_HSV          //Interpolate hue (along the shortest path), saturation and value
+};
+
+
+//----------------------
+//QAS_RGB_Anim_Keyframe
+//
+//Keyframe data, as stored in a track's keyframe queue
+typedef struct {
+
+	uint32_t            uColor;     //Target color in 0xRRGGBB format
+	uint32_t            uTicks;     //Duration of the transition in timer update ticks
+	QAS_RGB_Anim_Easing eEasing;    //Easing curve to be used. Member of QAS_RGB_Anim_Easing
+	QAS_RGB_Anim_Space  eSpace;     //Color space to be used. Member of QAS_RGB_Anim_Space
+
+} QAS_RGB_Anim_Keyframe;
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//------------
+//QAS_RGB_Anim
+//
+//Timer driven color animation engine for QAD_RGB drivers
+//Each track animates a single QAD_RGB driver through a queue of keyframes. Keyframes are queued from the main thread using
+//addKeyframe(), and are interpolated from within handler(), which is to be called from a QAD_Timer update interrupt by passing
+//this class to QAD_Timer::setHandlerClass(). All interpolation is performed in fixed point.
+//When a track is set to loop, keyframes are kept in the queue once played so the sequence repeats until the track is cleared.
+class QAS_RGB_Anim : public QAD_IRQHandler_CallbackClass {
+private:
+
+	//Track data
+	typedef struct {
+
+		QAD_RGB*              pRGB;                               //RGB driver being animated, or NULL if track is unused
+
+		QAS_RGB_Anim_Keyframe sKeyframes[QAS_RGB_ANIM_KEYFRAMES]; //Keyframe queue
+		volatile uint8_t      uHead;                              //Index of first queued keyframe. Written by handler()
+		volatile uint8_t      uTail;                              //Index after last queued keyframe. Written by addKeyframe()
+		uint8_t               uCurrent;                           //Index of keyframe currently being played
+
+		volatile bool         bLoop;                              //Set to true if track is to loop through its queued keyframes
+		bool                  bPlaying;                           //Set to true when a keyframe is currently being played
+
+		uint32_t              uTick;                              //Current tick within keyframe being played
+		uint32_t              uPos;                               //Linear position through keyframe as a Q32 fraction
+		uint32_t              uStep;                              //Amount added to uPos each tick (2^32 / keyframe ticks)
+
+		uint8_t               uColor[3];                          //Current color (RGB)
+		uint8_t               uStart[3];                          //Color at start of current keyframe (RGB or HSV depending on color space)
+		int16_t               iDelta[3];                          //Difference between start and target color (RGB or HSV depending on color space)
+		uint16_t              uStartHue;                          //Hue at start of current keyframe, when HSV is used (0 - 1535)
+		int16_t               iDeltaHue;                          //Hue difference along the shortest path, when HSV is used
+
+	} Track;
+
+	Track                 m_sTracks[QAS_RGB_ANIM_TRACKS];
+	uint32_t              m_uUpdateRate;  //Rate in Hz at which handler() is called
+	volatile bool         m_bRunning;     //Set to true when animation is running
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAS_RGB_Anim() = delete;             //Delete the default class constructor, as the update rate is required
+
+	//uUpdateRate - Rate in Hz of the timer update interrupt from which handler() is called
+	QAS_RGB_Anim(uint32_t uUpdateRate) :
+		m_uUpdateRate(uUpdateRate),
+		m_bRunning(false) {
+
+		for (uint8_t i=0; i<QAS_RGB_ANIM_TRACKS; i++) {
+			m_sTracks[i].pRGB     = NULL;
+			m_sTracks[i].uHead    = 0;
+			m_sTracks[i].uTail    = 0;
+			m_sTracks[i].uCurrent = 0;
+			m_sTracks[i].bLoop    = false;
+			m_sTracks[i].bPlaying = false;
+		}
+	}
+
+
+	//NOTE: See QAS_RGB_Anim.cpp for details of the following methods
+
+	//--------------
+	//Handler Method
+
+	void handler(void* pData);
+
+
+	//-------------
+	//Track Methods
+
+	int8_t addTrack(QAD_RGB* pRGB);
+	void removeTrack(uint8_t uTrack);
+
+	QA_Result addKeyframe(uint8_t uTrack, uint32_t uColor, uint16_t uDuration,
+			                  QAS_RGB_Anim_Easing eEasing = QAS_RGB_Anim_Linear, QAS_RGB_Anim_Space eSpace = QAS_RGB_Anim_RGB);
+	void clear(uint8_t uTrack);
+
+	void setLoop(uint8_t uTrack, bool bLoop);
+	bool getLoop(uint8_t uTrack);
+
+	bool isPlaying(uint8_t uTrack);
+	uint8_t getQueued(uint8_t uTrack);
+
+
+	//---------------
+	//Control Methods
+
+	void start(void);
+	void stop(void);
+
+private:
+
+	//-------------
+	//Tools Methods
+
+	void beginKeyframe(Track& sTrack);
+	static uint32_t calcEasing(QAS_RGB_Anim_Easing eEasing, uint32_t uPos);
+	static void convRGBtoHSV(const uint8_t* pRGB, uint16_t& uHue, uint8_t& uSat, uint8_t& uVal);
+	static void convHSVtoRGB(uint16_t uHue, uint8_t uSat, uint8_t uVal, uint8_t* pRGB);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAS_RGB_ANIM_HPP_ */
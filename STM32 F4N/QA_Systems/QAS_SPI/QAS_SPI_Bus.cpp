@@ -0,0 +1,239 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: SPI                                                           */
+/*   Role: SPI Bus Manager                                                 */
+/*   Filename: QAS_SPI_Bus.cpp                                             */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAS_SPI_Bus.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //---------------------------
+  //---------------------------
+  //QAS_SPI_Bus Device Methods
+
+//QAS_SPI_Bus::addDevice
+//QAS_SPI_Bus Device Method
+//
+//Adds a device to the bus, initializing its CS pin as an output in the inactive (high) state
+//sDevice - Device settings
+//Returns the index of the new device, or -1 if no device slots are available or the CS pin is invalid
+int8_t QAS_SPI_Bus::addDevice(QAS_SPI_Bus_Device& sDevice) {
+	if (!sDevice.pCS_GPIO)
+		return -1;
+
+	for (uint8_t i=0; i<QAS_SPI_BUS_DEVICES; i++) {
+		if (m_sDevices[i].bUsed)
+			continue;
+
+		//Init CS GPIO Pin
+		HAL_GPIO_WritePin(sDevice.pCS_GPIO, sDevice.uCS_Pin, GPIO_PIN_SET);
+		GPIO_InitTypeDef GPIO_Init = {0};
+		GPIO_Init.Pin   = sDevice.uCS_Pin;
+		GPIO_Init.Mode  = GPIO_MODE_OUTPUT_PP;
+		GPIO_Init.Pull  = GPIO_PULLUP;
+		GPIO_Init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+		HAL_GPIO_Init(sDevice.pCS_GPIO, &GPIO_Init);
+
+		m_sDevices[i].sConfig = sDevice;
+		m_sDevices[i].bUsed   = true;
+		return i;
+	}
+
+	return -1;
+}
+
+
+//QAS_SPI_Bus::removeDevice
+//QAS_SPI_Bus Device Method
+//
+//Removes a device from the bus and deinitializes its CS pin
+//Any of the device's transactions still in the queue will fail when they reach the front of the queue
+//uDevice - Index of device to be removed. If a transaction for the device is active the device is not removed
+void QAS_SPI_Bus::removeDevice(uint8_t uDevice) {
+	if ((uDevice >= QAS_SPI_BUS_DEVICES) || (!m_sDevices[uDevice].bUsed))
+		return;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	QAS_SPI_Bus_Transaction* pActive = m_pActive;
+	if ((!pActive) || (pActive->uDevice != uDevice))
+		m_sDevices[uDevice].bUsed = false;
+	__set_PRIMASK(uPRIMASK);
+
+	if (!m_sDevices[uDevice].bUsed)
+		HAL_GPIO_DeInit(m_sDevices[uDevice].sConfig.pCS_GPIO, m_sDevices[uDevice].sConfig.uCS_Pin);
+}
+
+
+  //--------------------------------
+  //--------------------------------
+  //QAS_SPI_Bus Transaction Methods
+
+//QAS_SPI_Bus::submit
+//QAS_SPI_Bus Transaction Method
+//
+//Adds a transaction to the queue, after any queued transactions of the same or higher priority. If the bus is idle the
+//transaction is started immediately. Can be called from interrupts, including from transaction callbacks
+//sTrans - Transaction to be submitted. Must remain valid until the transaction completes or fails
+//Returns QA_OK if the transaction was queued, QA_Error_PeriphBusy if it is already queued or active,
+//or QA_Fail if the transaction has no segments or an invalid device
+QA_Result QAS_SPI_Bus::submit(QAS_SPI_Bus_Transaction& sTrans) {
+	if ((sTrans.uDevice >= QAS_SPI_BUS_DEVICES) || (!m_sDevices[sTrans.uDevice].bUsed) || (!sTrans.pSegments) || (!sTrans.uCount))
+		return QA_Fail;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+
+	if ((sTrans.eState == QAS_SPI_Bus_Trans_Queued) || (sTrans.eState == QAS_SPI_Bus_Trans_Active)) {
+		__set_PRIMASK(uPRIMASK);
+		return QA_Error_PeriphBusy;
+	}
+
+	//Insert into queue in priority order
+	QAS_SPI_Bus_Transaction** pLink = &m_pQueue;
+	while ((*pLink) && ((*pLink)->uPriority >= sTrans.uPriority))
+		pLink = &(*pLink)->pNext;
+	sTrans.pNext  = *pLink;
+	sTrans.eState = QAS_SPI_Bus_Trans_Queued;
+	*pLink        = &sTrans;
+
+	//Start transaction if bus is idle
+	if (!m_pActive)
+		startNext();
+
+	__set_PRIMASK(uPRIMASK);
+	return QA_OK;
+}
+
+
+//QAS_SPI_Bus::cancel
+//QAS_SPI_Bus Transaction Method
+//
+//Removes a queued transaction from the queue. The transaction's state is returned to QAS_SPI_Bus_Trans_Idle and its callback is not called
+//sTrans - Transaction to be cancelled
+//Returns QA_OK if the transaction was removed, QA_Error_PeriphBusy if it is currently active, or QA_Fail if it is not queued
+QA_Result QAS_SPI_Bus::cancel(QAS_SPI_Bus_Transaction& sTrans) {
+	QA_Result eRes = QA_Fail;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+
+	if (m_pActive == &sTrans) {
+		eRes = QA_Error_PeriphBusy;
+	} else {
+		QAS_SPI_Bus_Transaction** pLink = &m_pQueue;
+		while ((*pLink) && (*pLink != &sTrans))
+			pLink = &(*pLink)->pNext;
+
+		if (*pLink) {
+			*pLink        = sTrans.pNext;
+			sTrans.pNext  = NULL;
+			sTrans.eState = QAS_SPI_Bus_Trans_Idle;
+			eRes          = QA_OK;
+		}
+	}
+
+	__set_PRIMASK(uPRIMASK);
+	return eRes;
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAS_SPI_Bus Handler Methods
+
+//QAS_SPI_Bus::handler
+//QAS_SPI_Bus Handler Method
+//
+//Asynchronous transfer callback installed into the QAD_SPI driver, called from the DMA interrupt when a transaction ends
+//The next queued transaction is started before the completed transaction's callback is called, to keep the bus busy
+//pData - Pointer to QAS_SPI_Bus class
+void QAS_SPI_Bus::handler(void* pData) {
+	QAS_SPI_Bus* pBus = (QAS_SPI_Bus*)pData;
+	QAS_SPI_Bus_Transaction* pTrans = pBus->m_pActive;
+	if (!pTrans)
+		return;
+
+	//Raise CS of completed transaction's device
+	QAS_SPI_Bus_Device& sDevice = pBus->m_sDevices[pTrans->uDevice].sConfig;
+	HAL_GPIO_WritePin(sDevice.pCS_GPIO, sDevice.uCS_Pin, GPIO_PIN_SET);
+
+	QAS_SPI_Bus_TransState eState = (pBus->m_pSPI->getAsyncState() == QAD_SPI_Async_Complete) ? QAS_SPI_Bus_Trans_Complete : QAS_SPI_Bus_Trans_Error;
+
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	pBus->m_pActive = NULL;
+	pBus->startNext();
+	__set_PRIMASK(uPRIMASK);
+
+	pBus->finishTrans(pTrans, eState);
+}
+
+
+  //--------------------------
+  //--------------------------
+  //QAS_SPI_Bus Tools Methods
+
+//QAS_SPI_Bus::startNext
+//QAS_SPI_Bus Tools Method
+//
+//Starts the transaction at the front of the queue, reconfiguring the SPI peripheral for its device and lowering the device's CS
+//Transactions that cannot be started are failed and the following transaction tried. Must be called with interrupts disabled
+//A failed transaction's callback may submit a transaction, which starts it through a nested call. In that case this method
+//returns once the callback has run, as the bus is no longer idle
+void QAS_SPI_Bus::startNext(void) {
+	while (m_pQueue) {
+		QAS_SPI_Bus_Transaction* pTrans = m_pQueue;
+		m_pQueue = pTrans->pNext;
+
+		QAS_SPI_Bus_Device& sDevice = m_sDevices[pTrans->uDevice].sConfig;
+		if ((m_sDevices[pTrans->uDevice].bUsed) &&
+				(m_pSPI->reconfigure(sDevice.eClkPolarity, sDevice.eClkPhase, sDevice.ePrescaler, sDevice.eDataSize, sDevice.eFirstBit) == QA_OK)) {
+
+			if (pTrans->pStartCallback)
+				pTrans->pStartCallback(pTrans->pCallbackData);
+
+			HAL_GPIO_WritePin(sDevice.pCS_GPIO, sDevice.uCS_Pin, GPIO_PIN_RESET);
+			m_pActive      = pTrans;
+			pTrans->eState = QAS_SPI_Bus_Trans_Active;
+			if (m_pSPI->transferAsync(pTrans->pSegments, pTrans->uCount) == QA_OK)
+				return;
+
+			HAL_GPIO_WritePin(sDevice.pCS_GPIO, sDevice.uCS_Pin, GPIO_PIN_SET);
+			m_pActive = NULL;
+		}
+
+		finishTrans(pTrans, QAS_SPI_Bus_Trans_Error);
+		if (m_pActive)
+			return;
+	}
+}
+
+
+//QAS_SPI_Bus::finishTrans
+//QAS_SPI_Bus Tools Method
+//
+//Sets the final state of a transaction and calls its callback if set
+void QAS_SPI_Bus::finishTrans(QAS_SPI_Bus_Transaction* pTrans, QAS_SPI_Bus_TransState eState) {
+	pTrans->pNext  = NULL;
+	pTrans->eState = eState;
+	if (pTrans->pCallback)
+		pTrans->pCallback(pTrans->pCallbackData);
+}
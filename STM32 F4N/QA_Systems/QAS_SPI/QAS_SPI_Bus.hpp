@@ -0,0 +1,182 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: SPI                                                           */
+/*   Role: SPI Bus Manager                                                 */
+/*   Filename: QAS_SPI_Bus.hpp                                             */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAS_SPI_BUS_HPP_
+#define __QAS_SPI_BUS_HPP_
+
+//Includes
+#include "setup.hpp"
+
+#include "QAD_SPI.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//--------------------
+//QAS_SPI_BUS_DEVICES
+//
+//Maximum number of devices that can be attached to a single QAS_SPI_Bus instance
+#define QAS_SPI_BUS_DEVICES    8
+
+
+//----------------------
+//QAS_SPI_Bus_TransState
+//
+//State of a transaction, as stored in QAS_SPI_Bus_Transaction::eState
+enum QAS_SPI_Bus_TransState : uint8_t {
+	QAS_SPI_Bus_Trans_Idle = 0,   //Transaction has not been submitted
+	QAS_SPI_Bus_Trans_Queued,     //Transaction is waiting in the queue
+	QAS_SPI_Bus_Trans_Active,     //Transaction is currently being transferred
+	QAS_SPI_Bus_Trans_Complete,   //Transaction completed successfully
+	QAS_SPI_Bus_Trans_Error       //Transaction failed, or the device was invalid
+};
+
+
+//------------------
+//QAS_SPI_Bus_Device
+//
+//Per device settings. The bus peripheral is reconfigured to these settings before each of the device's transactions
+typedef struct {
+
+	QAD_SPI_ClkPolarity   eClkPolarity;
+	QAD_SPI_ClkPhase      eClkPhase;
+	QAD_SPI_BaudPrescaler ePrescaler;
+	QAD_SPI_DataSize      eDataSize;
+	QAD_SPI_FirstBit      eFirstBit;
+
+	GPIO_TypeDef*         pCS_GPIO;    //GPIO port of device's CS pin. CS is active low
+	uint16_t              uCS_Pin;     //GPIO pin of device's CS pin
+
+} QAS_SPI_Bus_Device;
+
+
+//-----------------------
+//QAS_SPI_Bus_Transaction
+//
+//A single transaction to a device, consisting of one or more segments transferred with CS held low
+//Transactions are owned by the caller and linked directly into the queue, so a transaction and its segments must remain valid
+//and unmodified from submit() until eState becomes QAS_SPI_Bus_Trans_Complete or QAS_SPI_Bus_Trans_Error
+typedef struct QAS_SPI_Bus_Transaction {
+
+	uint8_t                         uDevice;        //Device index returned by QAS_SPI_Bus::addDevice()
+	uint8_t                         uPriority;      //Queue priority. Higher values are transferred first, equal priorities in submission order
+	const QAD_SPI_Segment*          pSegments;      //Segments to be transferred (see QAD_SPI_Segment in QAD_SPI.hpp)
+	uint8_t                         uCount;         //Number of segments
+
+	QAD_IRQHandler_CallbackFunction pStartCallback; //Function to be called just before CS is lowered to start the transaction, or NULL
+	                                                //Used for device signals such as a display's data/command pin. Passed pCallbackData
+	QAD_IRQHandler_CallbackFunction pCallback;      //Function to be called from the DMA interrupt when the transaction ends, or NULL
+	void*                           pCallbackData;  //Data to be passed to pCallback and pStartCallback
+
+	volatile QAS_SPI_Bus_TransState eState;         //Transaction state. Must be initialized to QAS_SPI_Bus_Trans_Idle, and is then set by QAS_SPI_Bus
+	QAS_SPI_Bus_Transaction*        pNext;          //Next transaction in queue. Used internally by QAS_SPI_Bus
+
+} QAS_SPI_Bus_Transaction;
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//-----------
+//QAS_SPI_Bus
+//
+//Shares a single QAD_SPI driver between multiple devices, each with its own CS pin and SPI settings
+//Transactions are queued by priority and transferred using QAD_SPI's asynchronous DMA transfers. When a transaction completes,
+//the next is started directly from the DMA interrupt, with only the SPI settings that differ between the two devices being changed.
+//The QAD_SPI driver must be initialized in 2 line master mode with soft CS and no CS pin (pCS_GPIO set to NULL), and is then owned
+//by this class, which installs its own asynchronous transfer callback. The driver's DMA handler must be called as described in QAD_SPI.hpp
+class QAS_SPI_Bus {
+private:
+
+	//Device data
+	typedef struct {
+
+		bool               bUsed;      //Set to true if device slot is in use
+		QAS_SPI_Bus_Device sConfig;    //Device settings
+
+	} Device;
+
+	QAD_SPI*                          m_pSPI;                          //SPI driver used by bus
+	Device                            m_sDevices[QAS_SPI_BUS_DEVICES]; //Attached devices
+
+	QAS_SPI_Bus_Transaction*          m_pQueue;                        //First queued transaction, or NULL if queue is empty
+	QAS_SPI_Bus_Transaction* volatile m_pActive;                       //Transaction currently being transferred, or NULL if bus is idle
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAS_SPI_Bus() = delete;          //Delete the default class constructor, as an SPI driver is required
+
+	//pSPI - Initialized QAD_SPI driver to be used by the bus
+	QAS_SPI_Bus(QAD_SPI* pSPI) :
+		m_pSPI(pSPI),
+		m_pQueue(NULL),
+		m_pActive(NULL) {
+
+		for (uint8_t i=0; i<QAS_SPI_BUS_DEVICES; i++)
+			m_sDevices[i].bUsed = false;
+
+		m_pSPI->setAsyncCallback(handler, this);
+	}
+
+
+	//NOTE: See QAS_SPI_Bus.cpp for details of the following methods
+
+	//--------------
+	//Device Methods
+
+	int8_t addDevice(QAS_SPI_Bus_Device& sDevice);
+	void removeDevice(uint8_t uDevice);
+
+
+	//-------------------
+	//Transaction Methods
+
+	QA_Result submit(QAS_SPI_Bus_Transaction& sTrans);
+	QA_Result cancel(QAS_SPI_Bus_Transaction& sTrans);
+
+	//Returns true while a transaction is being transferred
+	bool isBusy(void) {
+		return (m_pActive != NULL);
+	}
+
+
+	//--------------
+	//Handler Method
+
+	static void handler(void* pData);
+
+private:
+
+	//-------------
+	//Tools Methods
+
+	void startNext(void);
+	void finishTrans(QAS_SPI_Bus_Transaction* pTrans, QAS_SPI_Bus_TransState eState);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAS_SPI_BUS_HPP_ */
@@ -0,0 +1,446 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Systems - Servo                                               */
+/*   Role: Servo Motion Profiler                                           */
+/*   Filename: QAS_Servo_Profiler.cpp                                      */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAS_Servo_Profiler.hpp"
+
+#include <math.h>
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+  //-----------------------------------
+  //-----------------------------------
+  //QAS_Servo_Profiler Handler Methods
+
+//QAS_Servo_Profiler::handler
+//QAS_Servo_Profiler Handler Method
+//
+//To be called from a timer update interrupt, at the update rate provided to the class constructor
+//Advances each moving axis by one tick and updates its servo driver
+//pData - Unused
+void QAS_Servo_Profiler::handler(void* pData) {
+
+	for (uint8_t i=0; i<QAS_SERVO_PROFILER_AXES; i++) {
+		Axis& sAxis = m_sAxes[i];
+
+		if ((!sAxis.pServo) || (!sAxis.bMoving))
+			continue;
+
+		//Integrate jerk (or acceleration) to find new position
+		int64_t iSign = sAxis.iSegSign[sAxis.uSeg];
+		if (sAxis.bJerk)
+			sAxis.iAcc += iSign * sAxis.iRate; else
+			sAxis.iAcc  = iSign * sAxis.iRate;
+		sAxis.iVel += sAxis.iAcc;
+		sAxis.iPos += sAxis.iVel;
+
+		//Move to next segment, skipping any zero length segments
+		sAxis.uSegTick++;
+		while ((sAxis.uSeg < sAxis.uSegCount) && (sAxis.uSegTick >= sAxis.uSegTicks[sAxis.uSeg])) {
+			sAxis.uSeg++;
+			sAxis.uSegTick = 0;
+		}
+
+		//Finish move if all segments are complete, otherwise update servo with rounded position
+		if (sAxis.uSeg >= sAxis.uSegCount)
+			finishMove(sAxis); else
+			sAxis.pServo->setCurrent(sAxis.uStart + (int32_t)((sAxis.iPos + 0x80000000LL) >> 32));
+	}
+}
+
+
+  //--------------------------------
+  //--------------------------------
+  //QAS_Servo_Profiler Axis Methods
+
+//QAS_Servo_Profiler::addAxis
+//QAS_Servo_Profiler Axis Method
+//
+//Adds a servo driver to be controlled by the profiler. The driver must already be initialized
+//pServo  - Pointer to the servo driver
+//sLimits - Motion limits for the axis. Velocity and acceleration must be non-zero
+//Returns the index of the new axis, or -1 if no axes are available or the limits are invalid
+int8_t QAS_Servo_Profiler::addAxis(QAD_Servo* pServo, QAS_Servo_Profiler_Limits& sLimits) {
+
+	if ((!pServo) || (!sLimits.uVelocity) || (!sLimits.uAcceleration))
+		return -1;
+
+	for (uint8_t i=0; i<QAS_SERVO_PROFILER_AXES; i++) {
+		if (!m_sAxes[i].pServo) {
+			m_sAxes[i].sLimits = sLimits;
+			m_sAxes[i].bMoving = false;
+			m_sAxes[i].pServo  = pServo;
+			return i;
+		}
+	}
+	return -1;
+}
+
+
+//QAS_Servo_Profiler::removeAxis
+//QAS_Servo_Profiler Axis Method
+//
+//Removes an axis, stopping any move in progress
+//uAxis - Index of the axis to be removed
+void QAS_Servo_Profiler::removeAxis(uint8_t uAxis) {
+
+	if (uAxis >= QAS_SERVO_PROFILER_AXES)
+		return;
+
+	m_sAxes[uAxis].bMoving = false;
+	m_sAxes[uAxis].pServo  = NULL;
+}
+
+
+//QAS_Servo_Profiler::setLimits
+//QAS_Servo_Profiler Axis Method
+//
+//Sets the motion limits for an axis. New limits take effect from the next move
+//uAxis   - Index of the axis
+//sLimits - Motion limits for the axis. Velocity and acceleration must be non-zero
+void QAS_Servo_Profiler::setLimits(uint8_t uAxis, QAS_Servo_Profiler_Limits& sLimits) {
+
+	if ((uAxis >= QAS_SERVO_PROFILER_AXES) || (!sLimits.uVelocity) || (!sLimits.uAcceleration))
+		return;
+
+	m_sAxes[uAxis].sLimits = sLimits;
+}
+
+
+  //----------------------------------
+  //----------------------------------
+  //QAS_Servo_Profiler Motion Methods
+
+//QAS_Servo_Profiler::move
+//QAS_Servo_Profiler Motion Method
+//
+//Starts a move of a single axis from its current position to a target position
+//uAxis     - Index of the axis
+//uTarget   - Target position in servo compare counts. Will be clamped to the servo's minimum and maximum
+//pCallback - Function to be called (from within handler()) when the move completes, or NULL
+//pData     - Data to be passed to pCallback
+//Returns QA_OK if the move has been started, or QA_Fail if the axis is invalid or is already moving
+QA_Result QAS_Servo_Profiler::move(uint8_t uAxis, uint32_t uTarget, QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+	return moveGroup(&uAxis, &uTarget, 1, pCallback, pData);
+}
+
+
+//QAS_Servo_Profiler::moveGroup
+//QAS_Servo_Profiler Motion Method
+//
+//Starts a coordinated move of several axes. Each axis is planned within its own limits, and then all axes are stretched to
+//the duration of the slowest axis, keeping the shape of each profile, so that all axes start and arrive on the same tick
+//pAxes     - Array of axis indexes
+//pTargets  - Array of target positions in servo compare counts, one per axis
+//uCount    - Number of axes in the group
+//pCallback - Function to be called (from within handler()) once when all axes have arrived, or NULL
+//pData     - Data to be passed to pCallback
+//Returns QA_OK if the move has been started, or QA_Fail if any axis is invalid or is already moving
+QA_Result QAS_Servo_Profiler::moveGroup(const uint8_t* pAxes, const uint32_t* pTargets, uint8_t uCount,
+		                                    QAD_IRQHandler_CallbackFunction pCallback, void* pData) {
+
+	if (!uCount)
+		return QA_Fail;
+
+	for (uint8_t i=0; i<uCount; i++) {
+		if ((pAxes[i] >= QAS_SERVO_PROFILER_AXES) || (!m_sAxes[pAxes[i]].pServo) || (m_sAxes[pAxes[i]].bMoving))
+			return QA_Fail;
+	}
+
+	//Plan each axis and find the duration of the slowest
+	uint32_t uTicks = 0;
+	for (uint8_t i=0; i<uCount; i++) {
+		uint32_t uAxisTicks = planMove(m_sAxes[pAxes[i]], pTargets[i]);
+		if (uAxisTicks > uTicks)
+			uTicks = uAxisTicks;
+	}
+
+	//Stretch each axis to the same duration
+	//The callback is attached to the highest indexed axis that is moving, as it will be the last to finish within handler()
+	int8_t iLast = -1;
+	for (uint8_t i=0; i<uCount; i++) {
+		Axis& sAxis = m_sAxes[pAxes[i]];
+		sAxis.pCallback = NULL;
+		if (sAxis.uSegCount) {
+			stretchMove(sAxis, uTicks);
+			if ((int8_t)pAxes[i] > iLast)
+				iLast = pAxes[i];
+		}
+	}
+
+	//If no axis needs to move then the move is already complete
+	if (iLast < 0) {
+		if (pCallback)
+			pCallback(pData);
+		return QA_OK;
+	}
+
+	m_sAxes[iLast].pCallback     = pCallback;
+	m_sAxes[iLast].pCallbackData = pData;
+
+	//Start all axes together
+	uint32_t uPRIMASK = __get_PRIMASK();
+	__disable_irq();
+	for (uint8_t i=0; i<uCount; i++) {
+		if (m_sAxes[pAxes[i]].uSegCount)
+			m_sAxes[pAxes[i]].bMoving = true;
+	}
+	__set_PRIMASK(uPRIMASK);
+
+	return QA_OK;
+}
+
+
+//QAS_Servo_Profiler::stop
+//QAS_Servo_Profiler Motion Method
+//
+//Immediately stops a move in progress, leaving the servo at its current position. The completion callback is not called
+//uAxis - Index of the axis
+void QAS_Servo_Profiler::stop(uint8_t uAxis) {
+
+	if (uAxis >= QAS_SERVO_PROFILER_AXES)
+		return;
+
+	m_sAxes[uAxis].bMoving = false;
+}
+
+
+//QAS_Servo_Profiler::isMoving
+//QAS_Servo_Profiler Motion Method
+//
+//Returns true if the axis currently has a move in progress
+bool QAS_Servo_Profiler::isMoving(uint8_t uAxis) {
+
+	if (uAxis >= QAS_SERVO_PROFILER_AXES)
+		return false;
+
+	return m_sAxes[uAxis].bMoving;
+}
+
+
+  //---------------------------------
+  //---------------------------------
+  //QAS_Servo_Profiler Tools Methods
+
+//QAS_Servo_Profiler::planMove
+//QAS_Servo_Profiler Tools Method
+//
+//Plans the minimum time profile for a move within the axis's limits, storing the segment lengths in whole ticks
+//This is performed once per move, so floating point is used here
+//sAxis   - The axis to be planned
+//uTarget - Target position in servo compare counts
+//Returns the total duration of the move in ticks, or 0 if no movement is required
+uint32_t QAS_Servo_Profiler::planMove(Axis& sAxis, uint32_t uTarget) {
+
+	//Clamp target to servo range
+	if (uTarget < sAxis.pServo->getMin())
+		uTarget = sAxis.pServo->getMin();
+	if (uTarget > sAxis.pServo->getMax())
+		uTarget = sAxis.pServo->getMax();
+
+	sAxis.uStart    = sAxis.pServo->getCurrent();
+	sAxis.uTarget   = uTarget;
+	sAxis.uSegCount = 0;
+	if (uTarget == sAxis.uStart)
+		return 0;
+
+	//Convert limits to per tick units
+	float fRate = m_uUpdateRate;
+	float fDist = (uTarget > sAxis.uStart) ? (uTarget - sAxis.uStart) : (sAxis.uStart - uTarget);
+	float fV    = sAxis.sLimits.uVelocity / fRate;
+	float fA    = sAxis.sLimits.uAcceleration / (fRate * fRate);
+	float fJ    = sAxis.sLimits.uJerk / (fRate * fRate * fRate);
+	float fTJ   = 0.0f;
+	float fTA;
+	float fTV   = 0.0f;
+
+	sAxis.bJerk = (sAxis.sLimits.uJerk != 0);
+	if (sAxis.bJerk) {
+
+		//S-curve profile
+		//Find jerk and constant acceleration times needed to reach maximum velocity
+		fTJ = fA / fJ;
+		if ((fV * fJ) < (fA * fA)) {
+			fTJ = sqrtf(fV / fJ);
+			fTA = 0.0f;
+		} else {
+			fTA = (fV / fA) - fTJ;
+		}
+
+		//Distance covered while accelerating to and decelerating from maximum velocity
+		float fDistAcc = fV * ((2.0f * fTJ) + fTA);
+		if (fDist >= fDistAcc) {
+			fTV = (fDist - fDistAcc) / fV;
+		} else {
+
+			//Maximum velocity is not reached, check if maximum acceleration is reached
+			fTJ = fA / fJ;
+			fTA = (sqrtf((fTJ * fTJ) + ((4.0f * fDist) / fA)) - (3.0f * fTJ)) / 2.0f;
+			if (fTA < 0.0f) {
+				fTA = 0.0f;
+				fTJ = cbrtf(fDist / (2.0f * fJ));
+			}
+		}
+
+	} else {
+
+		//Trapezoidal profile
+		fTA = fV / fA;
+		float fDistAcc = fV * fTA;
+		if (fDist >= fDistAcc) {
+			fTV = (fDist - fDistAcc) / fV;
+		} else {
+			fTA = sqrtf(fDist / fA);
+		}
+	}
+
+	//Convert times to whole ticks, rounding up so limits are not exceeded
+	uint32_t uTJ = (uint32_t)ceilf(fTJ);
+	uint32_t uTA = (uint32_t)ceilf(fTA);
+	uint32_t uTV = (uint32_t)ceilf(fTV);
+
+	if (sAxis.bJerk) {
+		if (!uTJ)
+			uTJ = 1;
+		sAxis.uSegCount    = 7;
+		sAxis.uSegTicks[0] = uTJ;
+		sAxis.uSegTicks[1] = uTA;
+		sAxis.uSegTicks[3] = uTV;
+		return (4 * uTJ) + (2 * uTA) + uTV;
+	}
+
+	if (!uTA)
+		uTA = 1;
+	sAxis.uSegCount    = 3;
+	sAxis.uSegTicks[0] = uTA;
+	sAxis.uSegTicks[1] = uTV;
+	return (2 * uTA) + uTV;
+}
+
+
+//QAS_Servo_Profiler::stretchMove
+//QAS_Servo_Profiler Tools Method
+//
+//Stretches a planned profile to a given duration, and then calculates the jerk (or acceleration) that makes the integrated
+//profile finish exactly at the target position. Segment lengths are scaled together so the shape of the profile is kept,
+//with any rounding taken up by the constant velocity segment.
+//The end position of a profile with unit jerk is found with the closed form sums for each constant jerk segment:
+//   v' = v + n.a + j.n(n+1)/2
+//   p' = p + n.v + a.n(n+1)/2 + j.n(n+1)(n+2)/6
+//sAxis  - The axis, which must have already been planned with planMove()
+//uTicks - The required duration in ticks, which must not be less than the planned duration
+void QAS_Servo_Profiler::stretchMove(Axis& sAxis, uint32_t uTicks) {
+
+	int64_t iDir = (sAxis.uTarget > sAxis.uStart) ? 1 : -1;
+	int64_t iTJ, iTA, iTV;
+
+	//Scale segment lengths
+	if (sAxis.bJerk) {
+		iTJ = sAxis.uSegTicks[0];
+		iTA = sAxis.uSegTicks[1];
+		iTV = sAxis.uSegTicks[3];
+		uint32_t uPlanned = (4 * iTJ) + (2 * iTA) + iTV;
+		if (uTicks != uPlanned) {
+			float fScale = (float)uTicks / uPlanned;
+			iTJ = (int64_t)((iTJ * fScale) + 0.5f);
+			iTA = (int64_t)((iTA * fScale) + 0.5f);
+			if (iTJ < 1)
+				iTJ = 1;
+			iTV = uTicks - (4 * iTJ) - (2 * iTA);
+			while (iTV < 0) {
+				if (iTA > 0)
+					iTA--; else
+					iTJ--;
+				iTV = uTicks - (4 * iTJ) - (2 * iTA);
+			}
+		}
+
+		const int8_t iSigns[7] = {1, 0, -1, 0, -1, 0, 1};
+		const int64_t iLengths[7] = {iTJ, iTA, iTJ, iTV, iTJ, iTA, iTJ};
+		for (uint8_t i=0; i<7; i++) {
+			sAxis.uSegTicks[i] = iLengths[i];
+			sAxis.iSegSign[i]  = iSigns[i] * iDir;
+		}
+	} else {
+		iTA = sAxis.uSegTicks[0];
+		iTV = sAxis.uSegTicks[1];
+		uint32_t uPlanned = (2 * iTA) + iTV;
+		if (uTicks != uPlanned) {
+			iTA = (int64_t)((iTA * ((float)uTicks / uPlanned)) + 0.5f);
+			if (iTA < 1)
+				iTA = 1;
+			iTV = uTicks - (2 * iTA);
+			while ((iTV < 0) && (iTA > 1)) {
+				iTA--;
+				iTV = uTicks - (2 * iTA);
+			}
+		}
+
+		sAxis.uSegTicks[0] = iTA;
+		sAxis.uSegTicks[1] = iTV;
+		sAxis.uSegTicks[2] = iTA;
+		sAxis.iSegSign[0]  = iDir;
+		sAxis.iSegSign[1]  = 0;
+		sAxis.iSegSign[2]  = -iDir;
+	}
+
+	//Find end position of profile with unit jerk (or acceleration)
+	int64_t iAcc = 0;
+	int64_t iVel = 0;
+	int64_t iPos = 0;
+	for (uint8_t i=0; i<sAxis.uSegCount; i++) {
+		int64_t n = sAxis.uSegTicks[i];
+		int64_t j = sAxis.iSegSign[i] * iDir;
+		if (!sAxis.bJerk) {
+			iAcc = j;
+			j    = 0;
+		}
+		iPos += (n * iVel) + ((iAcc * n * (n + 1)) / 2) + ((j * n * (n + 1) * (n + 2)) / 6);
+		iVel += (n * iAcc) + ((j * n * (n + 1)) / 2);
+		iAcc += j * n;
+	}
+
+	//Calculate jerk (or acceleration) in Q32 format to reach target
+	int64_t iDist = (sAxis.uTarget > sAxis.uStart) ? (sAxis.uTarget - sAxis.uStart) : (sAxis.uStart - sAxis.uTarget);
+	sAxis.iRate   = (iPos > 0) ? ((iDist << 32) / iPos) : 0;
+
+	//Reset integrator
+	sAxis.iAcc     = 0;
+	sAxis.iVel     = 0;
+	sAxis.iPos     = 0;
+	sAxis.uSeg     = 0;
+	sAxis.uSegTick = 0;
+}
+
+
+//QAS_Servo_Profiler::finishMove
+//QAS_Servo_Profiler Tools Method
+//
+//Sets servo to exact target position, ends the move and calls the completion callback if one has been set
+void QAS_Servo_Profiler::finishMove(Axis& sAxis) {
+
+	sAxis.pServo->setCurrent(sAxis.uTarget);
+	sAxis.bMoving = false;
+
+	if (sAxis.pCallback)
+		sAxis.pCallback(sAxis.pCallbackData);
+}
+
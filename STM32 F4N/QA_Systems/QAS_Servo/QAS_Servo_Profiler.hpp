@@ -0,0 +1,162 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Systems - Servo                                               */
+/*   Role: Servo Motion Profiler                                           */
+/*   Filename: QAS_Servo_Profiler.hpp                                      */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAS_SERVO_PROFILER_HPP_
+#define __QAS_SERVO_PROFILER_HPP_
+
+//Includes
+#include "setup.hpp"
+
+#include "QAD_Servo.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//-------------------------
+//QAS_SERVO_PROFILER_AXES
+//
+//Maximum number of servos (axes) that can be controlled by a single QAS_Servo_Profiler instance
+#define QAS_SERVO_PROFILER_AXES       8
+
+
+//----------------------------
+//QAS_SERVO_PROFILER_SEGMENTS
+//
+//Number of segments in a jerk limited (S-curve) profile
+#define QAS_SERVO_PROFILER_SEGMENTS   7
+
+
+//--------------------------
+//QAS_Servo_Profiler_Limits
+//
+//Motion limits for an axis. All values are in servo compare counts (as used by QAD_Servo::setCurrent())
+typedef struct {
+
+	uint32_t uVelocity;      //Maximum velocity in counts per second
+	uint32_t uAcceleration;  //Maximum acceleration in counts per second squared
+	uint32_t uJerk;          //Maximum jerk in counts per second cubed. Set to 0 for a trapezoidal (acceleration limited) profile
+
+} QAS_Servo_Profiler_Limits;
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//------------------
+//QAS_Servo_Profiler
+//
+//Timer driven motion profiler for QAD_Servo drivers
+//Moves are planned once when requested, producing a sequence of constant jerk (S-curve) or constant acceleration (trapezoidal)
+//segments measured in whole timer ticks. handler(), which is to be called from a QAD_Timer update interrupt by passing this
+//class to QAD_Timer::setHandlerClass(), then integrates the profile using 64bit fixed point (Q32) arithmetic only.
+//Moves started together with moveGroup() are stretched to the duration of the slowest axis, so all axes arrive on the same tick.
+class QAS_Servo_Profiler : public QAD_IRQHandler_CallbackClass {
+private:
+
+	//Axis data
+	typedef struct {
+
+		QAD_Servo*                      pServo;          //Servo driver being controlled, or NULL if axis is unused
+		QAS_Servo_Profiler_Limits       sLimits;         //Motion limits
+
+		volatile bool                   bMoving;         //Set to true while a move is in progress
+
+		uint32_t                        uSegTicks[QAS_SERVO_PROFILER_SEGMENTS]; //Length of each profile segment in ticks
+		int8_t                          iSegSign[QAS_SERVO_PROFILER_SEGMENTS];  //Direction of jerk (or acceleration) in each segment
+		uint8_t                         uSegCount;       //Number of segments in the profile (7 for S-curve, 3 for trapezoidal)
+		uint8_t                         uSeg;            //Current segment
+		uint32_t                        uSegTick;        //Current tick within current segment
+		bool                            bJerk;           //Set to true if profile is jerk limited
+
+		int64_t                         iRate;           //Jerk (or acceleration for trapezoidal profiles) in Q32 counts per tick^3 (or tick^2)
+		int64_t                         iAcc;            //Current acceleration in Q32 counts per tick^2
+		int64_t                         iVel;            //Current velocity in Q32 counts per tick
+		int64_t                         iPos;            //Current position relative to start of move in Q32 counts
+
+		uint32_t                        uStart;          //Position at start of move
+		uint32_t                        uTarget;         //Target position of move
+
+		QAD_IRQHandler_CallbackFunction pCallback;       //Function to be called when move completes, or NULL
+		void*                           pCallbackData;   //Data to be passed to pCallback
+
+	} Axis;
+
+	Axis      m_sAxes[QAS_SERVO_PROFILER_AXES];
+	uint32_t  m_uUpdateRate;   //Rate in Hz at which handler() is called
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAS_Servo_Profiler() = delete;         //Delete the default class constructor, as the update rate is required
+
+	//uUpdateRate - Rate in Hz of the timer update interrupt from which handler() is called
+	QAS_Servo_Profiler(uint32_t uUpdateRate) :
+		m_uUpdateRate(uUpdateRate) {
+
+		for (uint8_t i=0; i<QAS_SERVO_PROFILER_AXES; i++) {
+			m_sAxes[i].pServo  = NULL;
+			m_sAxes[i].bMoving = false;
+		}
+	}
+
+
+	//NOTE: See QAS_Servo_Profiler.cpp for details of the following methods
+
+	//--------------
+	//Handler Method
+
+	void handler(void* pData);
+
+
+	//------------
+	//Axis Methods
+
+	int8_t addAxis(QAD_Servo* pServo, QAS_Servo_Profiler_Limits& sLimits);
+	void removeAxis(uint8_t uAxis);
+	void setLimits(uint8_t uAxis, QAS_Servo_Profiler_Limits& sLimits);
+
+
+	//--------------
+	//Motion Methods
+
+	QA_Result move(uint8_t uAxis, uint32_t uTarget, QAD_IRQHandler_CallbackFunction pCallback = NULL, void* pData = NULL);
+	QA_Result moveGroup(const uint8_t* pAxes, const uint32_t* pTargets, uint8_t uCount,
+			                QAD_IRQHandler_CallbackFunction pCallback = NULL, void* pData = NULL);
+	void stop(uint8_t uAxis);
+	bool isMoving(uint8_t uAxis);
+
+private:
+
+	//-------------
+	//Tools Methods
+
+	uint32_t planMove(Axis& sAxis, uint32_t uTarget);
+	void stretchMove(Axis& sAxis, uint32_t uTicks);
+	void finishMove(Axis& sAxis);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAS_SERVO_PROFILER_HPP_ */
@@ -0,0 +1,411 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tools                                                         */
+/*   Role: Fixed Point Digital Filters                                     */
+/*   Filename: QAT_Filter.cpp                                              */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAT_Filter.hpp"
+
+#include <string.h>
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+  //--------------------------------
+  //--------------------------------
+  //QAT_Filter_BiquadQ15 Methods
+
+//QAT_Filter_BiquadQ15::addStage
+//QAT_Filter_BiquadQ15 Method
+//
+//Adds a stage to the end of the cascade
+//sCoeffs - Stage coefficients (see QAT_Filter_BiquadQ15_Coeffs)
+//Returns QA_OK if successful, or QA_Fail if the cascade is full
+QA_Result QAT_Filter_BiquadQ15::addStage(const QAT_Filter_BiquadQ15_Coeffs& sCoeffs) {
+	if (m_uStages >= QAT_FILTER_MAXSTAGES)
+		return QA_Fail;
+
+	//Feedback coefficients are negated so that all terms are accumulated, saturating -(-32768)
+	int32_t iA1 = (sCoeffs.iA1 == INT16_MIN) ? INT16_MAX : -sCoeffs.iA1;
+	int32_t iA2 = (sCoeffs.iA2 == INT16_MIN) ? INT16_MAX : -sCoeffs.iA2;
+
+	Stage& sStage = m_sStages[m_uStages];
+	sStage.uB0B1  = ((uint32_t)(uint16_t)sCoeffs.iB0) | ((uint32_t)(uint16_t)sCoeffs.iB1 << 16);
+	sStage.uB2A1  = ((uint32_t)(uint16_t)sCoeffs.iB2) | ((uint32_t)(uint16_t)iA1 << 16);
+	sStage.iA2    = (int16_t)iA2;
+	sStage.iX1    = 0;
+	sStage.iX2    = 0;
+	sStage.iY1    = 0;
+	sStage.iY2    = 0;
+	m_uStages++;
+	return QA_OK;
+}
+
+
+//QAT_Filter_BiquadQ15::process
+//QAT_Filter_BiquadQ15 Method
+//
+//Filters a number of samples through each stage of the cascade. See QAT_Filter::process()
+//Inputs x[n], x[n-1] and x[n-2], y[n-1] are packed into halfword pairs to match the packed coefficients, so b0x[n] + b1x[n-1]
+//and b2x[n-2] - a1y[n-1] are each calculated by a single SMUAD/SMLAD
+uint32_t QAT_Filter_BiquadQ15::process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) {
+	int32_t iRound = (1L << (m_uShift - 1));
+
+	for (uint32_t i=0; i<uSamples; i++) {
+		int32_t iSample = (int16_t)*pInput;
+		pInput += uStride;
+
+		for (uint8_t j=0; j<m_uStages; j++) {
+			Stage& sStage = m_sStages[j];
+
+			int32_t iAcc = (int32_t)__SMUAD(sStage.uB0B1, __PKHBT((uint32_t)iSample, (uint32_t)sStage.iX1, 16));
+			iAcc = (int32_t)__SMLAD(sStage.uB2A1, __PKHBT((uint32_t)sStage.iX2, (uint32_t)sStage.iY1, 16), (uint32_t)iAcc);
+			iAcc += (int32_t)sStage.iA2 * sStage.iY2;
+
+			int32_t iOut = __SSAT((iAcc + iRound) >> m_uShift, 16);
+			sStage.iX2 = sStage.iX1;
+			sStage.iX1 = (int16_t)iSample;
+			sStage.iY2 = sStage.iY1;
+			sStage.iY1 = (int16_t)iOut;
+			iSample    = iOut;
+		}
+		*pOutput++ = (int16_t)iSample;
+	}
+	return uSamples;
+}
+
+
+//QAT_Filter_BiquadQ15::reset
+//QAT_Filter_BiquadQ15 Method
+void QAT_Filter_BiquadQ15::reset(void) {
+	for (uint8_t i=0; i<m_uStages; i++) {
+		m_sStages[i].iX1 = 0;
+		m_sStages[i].iX2 = 0;
+		m_sStages[i].iY1 = 0;
+		m_sStages[i].iY2 = 0;
+	}
+}
+
+
+  //--------------------------------
+  //--------------------------------
+  //QAT_Filter_BiquadQ31 Methods
+
+//QAT_Filter_BiquadQ31::addStage
+//QAT_Filter_BiquadQ31 Method
+//
+//Adds a stage to the end of the cascade
+//sCoeffs - Stage coefficients (see QAT_Filter_BiquadQ31_Coeffs)
+//Returns QA_OK if successful, or QA_Fail if the cascade is full
+QA_Result QAT_Filter_BiquadQ31::addStage(const QAT_Filter_BiquadQ31_Coeffs& sCoeffs) {
+	if (m_uStages >= QAT_FILTER_MAXSTAGES)
+		return QA_Fail;
+
+	Stage& sStage = m_sStages[m_uStages];
+	sStage.iB0    = sCoeffs.iB0;
+	sStage.iB1    = sCoeffs.iB1;
+	sStage.iB2    = sCoeffs.iB2;
+	sStage.iA1    = (sCoeffs.iA1 == INT32_MIN) ? INT32_MAX : -sCoeffs.iA1;
+	sStage.iA2    = (sCoeffs.iA2 == INT32_MIN) ? INT32_MAX : -sCoeffs.iA2;
+	sStage.iX1    = 0;
+	sStage.iX2    = 0;
+	sStage.iY1    = 0;
+	sStage.iY2    = 0;
+	m_uStages++;
+	return QA_OK;
+}
+
+
+//QAT_Filter_BiquadQ31::process
+//QAT_Filter_BiquadQ31 Method
+//
+//Filters a number of samples through each stage of the cascade. See QAT_Filter::process()
+//Input samples are scaled from Q15 to Q31, and each stage output is saturated to 32bits before being passed to the next stage
+uint32_t QAT_Filter_BiquadQ31::process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) {
+	int64_t iRound = (1LL << (m_uShift - 1));
+
+	for (uint32_t i=0; i<uSamples; i++) {
+		int32_t iSample = (int32_t)((uint32_t)*pInput << 16);
+		pInput += uStride;
+
+		for (uint8_t j=0; j<m_uStages; j++) {
+			Stage& sStage = m_sStages[j];
+
+			int64_t iAcc = (int64_t)sStage.iB0 * iSample;
+			iAcc += (int64_t)sStage.iB1 * sStage.iX1;
+			iAcc += (int64_t)sStage.iB2 * sStage.iX2;
+			iAcc += (int64_t)sStage.iA1 * sStage.iY1;
+			iAcc += (int64_t)sStage.iA2 * sStage.iY2;
+
+			iAcc = (iAcc + iRound) >> m_uShift;
+			int32_t iOut = (iAcc > INT32_MAX) ? INT32_MAX : ((iAcc < INT32_MIN) ? INT32_MIN : (int32_t)iAcc);
+			sStage.iX2 = sStage.iX1;
+			sStage.iX1 = iSample;
+			sStage.iY2 = sStage.iY1;
+			sStage.iY1 = iOut;
+			iSample    = iOut;
+		}
+		*pOutput++ = (int16_t)__SSAT(((iSample >> 15) + 1) >> 1, 16);
+	}
+	return uSamples;
+}
+
+
+//QAT_Filter_BiquadQ31::reset
+//QAT_Filter_BiquadQ31 Method
+void QAT_Filter_BiquadQ31::reset(void) {
+	for (uint8_t i=0; i<m_uStages; i++) {
+		m_sStages[i].iX1 = 0;
+		m_sStages[i].iX2 = 0;
+		m_sStages[i].iY1 = 0;
+		m_sStages[i].iY2 = 0;
+	}
+}
+
+
+  //--------------------------
+  //--------------------------
+  //QAT_Filter_FIR Methods
+
+//QAT_Filter_FIR::setCoefficients
+//QAT_Filter_FIR Method
+//
+//Sets the filter coefficients, clearing the delay line
+//pCoeffs - Coefficients (Q15), with pCoeffs[0] applied to the most recent sample
+//uTaps   - Number of coefficients (1 to QAT_FILTER_MAXTAPS)
+//Returns QA_OK if successful, or QA_Fail if the number of taps is invalid
+QA_Result QAT_Filter_FIR::setCoefficients(const int16_t* pCoeffs, uint8_t uTaps) {
+	if ((!uTaps) || (uTaps > QAT_FILTER_MAXTAPS))
+		return QA_Fail;
+
+	//Coefficients are stored in reverse order to match the delay line (oldest sample first), and an odd number of taps is
+	//padded with a zero coefficient for the oldest sample
+	m_uTaps = (uTaps + 1) & ~0x01;
+	for (uint8_t i=0; i<m_uTaps; i++)
+		m_iCoeffs[m_uTaps - 1 - i] = (i < uTaps) ? pCoeffs[i] : 0;
+
+	reset();
+	return QA_OK;
+}
+
+
+//QAT_Filter_FIR::process
+//QAT_Filter_FIR Method
+//
+//Filters a number of samples, producing an output for every m_uDecimation samples. See QAT_Filter::process()
+uint32_t QAT_Filter_FIR::process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) {
+	if (!m_uTaps)
+		return 0;
+
+	uint32_t uOutputs = 0;
+	for (uint32_t i=0; i<uSamples; i++) {
+
+		//Add sample to both copies of the delay line
+		int16_t iSample = (int16_t)*pInput;
+		pInput += uStride;
+		m_iDelay[m_uIdx]           = iSample;
+		m_iDelay[m_uIdx + m_uTaps] = iSample;
+		if (++m_uIdx >= m_uTaps)
+			m_uIdx = 0;
+
+		//Only calculate outputs that are kept after decimation
+		if (++m_uPhase < m_uDecimation)
+			continue;
+		m_uPhase = 0;
+
+		//The most recent m_uTaps samples are contiguous from m_uIdx, oldest first
+		const int16_t* pWindow = &m_iDelay[m_uIdx];
+		int32_t        iAcc    = 0;
+		for (uint8_t j=0; j<m_uTaps; j+=2) {
+			uint32_t uSamples2;
+			uint32_t uCoeffs2;
+			memcpy(&uSamples2, &pWindow[j], sizeof(uint32_t));
+			memcpy(&uCoeffs2, &m_iCoeffs[j], sizeof(uint32_t));
+			iAcc = (int32_t)__SMLAD(uSamples2, uCoeffs2, (uint32_t)iAcc);
+		}
+		*pOutput++ = (int16_t)__SSAT((iAcc + 0x4000) >> 15, 16);
+		uOutputs++;
+	}
+	return uOutputs;
+}
+
+
+//QAT_Filter_FIR::reset
+//QAT_Filter_FIR Method
+void QAT_Filter_FIR::reset(void) {
+	for (uint8_t i=0; i<(m_uTaps * 2); i++)
+		m_iDelay[i] = 0;
+	m_uIdx   = 0;
+	m_uPhase = 0;
+}
+
+
+  //-----------------------------
+  //-----------------------------
+  //QAT_Filter_Median Methods
+
+//QAT_Filter_Median::process
+//QAT_Filter_Median Method
+//
+//Filters a number of samples. See QAT_Filter::process()
+//The window is filled with the first sample received, so outputs are valid immediately
+//For each sample, the oldest sample's entry in the sorted window is replaced with the new sample, which is then moved into place
+uint32_t QAT_Filter_Median::process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) {
+	for (uint32_t i=0; i<uSamples; i++) {
+		int16_t iSample = (int16_t)*pInput;
+		pInput += uStride;
+
+		if (!m_bPrimed) {
+			for (uint8_t j=0; j<m_uSize; j++) {
+				m_iWindow[j] = iSample;
+				m_iSorted[j] = iSample;
+			}
+			m_bPrimed = true;
+		} else {
+
+			//Replace oldest sample
+			int16_t iOldest = m_iWindow[m_uIdx];
+			m_iWindow[m_uIdx] = iSample;
+			if (++m_uIdx >= m_uSize)
+				m_uIdx = 0;
+
+			uint8_t uPos = 0;
+			while (m_iSorted[uPos] != iOldest)
+				uPos++;
+
+			//Move new sample into place
+			while ((uPos > 0) && (m_iSorted[uPos - 1] > iSample)) {
+				m_iSorted[uPos] = m_iSorted[uPos - 1];
+				uPos--;
+			}
+			while ((uPos < (m_uSize - 1)) && (m_iSorted[uPos + 1] < iSample)) {
+				m_iSorted[uPos] = m_iSorted[uPos + 1];
+				uPos++;
+			}
+			m_iSorted[uPos] = iSample;
+		}
+
+		*pOutput++ = m_iSorted[m_uSize >> 1];
+	}
+	return uSamples;
+}
+
+
+//QAT_Filter_Median::reset
+//QAT_Filter_Median Method
+void QAT_Filter_Median::reset(void) {
+	m_uIdx    = 0;
+	m_bPrimed = false;
+}
+
+
+  //--------------------------
+  //--------------------------
+  //QAT_Filter_EMA Methods
+
+//QAT_Filter_EMA::process
+//QAT_Filter_EMA Method
+//
+//Filters a number of samples. See QAT_Filter::process()
+//The filter is initialized to the first sample received, to avoid a long settling time from zero
+uint32_t QAT_Filter_EMA::process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) {
+	for (uint32_t i=0; i<uSamples; i++) {
+		int32_t iSample = (int32_t)*pInput << 16;
+		pInput += uStride;
+
+		if (!m_bPrimed) {
+			m_iState  = iSample;
+			m_bPrimed = true;
+		} else {
+			m_iState += (int32_t)(((int64_t)(iSample - m_iState) * m_iAlpha) >> 15);
+		}
+		*pOutput++ = (int16_t)__SSAT((m_iState + 0x8000) >> 16, 16);
+	}
+	return uSamples;
+}
+
+
+//QAT_Filter_EMA::reset
+//QAT_Filter_EMA Method
+void QAT_Filter_EMA::reset(void) {
+	m_iState  = 0;
+	m_bPrimed = false;
+}
+
+
+  //---------------------------
+  //---------------------------
+  //QAT_Filter_Bank Methods
+
+//QAT_Filter_Bank::setCallback
+//QAT_Filter_Bank Method
+//
+//Sets a function to be called for each output produced, from within process()
+//pCallback - Function to be called, or NULL to disable
+//pData     - Data to be passed to pCallback
+void QAT_Filter_Bank::setCallback(QAT_Filter_Callback pCallback, void* pData) {
+	m_pCallback     = pCallback;
+	m_pCallbackData = pData;
+}
+
+
+//QAT_Filter_Bank::reset
+//QAT_Filter_Bank Method
+//
+//Resets the filter of each channel, such as after a gap in the input data
+void QAT_Filter_Bank::reset(void) {
+	for (uint8_t i=0; i<m_uChannels; i++) {
+		if (m_pFilters[i])
+			m_pFilters[i]->reset();
+	}
+}
+
+
+//QAT_Filter_Bank::process
+//QAT_Filter_Bank Method
+//
+//Processes a block of interleaved samples, filtering each channel QAT_FILTER_CHUNK samples at a time
+//pData  - Pointer to samples, where sample for channel c of scan s is pData[(s * channels) + c]
+//uScans - Number of scans in the block
+void QAT_Filter_Bank::process(const uint16_t* pData, uint32_t uScans) {
+	int16_t iOutput[QAT_FILTER_CHUNK];
+
+	for (uint8_t i=0; i<m_uChannels; i++) {
+		QAT_Filter* pFilter = m_pFilters[i];
+		if (!pFilter)
+			continue;
+
+		const uint16_t* pInput     = pData + i;
+		uint32_t        uRemaining = uScans;
+		while (uRemaining) {
+			uint32_t uLen     = (uRemaining > QAT_FILTER_CHUNK) ? QAT_FILTER_CHUNK : uRemaining;
+			uint32_t uOutputs = pFilter->process(pInput, uLen, m_uChannels, iOutput);
+
+			if (uOutputs) {
+				m_iOutput[i]       = iOutput[uOutputs - 1];
+				m_uOutputCount[i] += uOutputs;
+				if (m_pCallback) {
+					for (uint32_t j=0; j<uOutputs; j++)
+						m_pCallback(i, iOutput[j], m_pCallbackData);
+				}
+			}
+
+			pInput     += (uLen * m_uChannels);
+			uRemaining -= uLen;
+		}
+	}
+}
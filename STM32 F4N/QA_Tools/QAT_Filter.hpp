@@ -0,0 +1,418 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tools                                                         */
+/*   Role: Fixed Point Digital Filters                                     */
+/*   Filename: QAT_Filter.hpp                                              */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAT_FILTER_HPP_
+#define __QAT_FILTER_HPP_
+
+//Includes
+#include "setup.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//NOTE: Filters take unsigned 12bit samples (such as those produced by QAD_ADC), treated as positive Q15 values, and produce
+//signed 16bit results which are saturated with SSAT. Input samples are read with a stride, so a single channel can be filtered
+//directly from a block of interleaved samples. QAT_Filter_Bank attaches a filter to each channel of such blocks, and is intended
+//to be called from a QAD_ADC block callback
+
+
+//----------------------
+//QAT_FILTER_MAXCHANNELS
+//
+//Maximum number of interleaved channels supported by QAT_Filter_Bank
+#define QAT_FILTER_MAXCHANNELS  16
+
+//--------------------
+//QAT_FILTER_MAXSTAGES
+//
+//Maximum number of second order stages in a biquad cascade
+#define QAT_FILTER_MAXSTAGES    4
+
+//------------------
+//QAT_FILTER_MAXTAPS
+//
+//Maximum number of FIR filter taps
+#define QAT_FILTER_MAXTAPS      64
+
+//--------------------
+//QAT_FILTER_MAXMEDIAN
+//
+//Maximum median filter window size
+#define QAT_FILTER_MAXMEDIAN    15
+
+//------------------
+//QAT_FILTER_CHUNK
+//
+//Number of samples filtered at a time by QAT_Filter_Bank
+#define QAT_FILTER_CHUNK        32
+
+
+//---------------------------
+//QAT_Filter_BiquadQ15_Coeffs
+//
+//Coefficients for a single biquad stage, with transfer function H(z) = (b0 + b1z^-1 + b2z^-2) / (1 + a1z^-1 + a2z^-2)
+//Coefficients are fixed point with (15 - uPostShift) fractional bits, where uPostShift is passed to the filter's constructor,
+//allowing coefficient magnitudes of up to 2^uPostShift
+typedef struct {
+
+	int16_t iB0;
+	int16_t iB1;
+	int16_t iB2;
+	int16_t iA1;
+	int16_t iA2;
+
+} QAT_Filter_BiquadQ15_Coeffs;
+
+
+//---------------------------
+//QAT_Filter_BiquadQ31_Coeffs
+//
+//As QAT_Filter_BiquadQ15_Coeffs, with coefficients having (31 - uPostShift) fractional bits
+typedef struct {
+
+	int32_t iB0;
+	int32_t iB1;
+	int32_t iB2;
+	int32_t iA1;
+	int32_t iA2;
+
+} QAT_Filter_BiquadQ31_Coeffs;
+
+
+//-------------------
+//QAT_Filter_Callback
+//
+//Function to be called by QAT_Filter_Bank for each filter output produced
+//uChannel - Channel index
+//iValue   - Filter output
+typedef void (*QAT_Filter_Callback)(uint8_t uChannel, int16_t iValue, void* pData);
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//----------
+//QAT_Filter
+//
+//Base class for all filters
+class QAT_Filter {
+public:
+
+	virtual ~QAT_Filter() {}
+
+	//Filters a number of samples
+	//pInput   - Pointer to first input sample
+	//uSamples - Number of input samples
+	//uStride  - Distance between input samples (the number of interleaved channels, or 1 for a single channel)
+	//pOutput  - Output array, which must have space for uSamples outputs
+	//Returns the number of outputs produced, which is less than uSamples for decimating filters
+	virtual uint32_t process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) = 0;
+
+	//Clears the filter's state
+	virtual void reset(void) = 0;
+};
+
+
+//--------------------
+//QAT_Filter_BiquadQ15
+//
+//Cascade of up to QAT_FILTER_MAXSTAGES Direct Form I biquad stages, with Q15 coefficients and 16bit state
+//Each stage takes two SMLAD dual multiply-accumulates plus one single multiply-accumulate per sample, with its output saturated
+//to 16bits. Intermediate sums are 32bit, so stage gains must keep outputs well within range for 12bit input samples
+class QAT_Filter_BiquadQ15 : public QAT_Filter {
+private:
+
+	//Stage data
+	typedef struct {
+		uint32_t uB0B1;   //b0 (low halfword) and b1 (high halfword)
+		uint32_t uB2A1;   //b2 (low halfword) and -a1 (high halfword)
+		int16_t  iA2;     //-a2
+		int16_t  iX1;     //Previous inputs
+		int16_t  iX2;
+		int16_t  iY1;     //Previous outputs
+		int16_t  iY2;
+	} Stage;
+
+	Stage   m_sStages[QAT_FILTER_MAXSTAGES];
+	uint8_t m_uStages;
+	uint8_t m_uShift;   //Shift from accumulator to stage output (15 - uPostShift)
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Filter_BiquadQ15() = delete;        //Delete the default class constructor, as the coefficient scaling is required
+
+	//uPostShift - Number of integer bits in coefficients (0 to 14). Typically 1, as a1 is commonly between -2 and 2
+	QAT_Filter_BiquadQ15(uint8_t uPostShift) :
+		m_uStages(0),
+		m_uShift(15 - ((uPostShift > 14) ? 14 : uPostShift)) {}
+
+
+	//NOTE: See QAT_Filter.cpp for details of the following methods
+
+	QA_Result addStage(const QAT_Filter_BiquadQ15_Coeffs& sCoeffs);
+	uint32_t process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) override;
+	void reset(void) override;
+
+};
+
+
+//--------------------
+//QAT_Filter_BiquadQ31
+//
+//Cascade of up to QAT_FILTER_MAXSTAGES Direct Form I biquad stages, with Q31 coefficients and 32bit state
+//Each stage accumulates into 64bits using SMLAL, giving lower noise than QAT_Filter_BiquadQ15 for filters with low cutoff
+//frequencies relative to the sample rate, where feedback coefficients are close to their limits
+class QAT_Filter_BiquadQ31 : public QAT_Filter {
+private:
+
+	//Stage data
+	typedef struct {
+		int32_t iB0;
+		int32_t iB1;
+		int32_t iB2;
+		int32_t iA1;      //-a1
+		int32_t iA2;      //-a2
+		int32_t iX1;      //Previous inputs
+		int32_t iX2;
+		int32_t iY1;      //Previous outputs
+		int32_t iY2;
+	} Stage;
+
+	Stage   m_sStages[QAT_FILTER_MAXSTAGES];
+	uint8_t m_uStages;
+	uint8_t m_uShift;   //Shift from accumulator to stage output (31 - uPostShift)
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Filter_BiquadQ31() = delete;        //Delete the default class constructor, as the coefficient scaling is required
+
+	//uPostShift - Number of integer bits in coefficients (0 to 30). Typically 1, as a1 is commonly between -2 and 2
+	QAT_Filter_BiquadQ31(uint8_t uPostShift) :
+		m_uStages(0),
+		m_uShift(31 - ((uPostShift > 30) ? 30 : uPostShift)) {}
+
+
+	//NOTE: See QAT_Filter.cpp for details of the following methods
+
+	QA_Result addStage(const QAT_Filter_BiquadQ31_Coeffs& sCoeffs);
+	uint32_t process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) override;
+	void reset(void) override;
+
+};
+
+
+//--------------
+//QAT_Filter_FIR
+//
+//Decimating FIR filter with Q15 coefficients. An output is produced for every uDecimation input samples, and only those outputs
+//are calculated. The delay line is stored twice over so the most recent samples are always contiguous, allowing the dot product
+//to be calculated two taps at a time with SMLAD
+class QAT_Filter_FIR : public QAT_Filter {
+private:
+
+	int16_t  m_iCoeffs[QAT_FILTER_MAXTAPS];      //Coefficients in reverse order, padded to an even number of taps
+	int16_t  m_iDelay[QAT_FILTER_MAXTAPS * 2];   //Delay line, with each sample stored at index and index + taps
+	uint8_t  m_uTaps;                            //Number of taps (even)
+	uint8_t  m_uIdx;                             //Index of oldest sample in delay line
+	uint8_t  m_uDecimation;                      //Decimation factor
+	uint8_t  m_uPhase;                           //Input samples since last output
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Filter_FIR() = delete;              //Delete the default class constructor, as the decimation factor is required
+
+	//uDecimation - Decimation factor. Set to 1 for no decimation
+	QAT_Filter_FIR(uint8_t uDecimation) :
+		m_uTaps(0),
+		m_uIdx(0),
+		m_uDecimation((uDecimation) ? uDecimation : 1),
+		m_uPhase(0) {}
+
+
+	//NOTE: See QAT_Filter.cpp for details of the following methods
+
+	QA_Result setCoefficients(const int16_t* pCoeffs, uint8_t uTaps);
+	uint32_t process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) override;
+	void reset(void) override;
+
+};
+
+
+//-----------------
+//QAT_Filter_Median
+//
+//Sliding median filter over an odd number of samples, which removes impulse noise without smoothing edges
+//A sorted copy of the window is maintained, so each sample takes a single insertion rather than a full sort
+class QAT_Filter_Median : public QAT_Filter {
+private:
+
+	int16_t m_iWindow[QAT_FILTER_MAXMEDIAN];     //Samples in order received (circular)
+	int16_t m_iSorted[QAT_FILTER_MAXMEDIAN];     //Samples in ascending order
+	uint8_t m_uSize;                             //Window size
+	uint8_t m_uIdx;                              //Index of oldest sample in m_iWindow
+	bool    m_bPrimed;                           //Set to true once the window has been filled
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Filter_Median() = delete;           //Delete the default class constructor, as the window size is required
+
+	//uSize - Window size. Must be odd, and will be limited to QAT_FILTER_MAXMEDIAN
+	QAT_Filter_Median(uint8_t uSize) :
+		m_uSize(((uSize > QAT_FILTER_MAXMEDIAN) ? QAT_FILTER_MAXMEDIAN : ((uSize) ? uSize : 1)) | 0x01),
+		m_uIdx(0),
+		m_bPrimed(false) {}
+
+
+	//NOTE: See QAT_Filter.cpp for details of the following methods
+
+	uint32_t process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) override;
+	void reset(void) override;
+
+};
+
+
+//--------------
+//QAT_Filter_EMA
+//
+//Exponential moving average (single pole IIR low pass), y[n] = y[n-1] + alpha * (x[n] - y[n-1])
+//State is held with 16 fractional bits, so small values of alpha settle exactly rather than stalling short of the input
+class QAT_Filter_EMA : public QAT_Filter {
+private:
+
+	int32_t  m_iState;     //Filter output with 16 fractional bits
+	int32_t  m_iAlpha;     //Alpha (Q15)
+	bool     m_bPrimed;    //Set to true once the first sample has been received
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Filter_EMA() = delete;              //Delete the default class constructor, as alpha is required
+
+	//iAlpha - Smoothing factor (Q15, 1 to 32767). The time constant is approximately 32768 / iAlpha samples
+	QAT_Filter_EMA(int16_t iAlpha) :
+		m_iState(0),
+		m_iAlpha((iAlpha < 1) ? 1 : iAlpha),
+		m_bPrimed(false) {}
+
+
+	//NOTE: See QAT_Filter.cpp for details of the following methods
+
+	uint32_t process(const uint16_t* pInput, uint32_t uSamples, uint8_t uStride, int16_t* pOutput) override;
+	void reset(void) override;
+
+};
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//---------------
+//QAT_Filter_Bank
+//
+//Applies a filter to each channel of blocks of interleaved samples, such as those produced by QAD_ADC in block data mode
+//Outputs can be read with getOutput(), or passed to a callback as produced
+class QAT_Filter_Bank {
+private:
+
+	uint8_t                m_uChannels;
+	QAT_Filter*            m_pFilters[QAT_FILTER_MAXCHANNELS];     //Filter for each channel, or NULL if channel is not filtered
+	volatile int16_t       m_iOutput[QAT_FILTER_MAXCHANNELS];      //Most recent output of each channel
+	volatile uint32_t      m_uOutputCount[QAT_FILTER_MAXCHANNELS]; //Number of outputs produced by each channel
+
+	QAT_Filter_Callback    m_pCallback;        //Function to be called for each output, or NULL
+	void*                  m_pCallbackData;    //Data to be passed to m_pCallback
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Filter_Bank() = delete;             //Delete the default class constructor, as the channel count is required
+
+	//uChannels - Number of interleaved channels in the data to be processed (1 to 16)
+	QAT_Filter_Bank(uint8_t uChannels) :
+		m_uChannels((uChannels > QAT_FILTER_MAXCHANNELS) ? QAT_FILTER_MAXCHANNELS : uChannels),
+		m_pCallback(NULL),
+		m_pCallbackData(NULL) {
+
+		for (uint8_t i=0; i<QAT_FILTER_MAXCHANNELS; i++) {
+			m_pFilters[i]     = NULL;
+			m_iOutput[i]      = 0;
+			m_uOutputCount[i] = 0;
+		}
+	}
+
+
+	//NOTE: See QAT_Filter.cpp for details of the following methods
+
+	//---------------------
+	//Configuration Methods
+
+	//Sets the filter for a channel. The filter is not owned by the bank. Set pFilter to NULL to stop filtering a channel
+	void setFilter(uint8_t uChannel, QAT_Filter* pFilter) {
+		if (uChannel < m_uChannels)
+			m_pFilters[uChannel] = pFilter;
+	}
+
+	void setCallback(QAT_Filter_Callback pCallback, void* pData);
+	void reset(void);
+
+
+	//------------------
+	//Processing Methods
+
+	void process(const uint16_t* pData, uint32_t uScans);
+
+
+	//------------
+	//Data Methods
+
+	//Returns the most recent output for a channel
+	int16_t getOutput(uint8_t uChannel) {
+		return (uChannel < m_uChannels) ? m_iOutput[uChannel] : 0;
+	}
+
+	//Returns the number of outputs produced by a channel, which can be used to detect new outputs
+	uint32_t getOutputCount(uint8_t uChannel) {
+		return (uChannel < m_uChannels) ? m_uOutputCount[uChannel] : 0;
+	}
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAT_FILTER_HPP_ */
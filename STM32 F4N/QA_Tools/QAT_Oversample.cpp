@@ -0,0 +1,231 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tools                                                         */
+/*   Role: Oversampling and Decimation                                     */
+/*   Filename: QAT_Oversample.cpp                                          */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAT_Oversample.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+  //------------------------------------
+  //------------------------------------
+  //QAT_Oversample Configuration Methods
+
+//QAT_Oversample::setChannel
+//QAT_Oversample Configuration Method
+//
+//Configures and enables a channel, clearing any partially accumulated output
+//uChannel - Channel index
+//sConfig  - Channel configuration (see QAT_Oversample_ChannelConfig)
+//Returns QA_OK if successful, or QA_Fail if the channel index or configuration is invalid
+QA_Result QAT_Oversample::setChannel(uint8_t uChannel, QAT_Oversample_ChannelConfig& sConfig) {
+	if (uChannel >= m_uChannels)
+		return QA_Fail;
+
+	uint8_t uSampleShift = (sConfig.uExtraBits * 2) + sConfig.uAverageShift;
+	if ((sConfig.uExtraBits > QAT_OVERSAMPLE_MAXEXTRABITS) || (uSampleShift > QAT_OVERSAMPLE_MAXSAMPLESHIFT))
+		return QA_Fail;
+
+	Channel& sChannel     = m_sChannels[uChannel];
+	sChannel.bEnabled     = false;
+	sChannel.uSampleShift = uSampleShift;
+	sChannel.uOutputShift = sConfig.uExtraBits + sConfig.uAverageShift;
+	sChannel.eRounding    = sConfig.eRounding;
+	sChannel.uAcc         = 0;
+	sChannel.uCount       = 0;
+	sChannel.bEnabled     = true;
+	return QA_OK;
+}
+
+
+//QAT_Oversample::disableChannel
+//QAT_Oversample Configuration Method
+//
+//Disables a channel, so it no longer produces outputs
+//uChannel - Channel index
+void QAT_Oversample::disableChannel(uint8_t uChannel) {
+	if (uChannel < m_uChannels)
+		m_sChannels[uChannel].bEnabled = false;
+}
+
+
+//QAT_Oversample::setCallback
+//QAT_Oversample Configuration Method
+//
+//Sets a function to be called for each output produced, from within process()
+//pCallback - Function to be called, or NULL to disable
+//pData     - Data to be passed to pCallback
+void QAT_Oversample::setCallback(QAT_Oversample_Callback pCallback, void* pData) {
+	m_pCallback     = pCallback;
+	m_pCallbackData = pData;
+}
+
+
+//QAT_Oversample::reset
+//QAT_Oversample Configuration Method
+//
+//Clears all partially accumulated outputs, such as after a gap in the input data
+void QAT_Oversample::reset(void) {
+	for (uint8_t i=0; i<m_uChannels; i++) {
+		m_sChannels[i].uAcc   = 0;
+		m_sChannels[i].uCount = 0;
+	}
+}
+
+
+  //---------------------------------
+  //---------------------------------
+  //QAT_Oversample Processing Methods
+
+//QAT_Oversample::process
+//QAT_Oversample Processing Method
+//
+//Processes a block of interleaved samples
+//The block is split into segments ending where a channel completes an output, with all channels accumulated over each segment
+//pData  - Pointer to samples, where sample for channel c of scan s is pData[(s * channels) + c]
+//uScans - Number of scans in the block
+void QAT_Oversample::process(const uint16_t* pData, uint32_t uScans) {
+	while (uScans) {
+
+		//Find length of segment
+		uint32_t uLen = uScans;
+		for (uint8_t i=0; i<m_uChannels; i++) {
+			if (m_sChannels[i].bEnabled) {
+				uint32_t uRemaining = (1UL << m_sChannels[i].uSampleShift) - m_sChannels[i].uCount;
+				if (uRemaining < uLen)
+					uLen = uRemaining;
+			}
+		}
+
+		//Accumulate segment
+		accumulate(pData, uLen);
+
+		//Produce outputs for channels that have completed
+		for (uint8_t i=0; i<m_uChannels; i++) {
+			Channel& sChannel = m_sChannels[i];
+			if (sChannel.bEnabled) {
+				sChannel.uCount += uLen;
+				if (sChannel.uCount >= (1UL << sChannel.uSampleShift))
+					output(i);
+			} else {
+				sChannel.uAcc = 0;
+			}
+		}
+
+		pData  += (uLen * m_uChannels);
+		uScans -= uLen;
+	}
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAT_Oversample Tools Methods
+
+//QAT_Oversample::accumulate
+//QAT_Oversample Tools Method
+//
+//Adds a number of scans to each channel's accumulator
+//pData  - Pointer to first sample of first scan
+//uScans - Number of scans
+void QAT_Oversample::accumulate(const uint16_t* pData, uint32_t uScans) {
+
+	//Single channel - sum two samples per instruction with SMLAD (multiplying each halfword by 1)
+	if (m_uChannels == 1) {
+		uint32_t uAcc = 0;
+		if ((uScans) && ((uintptr_t)pData & 0x02)) {
+			uAcc += *pData++;
+			uScans--;
+		}
+		const uint32_t* pWord = (const uint32_t*)pData;
+		for (; uScans >= 2; uScans -= 2)
+			uAcc = __SMLAD(*pWord++, 0x00010001, uAcc);
+		if (uScans)
+			uAcc += *(const uint16_t*)pWord;
+		m_sChannels[0].uAcc += uAcc;
+		return;
+	}
+
+	//Even channel count - each 32bit word holds the same pair of channels in every scan, so pairs are summed in 16bit lanes with
+	//UADD16. 16 scans of 12bit samples fit within 16bits, after which the lanes are widened into the 32bit accumulators
+	if ((!(m_uChannels & 0x01)) && (!((uintptr_t)pData & 0x03))) {
+		const uint32_t* pWord  = (const uint32_t*)pData;
+		uint8_t         uWords = m_uChannels >> 1;
+
+		while (uScans) {
+			uint32_t uChunk = (uScans > 16) ? 16 : uScans;
+			uint32_t uLanes[QAT_OVERSAMPLE_MAXCHANNELS >> 1] = {0};
+
+			for (uint32_t i=0; i<uChunk; i++) {
+				for (uint8_t j=0; j<uWords; j++)
+					uLanes[j] = __UADD16(uLanes[j], *pWord++);
+			}
+
+			for (uint8_t j=0; j<uWords; j++) {
+				m_sChannels[j << 1].uAcc       += (uLanes[j] & 0xFFFF);
+				m_sChannels[(j << 1) + 1].uAcc += (uLanes[j] >> 16);
+			}
+			uScans -= uChunk;
+		}
+		return;
+	}
+
+	//Odd channel count (or unaligned data)
+	for (uint32_t i=0; i<uScans; i++) {
+		for (uint8_t j=0; j<m_uChannels; j++)
+			m_sChannels[j].uAcc += *pData++;
+	}
+}
+
+
+//QAT_Oversample::output
+//QAT_Oversample Tools Method
+//
+//Produces an output from a channel's accumulator, applying the channel's rounding mode
+//uChannel - Channel index
+void QAT_Oversample::output(uint8_t uChannel) {
+	Channel& sChannel = m_sChannels[uChannel];
+	uint32_t uAcc     = sChannel.uAcc;
+
+	if (sChannel.uOutputShift) {
+		switch (sChannel.eRounding) {
+			case QAT_Oversample_Rounding_Nearest:
+				uAcc += (1UL << (sChannel.uOutputShift - 1));
+				break;
+			case QAT_Oversample_Rounding_Dither:
+				//Xorshift32 pseudo-random generator
+				m_uDither ^= (m_uDither << 13);
+				m_uDither ^= (m_uDither >> 17);
+				m_uDither ^= (m_uDither << 5);
+				uAcc += (m_uDither & ((1UL << sChannel.uOutputShift) - 1));
+				break;
+			default:
+				break;
+		}
+	}
+
+	uint16_t uValue = (uint16_t)(uAcc >> sChannel.uOutputShift);
+	sChannel.uOutput = uValue;
+	sChannel.uOutputCount++;
+	sChannel.uAcc    = 0;
+	sChannel.uCount  = 0;
+
+	if (m_pCallback)
+		m_pCallback(uChannel, uValue, m_pCallbackData);
+}
@@ -0,0 +1,190 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tools                                                         */
+/*   Role: Oversampling and Decimation                                     */
+/*   Filename: QAT_Oversample.hpp                                          */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAT_OVERSAMPLE_HPP_
+#define __QAT_OVERSAMPLE_HPP_
+
+//Includes
+#include "setup.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+
+//---------------------------
+//QAT_OVERSAMPLE_MAXCHANNELS
+//
+//Maximum number of interleaved channels supported
+#define QAT_OVERSAMPLE_MAXCHANNELS   16
+
+//--------------------------
+//QAT_OVERSAMPLE_MAXEXTRABITS
+//
+//Maximum number of additional bits of resolution (giving 16bit results from 12bit samples)
+#define QAT_OVERSAMPLE_MAXEXTRABITS  4
+
+//---------------------------
+//QAT_OVERSAMPLE_MAXSAMPLESHIFT
+//
+//Maximum number of samples per output, as a power of 2. Limits accumulators of 12bit samples to 32bits
+#define QAT_OVERSAMPLE_MAXSAMPLESHIFT 20
+
+
+//-----------------------
+//QAT_Oversample_Rounding
+//
+//Rounding applied when the accumulated samples are shifted down to the output resolution
+enum QAT_Oversample_Rounding : uint8_t {
+	QAT_Oversample_Rounding_Truncate = 0, //Discarded bits are truncated
+	QAT_Oversample_Rounding_Nearest,      //Rounded to nearest
+	QAT_Oversample_Rounding_Dither        //A pseudo-random value is added below the output LSB before truncation, decorrelating the rounding
+	                                      //error from the signal. Note that oversampling only adds true resolution where the input has at least
+	                                      //one LSB of noise, which this does not replace
+};
+
+
+//---------------------------
+//QAT_Oversample_ChannelConfig
+//
+//Configuration for a single channel
+typedef struct {
+
+	uint8_t                 uExtraBits;     //Additional bits of resolution (0 to 4). 4^uExtraBits samples are summed and shifted right by uExtraBits,
+	                                        //giving a (12 + uExtraBits) bit result
+	uint8_t                 uAverageShift;  //Additional averaging as a power of 2, which reduces noise and output rate without changing
+	                                        //output resolution. Samples per output are 2^((2 * uExtraBits) + uAverageShift), up to 2^20
+	QAT_Oversample_Rounding eRounding;      //Rounding mode (member of QAT_Oversample_Rounding)
+
+} QAT_Oversample_ChannelConfig;
+
+
+//-----------------------
+//QAT_Oversample_Callback
+//
+//Function to be called for each output produced
+//uChannel - Channel index
+//uValue   - Output value, with (12 + uExtraBits) bits of resolution
+typedef void (*QAT_Oversample_Callback)(uint8_t uChannel, uint16_t uValue, void* pData);
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//--------------
+//QAT_Oversample
+//
+//Software oversampling and decimation for blocks of interleaved 12bit samples, such as those produced by QAD_ADC in block data mode
+//Each channel has its own resolution and output rate. Outputs can be read with getOutput(), or passed to a callback as produced
+//For single channel data, samples are summed two at a time using SMLAD. For even channel counts, pairs of channels are summed in
+//parallel in 16bit lanes using UADD16 (up to 16 scans at a time before widening into 32bit accumulators)
+//Blocks with an even channel count must be 32bit aligned
+class QAT_Oversample {
+private:
+
+	//Channel data
+	typedef struct {
+		bool                    bEnabled;      //Set to true if channel is producing outputs
+		uint8_t                 uSampleShift;  //Samples per output as power of 2
+		uint8_t                 uOutputShift;  //Shift from accumulated value to output
+		QAT_Oversample_Rounding eRounding;     //Rounding mode
+		uint32_t                uAcc;          //Accumulated samples
+		uint32_t                uCount;        //Number of samples accumulated
+		volatile uint16_t       uOutput;       //Most recent output
+		volatile uint32_t       uOutputCount;  //Number of outputs produced
+	} Channel;
+
+	uint8_t                 m_uChannels;
+	Channel                 m_sChannels[QAT_OVERSAMPLE_MAXCHANNELS];
+	uint32_t                m_uDither;          //Dither pseudo-random generator state
+
+	QAT_Oversample_Callback m_pCallback;        //Function to be called for each output, or NULL
+	void*                   m_pCallbackData;    //Data to be passed to m_pCallback
+
+public:
+
+	//--------------------------
+	//Constructors / Destructors
+
+	QAT_Oversample() = delete;           //Delete the default class constructor, as the channel count is required
+
+	//uChannels - Number of interleaved channels in the data to be processed (1 to 16)
+	QAT_Oversample(uint8_t uChannels) :
+		m_uChannels((uChannels > QAT_OVERSAMPLE_MAXCHANNELS) ? QAT_OVERSAMPLE_MAXCHANNELS : uChannels),
+		m_uDither(0x12345678),
+		m_pCallback(NULL),
+		m_pCallbackData(NULL) {
+
+		for (uint8_t i=0; i<QAT_OVERSAMPLE_MAXCHANNELS; i++) {
+			m_sChannels[i].bEnabled     = false;
+			m_sChannels[i].uSampleShift = 0;
+			m_sChannels[i].uOutputShift = 0;
+			m_sChannels[i].eRounding    = QAT_Oversample_Rounding_Truncate;
+			m_sChannels[i].uAcc         = 0;
+			m_sChannels[i].uCount       = 0;
+			m_sChannels[i].uOutput      = 0;
+			m_sChannels[i].uOutputCount = 0;
+		}
+	}
+
+
+	//NOTE: See QAT_Oversample.cpp for details of the following methods
+
+	//---------------------
+	//Configuration Methods
+
+	QA_Result setChannel(uint8_t uChannel, QAT_Oversample_ChannelConfig& sConfig);
+	void disableChannel(uint8_t uChannel);
+	void setCallback(QAT_Oversample_Callback pCallback, void* pData);
+	void reset(void);
+
+
+	//------------------
+	//Processing Methods
+
+	void process(const uint16_t* pData, uint32_t uScans);
+
+
+	//------------
+	//Data Methods
+
+	//Returns the most recent output for a channel
+	uint16_t getOutput(uint8_t uChannel) {
+		return (uChannel < m_uChannels) ? m_sChannels[uChannel].uOutput : 0;
+	}
+
+	//Returns the number of outputs produced by a channel, which can be used to detect new outputs
+	uint32_t getOutputCount(uint8_t uChannel) {
+		return (uChannel < m_uChannels) ? m_sChannels[uChannel].uOutputCount : 0;
+	}
+
+private:
+
+	//-------------
+	//Tools Methods
+
+	void accumulate(const uint16_t* pData, uint32_t uScans);
+	void output(uint8_t uChannel);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAT_OVERSAMPLE_HPP_ */
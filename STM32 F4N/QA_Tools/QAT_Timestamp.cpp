@@ -0,0 +1,53 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tools                                                         */
+/*   Role: Cycle Counter Timestamps                                        */
+/*   Filename: QAT_Timestamp.cpp                                           */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Includes
+#include "QAT_Timestamp.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+  //------------------------------------
+  //------------------------------------
+  //QAT_Timestamp Initialization Methods
+
+//QAT_Timestamp::init
+//QAT_Timestamp Initialization Method
+//
+//Enables the DWT cycle counter if it is not already running
+//This can safely be called multiple times, as the counter is not reset
+void QAT_Timestamp::init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+
+  //----------------------------
+  //----------------------------
+  //QAT_Timestamp Timing Methods
+
+//QAT_Timestamp::toMicros
+//QAT_Timestamp Timing Method
+//
+//Converts a number of timestamp ticks into microseconds
+//uTicks - The number of ticks, normally the difference between two timestamps
+//Returns the equivalent time in microseconds
+uint32_t QAT_Timestamp::toMicros(uint32_t uTicks) {
+	return (uint32_t)(((uint64_t)uTicks * 1000000) / SystemCoreClock);
+}
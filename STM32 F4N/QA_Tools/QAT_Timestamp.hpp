@@ -0,0 +1,66 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tools                                                         */
+/*   Role: Cycle Counter Timestamps                                        */
+/*   Filename: QAT_Timestamp.hpp                                           */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __QAT_TIMESTAMP_HPP_
+#define __QAT_TIMESTAMP_HPP_
+
+//Includes
+#include "setup.hpp"
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//-------------
+//QAT_Timestamp
+//
+//Provides CPU clock resolution timestamps using the DWT cycle counter of the Cortex-M4 core
+//Timestamps wrap every 2^32 CPU clock cycles (approximately 42.9 seconds at 100MHz), so intervals are to be measured by
+//unsigned subtraction of two timestamps, and must be less than this period
+class QAT_Timestamp {
+public:
+
+	//NOTE: See QAT_Timestamp.cpp for details of the following methods
+
+	//----------------------
+	//Initialization Methods
+
+	static void init(void);
+
+
+	//--------------
+	//Timing Methods
+
+	//Returns the current timestamp in CPU clock cycles
+	static uint32_t get(void) {
+		return DWT->CYCCNT;
+	}
+
+	//Returns the number of timestamp ticks per second (the CPU clock frequency in Hz)
+	static uint32_t getFrequency(void) {
+		return SystemCoreClock;
+	}
+
+	static uint32_t toMicros(uint32_t uTicks);
+
+};
+
+
+//Prevent Recursive Inclusion
+#endif /* __QAT_TIMESTAMP_HPP_ */
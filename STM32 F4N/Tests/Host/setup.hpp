@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tests                                                         */
+/*   Role: Host Setup Shim                                                 */
+/*   Filename: setup.hpp                                                   */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//Prevent Recursive Inclusion
+#ifndef __SETUP_HPP_
+#define __SETUP_HPP_
+
+//Includes
+#include <stdint.h>
+#include <stddef.h>
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//NOTE: This header replaces Core/setup.hpp when building tools on a host PC for testing. It provides the definitions from
+//setup.hpp that the tools rely on, along with plain C++ versions of the CMSIS SIMD intrinsics, implemented as described in the
+//Cortex-M4 instruction set. Tests/Host must be placed before the firmware include directories so this header is found first
+
+
+  //Result Enum
+  //Matches QA_Result in Core/setup.hpp
+enum QA_Result : uint8_t {
+	QA_OK = 0,                      //Function has succeeded
+	QA_Fail,                        //Function has failed, with a non-specific error
+	QA_Error_PeriphBusy,            //Function has not been able to initialize a particular peripheral as the peripheral is busy
+	QA_Error_PeriphNotSupported     //Function has not been able to initialize a particular peripheral as the peripheral doesn't support the required functionality
+};
+
+
+	//----------------------------------------
+	//----------------------------------------
+	//----------------------------------------
+
+	//----------------
+	//CMSIS Intrinsics
+
+//__SSAT
+//Saturates a signed value to the range of a uBits bit signed integer
+static inline int32_t __SSAT(int32_t iValue, uint32_t uBits) {
+	int32_t iMax = (int32_t)((1UL << (uBits - 1)) - 1);
+	int32_t iMin = -iMax - 1;
+	return (iValue > iMax) ? iMax : ((iValue < iMin) ? iMin : iValue);
+}
+
+//__PKHBT
+//Packs the bottom halfword of uLow with the top halfword of uHigh shifted left by uShift
+static inline uint32_t __PKHBT(uint32_t uLow, uint32_t uHigh, uint32_t uShift) {
+	return (uLow & 0x0000FFFFUL) | ((uHigh << uShift) & 0xFFFF0000UL);
+}
+
+//__SMUAD
+//Dual signed 16bit multiply, adding the two products
+static inline uint32_t __SMUAD(uint32_t uX, uint32_t uY) {
+	int32_t iLow  = (int32_t)(int16_t)uX * (int16_t)uY;
+	int32_t iHigh = (int32_t)(int16_t)(uX >> 16) * (int16_t)(uY >> 16);
+	return (uint32_t)iLow + (uint32_t)iHigh;
+}
+
+//__SMLAD
+//Dual signed 16bit multiply, adding the two products to a 32bit accumulator
+static inline uint32_t __SMLAD(uint32_t uX, uint32_t uY, uint32_t uAcc) {
+	return __SMUAD(uX, uY) + uAcc;
+}
+
+
+//Prevent Recursive Inclusion
+#endif /* __SETUP_HPP_ */
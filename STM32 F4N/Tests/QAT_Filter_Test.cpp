@@ -0,0 +1,578 @@
+/* ----------------------------------------------------------------------- */
+/*                                                                         */
+/*   Quartz Arc                                                            */
+/*                                                                         */
+/*   STM32 F411RE Nucleo 64                                                */
+/*                                                                         */
+/*   System: Tests                                                         */
+/*   Role: Fixed Point Digital Filters Golden Test                         */
+/*   Filename: QAT_Filter_Test.cpp                                         */
+/*   Date: 19th October 2026                                               */
+/*   Created By: Benjamin Rosser                                           */
+/*                                                                         */
+/*   This code is covered by Creative Commons CC-BY-NC-SA license          */
+/*   (C) Copyright 2026 Benjamin Rosser                                    */
+/*                                                                         */
+/* ----------------------------------------------------------------------- */
+
+//NOTE: This is a host PC test, and is not part of the firmware build. It runs each QAT_Filter class over a set of fixed input
+//vectors and checks the outputs in two ways:
+//  Golden - Bit-exact comparison against a plain fixed point reference model of each filter, written with 64bit integer arithmetic
+//           and without the packed SIMD forms used by the filters, so any change to the filters' arithmetic fails the test
+//  Design - Comparison against double precision implementations, to check the fixed point filters still implement the intended
+//           response. The tolerances allowed here are explained next to each comparison
+//Tests/Host/setup.hpp provides the setup.hpp definitions and CMSIS intrinsics used by the filters
+//
+//Build and run from the project directory with:
+//  g++ -std=gnu++17 -Wall -ITests/Host -IQA_Tools Tests/QAT_Filter_Test.cpp QA_Tools/QAT_Filter.cpp -o QAT_Filter_Test
+//  ./QAT_Filter_Test
+//
+//Returns 0 if all outputs match, or 1 if any mismatches were found
+
+//Includes
+#include "QAT_Filter.hpp"
+
+#include <stdio.h>
+#include <math.h>
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//Length of each input vector
+#define TEST_SAMPLES    512
+
+//Number of interleaved channels used when feeding filters. The filter under test reads channel TEST_CHANNEL
+#define TEST_STRIDE     3
+#define TEST_CHANNEL    1
+
+//Maximum number of mismatches printed for each filter and vector
+#define TEST_MAXREPORT  8
+
+//Maximum output samples per filter run
+#define TEST_MAXOUTPUT  TEST_SAMPLES
+
+
+//-----------
+//Test_Vector
+//
+//Named input vector of unsigned 12bit samples
+typedef struct {
+	const char* pName;
+	uint16_t    uData[TEST_SAMPLES];
+} Test_Vector;
+
+
+//---------------
+//Test_BiquadStage
+//
+//Double precision biquad stage coefficients, with a1 and a2 using the sign convention of QAT_Filter_BiquadQ15_Coeffs
+typedef struct {
+	double dB0;
+	double dB1;
+	double dB2;
+	double dA1;
+	double dA2;
+} Test_BiquadStage;
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+  //-----------------
+  //-----------------
+  //Vector Generation
+
+//Test_makeVectors
+//
+//Fills the set of input vectors
+//pVectors - Array of vectors to fill
+//Returns the number of vectors
+static uint8_t Test_makeVectors(Test_Vector* pVectors) {
+	uint8_t  uCount = 0;
+	uint32_t uSeed  = 0x12345678;
+
+	Test_Vector& sStep = pVectors[uCount++];
+	sStep.pName = "Step";
+	for (uint32_t i=0; i<TEST_SAMPLES; i++)
+		sStep.uData[i] = (i < 64) ? 0 : 4095;
+
+	Test_Vector& sImpulse = pVectors[uCount++];
+	sImpulse.pName = "Impulse";
+	for (uint32_t i=0; i<TEST_SAMPLES; i++)
+		sImpulse.uData[i] = (i == 10) ? 4095 : 0;
+
+	Test_Vector& sRamp = pVectors[uCount++];
+	sRamp.pName = "Ramp";
+	for (uint32_t i=0; i<TEST_SAMPLES; i++)
+		sRamp.uData[i] = (uint16_t)((i * 8) & 0x0FFF);
+
+	Test_Vector& sSine = pVectors[uCount++];
+	sSine.pName = "Sine";
+	for (uint32_t i=0; i<TEST_SAMPLES; i++)
+		sSine.uData[i] = (uint16_t)lround(2048.0 + (2000.0 * sin((2.0 * M_PI * i) / 37.0)));
+
+	Test_Vector& sSquare = pVectors[uCount++];
+	sSquare.pName = "Square";
+	for (uint32_t i=0; i<TEST_SAMPLES; i++)
+		sSquare.uData[i] = ((i >> 3) & 0x01) ? 4095 : 0;
+
+	Test_Vector& sNoise = pVectors[uCount++];
+	sNoise.pName = "Noise";
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		uSeed = (uSeed * 1664525) + 1013904223;
+		sNoise.uData[i] = (uint16_t)(uSeed >> 20);
+	}
+
+	return uCount;
+}
+
+
+  //------------------
+  //------------------
+  //Filter Under Test
+
+//Test_runFilter
+//
+//Runs a filter over a vector, interleaved with other channels and passed in chunks of varying size, so that strided input and
+//state kept between calls to process() are both covered
+//cFilter  - Filter to run
+//sVector  - Input vector
+//pOutput  - Output array
+//Returns the number of outputs produced
+static uint32_t Test_runFilter(QAT_Filter& cFilter, const Test_Vector& sVector, int16_t* pOutput) {
+	static uint16_t uInterleaved[TEST_SAMPLES * TEST_STRIDE];
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		for (uint8_t j=0; j<TEST_STRIDE; j++)
+			uInterleaved[(i * TEST_STRIDE) + j] = (j == TEST_CHANNEL) ? sVector.uData[i] : (uint16_t)(0x0FFF - (i & 0x0FFF));
+	}
+
+	cFilter.reset();
+	uint32_t uOutputs = 0;
+	uint32_t uIdx     = 0;
+	uint32_t uChunk   = 1;
+	while (uIdx < TEST_SAMPLES) {
+		uint32_t uLen = ((TEST_SAMPLES - uIdx) < uChunk) ? (TEST_SAMPLES - uIdx) : uChunk;
+		uOutputs += cFilter.process(&uInterleaved[(uIdx * TEST_STRIDE) + TEST_CHANNEL], uLen, TEST_STRIDE, &pOutput[uOutputs]);
+		uIdx     += uLen;
+		uChunk    = (uChunk % 37) + 1;
+	}
+	return uOutputs;
+}
+
+
+  //----------------------------
+  //----------------------------
+  //Fixed Point Reference Models
+
+//Test_saturate16
+//
+//Saturates a fixed point model value to a signed 16bit output
+static int32_t Test_saturate16(int64_t iValue) {
+	return (iValue > INT16_MAX) ? INT16_MAX : ((iValue < INT16_MIN) ? INT16_MIN : (int32_t)iValue);
+}
+
+
+//Test_fixBiquadQ15
+//
+//Direct Form I biquad cascade with Q15 inputs and coefficients. Each stage output is rounded to nearest by uShift bits and
+//saturated to 16bits, and that 16bit value is both the stage's feedback state and the next stage's input
+//pCoeffs - b0, b1, b2, a1, a2 of each stage, with a1 and a2 using the sign convention of QAT_Filter_BiquadQ15_Coeffs
+static uint32_t Test_fixBiquadQ15(const int16_t (*pCoeffs)[5], uint8_t uStages, uint8_t uShift, const Test_Vector& sVector,
+		                              int32_t* pOutput) {
+	int64_t iX1[QAT_FILTER_MAXSTAGES] = {0};
+	int64_t iX2[QAT_FILTER_MAXSTAGES] = {0};
+	int64_t iY1[QAT_FILTER_MAXSTAGES] = {0};
+	int64_t iY2[QAT_FILTER_MAXSTAGES] = {0};
+
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		int64_t iSample = sVector.uData[i];
+		for (uint8_t j=0; j<uStages; j++) {
+			const int16_t* pStage = pCoeffs[j];
+			int64_t iAcc = (pStage[0] * iSample) + (pStage[1] * iX1[j]) + (pStage[2] * iX2[j]) - (pStage[3] * iY1[j]) - (pStage[4] * iY2[j]);
+			int64_t iOut = Test_saturate16((iAcc + (1LL << (uShift - 1))) >> uShift);
+			iX2[j]  = iX1[j];
+			iX1[j]  = iSample;
+			iY2[j]  = iY1[j];
+			iY1[j]  = iOut;
+			iSample = iOut;
+		}
+		pOutput[i] = (int32_t)iSample;
+	}
+	return TEST_SAMPLES;
+}
+
+
+//Test_fixBiquadQ31
+//
+//Direct Form I biquad cascade with Q31 state and coefficients. Inputs are scaled by 2^16, each stage output is rounded to nearest
+//by uShift bits and saturated to 32bits, and the final output is rounded to nearest back to 16bits
+//pCoeffs - b0, b1, b2, a1, a2 of each stage, with a1 and a2 using the sign convention of QAT_Filter_BiquadQ31_Coeffs
+static uint32_t Test_fixBiquadQ31(const int32_t (*pCoeffs)[5], uint8_t uStages, uint8_t uShift, const Test_Vector& sVector,
+		                              int32_t* pOutput) {
+	int64_t iX1[QAT_FILTER_MAXSTAGES] = {0};
+	int64_t iX2[QAT_FILTER_MAXSTAGES] = {0};
+	int64_t iY1[QAT_FILTER_MAXSTAGES] = {0};
+	int64_t iY2[QAT_FILTER_MAXSTAGES] = {0};
+
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		int64_t iSample = (int64_t)sVector.uData[i] * 65536;
+		for (uint8_t j=0; j<uStages; j++) {
+			const int32_t* pStage = pCoeffs[j];
+			int64_t iAcc = (pStage[0] * iSample) + (pStage[1] * iX1[j]) + (pStage[2] * iX2[j]) - (pStage[3] * iY1[j]) - (pStage[4] * iY2[j]);
+			int64_t iOut = (iAcc + (1LL << (uShift - 1))) >> uShift;
+			iOut    = (iOut > INT32_MAX) ? INT32_MAX : ((iOut < INT32_MIN) ? INT32_MIN : iOut);
+			iX2[j]  = iX1[j];
+			iX1[j]  = iSample;
+			iY2[j]  = iY1[j];
+			iY1[j]  = iOut;
+			iSample = iOut;
+		}
+		pOutput[i] = Test_saturate16((iSample + 0x8000) >> 16);
+	}
+	return TEST_SAMPLES;
+}
+
+
+//Test_fixFIR
+//
+//Decimating FIR filter with Q15 coefficients, producing an output after every uDecimation samples. The sum of products is
+//rounded to nearest by 15 bits and saturated to 16bits
+static uint32_t Test_fixFIR(const int16_t* pCoeffs, uint8_t uTaps, uint8_t uDecimation, const Test_Vector& sVector, int32_t* pOutput) {
+	uint32_t uOutputs = 0;
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		if (((i + 1) % uDecimation) != 0)
+			continue;
+
+		int64_t iAcc = 0;
+		for (uint8_t j=0; (j < uTaps) && (j <= i); j++)
+			iAcc += (int64_t)pCoeffs[j] * sVector.uData[i - j];
+		pOutput[uOutputs++] = Test_saturate16((iAcc + 0x4000) >> 15);
+	}
+	return uOutputs;
+}
+
+
+//Test_fixEMA
+//
+//Exponential moving average with a Q15 alpha and a state of 16 integer and 16 fractional bits, initialized to the first sample.
+//Each update adds alpha times the difference between the sample and the state, truncated towards minus infinity, and each output
+//is the state rounded to nearest
+static uint32_t Test_fixEMA(int16_t iAlpha, const Test_Vector& sVector, int32_t* pOutput) {
+	int64_t iState = (int64_t)sVector.uData[0] * 65536;
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		int64_t iDiff = ((int64_t)sVector.uData[i] * 65536) - iState;
+		iState += (iDiff * iAlpha) >> 15;
+		pOutput[i] = Test_saturate16((iState + 0x8000) >> 16);
+	}
+	return TEST_SAMPLES;
+}
+
+
+  //----------------------------------
+  //----------------------------------
+  //Double Precision Reference Filters
+
+//Test_saturate
+//
+//Saturates a reference value to a signed 16bit output, rounding to nearest
+static int32_t Test_saturate(double dValue) {
+	double dRounded = floor(dValue + 0.5);
+	return (dRounded > 32767.0) ? 32767 : ((dRounded < -32768.0) ? -32768 : (int32_t)dRounded);
+}
+
+
+//Test_refBiquad
+//
+//Double precision Direct Form I biquad cascade
+//dLimit - Limit applied to each stage output, matching the range of the fixed point filter's state
+static uint32_t Test_refBiquad(const Test_BiquadStage* pStages, uint8_t uStages, double dLimit, const Test_Vector& sVector,
+		                           int32_t* pOutput) {
+	double dX1[QAT_FILTER_MAXSTAGES] = {0};
+	double dX2[QAT_FILTER_MAXSTAGES] = {0};
+	double dY1[QAT_FILTER_MAXSTAGES] = {0};
+	double dY2[QAT_FILTER_MAXSTAGES] = {0};
+
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		double dSample = sVector.uData[i];
+		for (uint8_t j=0; j<uStages; j++) {
+			const Test_BiquadStage& sStage = pStages[j];
+			double dOut = (sStage.dB0 * dSample) + (sStage.dB1 * dX1[j]) + (sStage.dB2 * dX2[j]) - (sStage.dA1 * dY1[j]) - (sStage.dA2 * dY2[j]);
+			dOut    = (dOut > dLimit) ? dLimit : ((dOut < -dLimit) ? -dLimit : dOut);
+			dX2[j]  = dX1[j];
+			dX1[j]  = dSample;
+			dY2[j]  = dY1[j];
+			dY1[j]  = dOut;
+			dSample = dOut;
+		}
+		pOutput[i] = Test_saturate(dSample);
+	}
+	return TEST_SAMPLES;
+}
+
+
+//Test_refFIR
+//
+//Double precision decimating FIR filter, producing an output after every uDecimation samples
+static uint32_t Test_refFIR(const int16_t* pCoeffs, uint8_t uTaps, uint8_t uDecimation, const Test_Vector& sVector, int32_t* pOutput) {
+	uint32_t uOutputs = 0;
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		if (((i + 1) % uDecimation) != 0)
+			continue;
+
+		double dAcc = 0.0;
+		for (uint8_t j=0; (j < uTaps) && (j <= i); j++)
+			dAcc += ((double)pCoeffs[j] / 32768.0) * sVector.uData[i - j];
+		pOutput[uOutputs++] = Test_saturate(dAcc);
+	}
+	return uOutputs;
+}
+
+
+//Test_refMedian
+//
+//Median of the most recent uSize samples, with samples before the start of the vector taken as the first sample
+static uint32_t Test_refMedian(uint8_t uSize, const Test_Vector& sVector, int32_t* pOutput) {
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		int32_t iWindow[QAT_FILTER_MAXMEDIAN];
+		for (uint8_t j=0; j<uSize; j++)
+			iWindow[j] = (j <= i) ? sVector.uData[i - j] : sVector.uData[0];
+
+		for (uint8_t j=1; j<uSize; j++) {
+			int32_t iValue = iWindow[j];
+			int8_t  k      = j - 1;
+			while ((k >= 0) && (iWindow[k] > iValue)) {
+				iWindow[k + 1] = iWindow[k];
+				k--;
+			}
+			iWindow[k + 1] = iValue;
+		}
+		pOutput[i] = iWindow[uSize >> 1];
+	}
+	return TEST_SAMPLES;
+}
+
+
+//Test_refEMA
+//
+//Double precision exponential moving average, initialized to the first sample
+static uint32_t Test_refEMA(int16_t iAlpha, const Test_Vector& sVector, int32_t* pOutput) {
+	double dAlpha = iAlpha / 32768.0;
+	double dState = sVector.uData[0];
+	for (uint32_t i=0; i<TEST_SAMPLES; i++) {
+		dState += dAlpha * (sVector.uData[i] - dState);
+		pOutput[i] = Test_saturate(dState);
+	}
+	return TEST_SAMPLES;
+}
+
+
+  //-----------------
+  //-----------------
+  //Filter Design
+
+//Test_lowpass
+//
+//Designs a second order low pass stage (RBJ cookbook), with dFreq as a fraction of the sample rate
+static Test_BiquadStage Test_lowpass(double dFreq, double dQ) {
+	double dW0    = 2.0 * M_PI * dFreq;
+	double dAlpha = sin(dW0) / (2.0 * dQ);
+	double dA0    = 1.0 + dAlpha;
+	Test_BiquadStage sStage;
+	sStage.dB0 = ((1.0 - cos(dW0)) / 2.0) / dA0;
+	sStage.dB1 = (1.0 - cos(dW0)) / dA0;
+	sStage.dB2 = sStage.dB0;
+	sStage.dA1 = (-2.0 * cos(dW0)) / dA0;
+	sStage.dA2 = (1.0 - dAlpha) / dA0;
+	return sStage;
+}
+
+
+//Test_highpass
+//
+//Designs a second order high pass stage (RBJ cookbook), with dFreq as a fraction of the sample rate
+static Test_BiquadStage Test_highpass(double dFreq, double dQ) {
+	double dW0    = 2.0 * M_PI * dFreq;
+	double dAlpha = sin(dW0) / (2.0 * dQ);
+	double dA0    = 1.0 + dAlpha;
+	Test_BiquadStage sStage;
+	sStage.dB0 = ((1.0 + cos(dW0)) / 2.0) / dA0;
+	sStage.dB1 = -(1.0 + cos(dW0)) / dA0;
+	sStage.dB2 = sStage.dB0;
+	sStage.dA1 = (-2.0 * cos(dW0)) / dA0;
+	sStage.dA2 = (1.0 - dAlpha) / dA0;
+	return sStage;
+}
+
+
+//Test_quantize
+//
+//Quantizes a coefficient to uBits fractional bits, returning the quantized value and replacing dValue with its exact value
+static int64_t Test_quantize(double& dValue, uint8_t uBits) {
+	int64_t iValue = llround(dValue * (double)(1LL << uBits));
+	dValue = (double)iValue / (double)(1LL << uBits);
+	return iValue;
+}
+
+
+  //-----------
+  //-----------
+  //Comparison
+
+//Test_compare
+//
+//Compares filter outputs against reference outputs, printing mismatches
+//Returns the number of mismatches
+static uint32_t Test_compare(const char* pFilter, const char* pVector, const int16_t* pOutput, uint32_t uOutputs,
+		                         const int32_t* pRef, uint32_t uRefs, int32_t iTolerance) {
+	if (uOutputs != uRefs) {
+		printf("FAIL %-12s %-8s output count %u, expected %u\n", pFilter, pVector, (unsigned)uOutputs, (unsigned)uRefs);
+		return 1;
+	}
+
+	uint32_t uMismatches = 0;
+	int32_t  iMaxError   = 0;
+	for (uint32_t i=0; i<uOutputs; i++) {
+		int32_t iError = pOutput[i] - pRef[i];
+		if (iError < 0)
+			iError = -iError;
+		if (iError > iMaxError)
+			iMaxError = iError;
+
+		if (iError > iTolerance) {
+			if (uMismatches < TEST_MAXREPORT)
+				printf("FAIL %-12s %-8s [%u] output %d, expected %d\n", pFilter, pVector, (unsigned)i, pOutput[i], (int)pRef[i]);
+			uMismatches++;
+		}
+	}
+
+	printf("%s %-12s %-8s %u outputs, max error %d (tolerance %d)\n", (uMismatches) ? "FAIL" : "ok  ", pFilter, pVector,
+			   (unsigned)uOutputs, (int)iMaxError, (int)iTolerance);
+	return uMismatches;
+}
+
+
+	//------------------------------------------
+	//------------------------------------------
+	//------------------------------------------
+
+//main
+int main(void) {
+	static Test_Vector sVectors[8];
+	uint8_t  uVectors = Test_makeVectors(sVectors);
+	uint32_t uFails   = 0;
+
+	int16_t  iOutput[TEST_MAXOUTPUT];
+	int32_t  iRef[TEST_MAXOUTPUT];
+	uint32_t uOutputs;
+	uint32_t uRefs;
+
+	//Biquad Q15 - Two low pass stages, with coefficients having one integer bit
+	Test_BiquadStage sQ15Stages[2] = {Test_lowpass(0.1, 0.7071), Test_lowpass(0.15, 0.5412)};
+	int16_t iQ15Coeffs[2][5];
+	QAT_Filter_BiquadQ15 cBiquadQ15(1);
+	for (uint8_t i=0; i<2; i++) {
+		QAT_Filter_BiquadQ15_Coeffs sCoeffs;
+		sCoeffs.iB0 = iQ15Coeffs[i][0] = (int16_t)Test_quantize(sQ15Stages[i].dB0, 14);
+		sCoeffs.iB1 = iQ15Coeffs[i][1] = (int16_t)Test_quantize(sQ15Stages[i].dB1, 14);
+		sCoeffs.iB2 = iQ15Coeffs[i][2] = (int16_t)Test_quantize(sQ15Stages[i].dB2, 14);
+		sCoeffs.iA1 = iQ15Coeffs[i][3] = (int16_t)Test_quantize(sQ15Stages[i].dA1, 14);
+		sCoeffs.iA2 = iQ15Coeffs[i][4] = (int16_t)Test_quantize(sQ15Stages[i].dA2, 14);
+		cBiquadQ15.addStage(sCoeffs);
+	}
+
+	//Biquad Q31 - Low cutoff low pass stage followed by a high pass stage, with coefficients having one integer bit
+	Test_BiquadStage sQ31Stages[2] = {Test_lowpass(0.01, 0.7071), Test_highpass(0.002, 0.7071)};
+	int32_t iQ31Coeffs[2][5];
+	QAT_Filter_BiquadQ31 cBiquadQ31(1);
+	for (uint8_t i=0; i<2; i++) {
+		QAT_Filter_BiquadQ31_Coeffs sCoeffs;
+		sCoeffs.iB0 = iQ31Coeffs[i][0] = (int32_t)Test_quantize(sQ31Stages[i].dB0, 30);
+		sCoeffs.iB1 = iQ31Coeffs[i][1] = (int32_t)Test_quantize(sQ31Stages[i].dB1, 30);
+		sCoeffs.iB2 = iQ31Coeffs[i][2] = (int32_t)Test_quantize(sQ31Stages[i].dB2, 30);
+		sCoeffs.iA1 = iQ31Coeffs[i][3] = (int32_t)Test_quantize(sQ31Stages[i].dA1, 30);
+		sCoeffs.iA2 = iQ31Coeffs[i][4] = (int32_t)Test_quantize(sQ31Stages[i].dA2, 30);
+		cBiquadQ31.addStage(sCoeffs);
+	}
+
+	//FIR - Hamming windowed sinc low pass, with an odd number of taps so the padding tap is covered
+	const uint8_t uFIRTaps = 15;
+	int16_t iFIRCoeffs[uFIRTaps];
+	double  dFIRSum = 0.0;
+	double  dFIR[uFIRTaps];
+	for (uint8_t i=0; i<uFIRTaps; i++) {
+		double dN = i - ((uFIRTaps - 1) / 2.0);
+		dFIR[i]   = ((dN == 0.0) ? 0.2 : (sin(0.2 * M_PI * dN) / (M_PI * dN))) * (0.54 - (0.46 * cos((2.0 * M_PI * i) / (uFIRTaps - 1))));
+		dFIRSum  += dFIR[i];
+	}
+	for (uint8_t i=0; i<uFIRTaps; i++)
+		iFIRCoeffs[i] = (int16_t)lround((dFIR[i] / dFIRSum) * 32767.0);
+
+	QAT_Filter_FIR cFIR(1);
+	cFIR.setCoefficients(iFIRCoeffs, uFIRTaps);
+	QAT_Filter_FIR cFIRDecimate(4);
+	cFIRDecimate.setCoefficients(iFIRCoeffs, uFIRTaps);
+
+	//Median and EMA
+	QAT_Filter_Median cMedian(7);
+	QAT_Filter_EMA    cEMA(1000);
+
+	for (uint8_t i=0; i<uVectors; i++) {
+		const Test_Vector& sVector = sVectors[i];
+
+		//Biquad Q15
+		//Golden - Bit-exact against the fixed point model, with a stage shift of 14 for coefficients with one integer bit
+		//Design - Each stage output is rounded to 16bits and that rounding error is fed back through the poles and into the next
+		//         stage, so errors add up across samples and stages rather than being limited to one final rounding. These vectors
+		//         reach 2 LSBs of error, and 3 is allowed to leave margin for a change of coefficients
+		uOutputs = Test_runFilter(cBiquadQ15, sVector, iOutput);
+		uRefs    = Test_fixBiquadQ15(iQ15Coeffs, 2, 14, sVector, iRef);
+		uFails  += Test_compare("BiquadQ15", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+		uRefs    = Test_refBiquad(sQ15Stages, 2, 32767.0, sVector, iRef);
+		uFails  += Test_compare("BiquadQ15 ~", sVector.pName, iOutput, uOutputs, iRef, uRefs, 3);
+
+		//Biquad Q31
+		//Golden - Bit-exact against the fixed point model, with a stage shift of 30 for coefficients with one integer bit
+		//Design - The 32bit state leaves only the rounding of the final output to 16bits, which can fall either side of the
+		//         double precision value's rounding point, so 1 LSB of error is expected
+		uOutputs = Test_runFilter(cBiquadQ31, sVector, iOutput);
+		uRefs    = Test_fixBiquadQ31(iQ31Coeffs, 2, 30, sVector, iRef);
+		uFails  += Test_compare("BiquadQ31", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+		uRefs    = Test_refBiquad(sQ31Stages, 2, 32768.0, sVector, iRef);
+		uFails  += Test_compare("BiquadQ31 ~", sVector.pName, iOutput, uOutputs, iRef, uRefs, 1);
+
+		//FIR - The accumulator holds the sum of products exactly, so both the fixed point model and the double precision
+		//implementation must match exactly
+		uOutputs = Test_runFilter(cFIR, sVector, iOutput);
+		uRefs    = Test_fixFIR(iFIRCoeffs, uFIRTaps, 1, sVector, iRef);
+		uFails  += Test_compare("FIR", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+		uRefs    = Test_refFIR(iFIRCoeffs, uFIRTaps, 1, sVector, iRef);
+		uFails  += Test_compare("FIR ~", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+
+		uOutputs = Test_runFilter(cFIRDecimate, sVector, iOutput);
+		uRefs    = Test_fixFIR(iFIRCoeffs, uFIRTaps, 4, sVector, iRef);
+		uFails  += Test_compare("FIR/4", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+		uRefs    = Test_refFIR(iFIRCoeffs, uFIRTaps, 4, sVector, iRef);
+		uFails  += Test_compare("FIR/4 ~", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+
+		//Median - Integer only, so the reference is exact
+		uOutputs = Test_runFilter(cMedian, sVector, iOutput);
+		uRefs    = Test_refMedian(7, sVector, iRef);
+		uFails  += Test_compare("Median", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+
+		//EMA
+		//Golden - Bit-exact against the fixed point model
+		//Design - Each update truncates to 16 fractional bits, which biases the state slightly low. The bias is a small fraction
+		//         of an LSB but can move the output across a rounding point, so 1 LSB of error is expected
+		uOutputs = Test_runFilter(cEMA, sVector, iOutput);
+		uRefs    = Test_fixEMA(1000, sVector, iRef);
+		uFails  += Test_compare("EMA", sVector.pName, iOutput, uOutputs, iRef, uRefs, 0);
+		uRefs    = Test_refEMA(1000, sVector, iRef);
+		uFails  += Test_compare("EMA ~", sVector.pName, iOutput, uOutputs, iRef, uRefs, 1);
+	}
+
+	printf("%s: %u mismatches\n", (uFails) ? "FAILED" : "PASSED", (unsigned)uFails);
+	return (uFails) ? 1 : 0;
+}